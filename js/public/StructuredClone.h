@@ -208,13 +208,15 @@ enum TransferableOwnership {
 class CloneDataPolicy {
   bool allowIntraClusterClonableSharedObjects_;
   bool allowSharedMemoryObjects_;
+  bool allowSharedStringBuffers_;
 
  public:
   // The default is to deny all policy-controlled aspects.
 
   CloneDataPolicy()
       : allowIntraClusterClonableSharedObjects_(false),
-        allowSharedMemoryObjects_(false) {}
+        allowSharedMemoryObjects_(false),
+        allowSharedStringBuffers_(false) {}
 
   // SharedArrayBuffers and WASM modules can only be cloned intra-process
   // because the shared memory areas are allocated in process-private memory or
@@ -235,6 +237,18 @@ class CloneDataPolicy {
   bool areSharedMemoryObjectsAllowed() const {
     return allowSharedMemoryObjects_;
   }
+
+  // Large two-byte strings written to a SameProcess clone can be stored in
+  // refcounted immutable buffers that the clone data refers to, instead of
+  // being copied into the clone data. Reading the clone creates external
+  // strings that use the buffers' characters without copying them, and
+  // writing those strings to another clone shares the same buffers again.
+
+  void allowSharedStringBuffers() { allowSharedStringBuffers_ = true; }
+
+  bool areSharedStringBuffersAllowed() const {
+    return allowSharedStringBuffers_;
+  }
 };
 
 } /* namespace JS */
@@ -399,6 +413,24 @@ class SharedArrayRawBufferRefs {
   js::Vector<js::SharedArrayRawBuffer*, 0, js::SystemAllocPolicy> refs_;
 };
 
+class SharedStringBuffer;
+
+class SharedStringBufferRefs {
+ public:
+  SharedStringBufferRefs() = default;
+  SharedStringBufferRefs(SharedStringBufferRefs&& other) = default;
+  SharedStringBufferRefs& operator=(SharedStringBufferRefs&& other);
+  ~SharedStringBufferRefs();
+
+  [[nodiscard]] bool acquire(JSContext* cx, SharedStringBuffer* buffer);
+  [[nodiscard]] bool acquireAll(const SharedStringBufferRefs& that);
+  void takeOwnership(SharedStringBufferRefs&&);
+  void releaseAll();
+
+ private:
+  js::Vector<js::SharedStringBuffer*, 0, js::SystemAllocPolicy> refs_;
+};
+
 template <typename T, typename AllocPolicy>
 struct BufferIterator;
 }  // namespace js
@@ -428,6 +460,7 @@ class MOZ_NON_MEMMOVABLE JS_PUBLIC_API JSStructuredCloneData {
   OwnTransferablePolicy ownTransferables_ =
       OwnTransferablePolicy::NoTransferables;
   js::SharedArrayRawBufferRefs refsHeld_;
+  js::SharedStringBufferRefs stringBuffersHeld_;
 
   friend struct JSStructuredCloneWriter;
   friend class JS_PUBLIC_API JSAutoStructuredCloneBuffer;
@@ -563,9 +596,13 @@ class MOZ_NON_MEMMOVABLE JS_PUBLIC_API JSStructuredCloneData {
     return true;
   }
 
-  // Append the entire contents of other's bufList_ to our own.
+  // Append the entire contents of other's bufList_ to our own. The appended
+  // data may refer to SharedStringBuffers, so take our own references to them.
   [[nodiscard]] bool Append(const JSStructuredCloneData& other) {
     MOZ_ASSERT(scope() == other.scope());
+    if (!stringBuffersHeld_.acquireAll(other.stringBuffersHeld_)) {
+      return false;
+    }
     return other.ForEachDataChunk(
         [&](const char* data, size_t size) { return AppendBytes(data, size); });
   }
@@ -66,6 +66,7 @@ enum ThreadType {
   THREAD_TYPE_ION_FREE,              // 9
   THREAD_TYPE_WASM_GENERATOR_TIER2,  // 10
   THREAD_TYPE_WORKER,                // 11
+  THREAD_TYPE_REGEXP_COMPILE,        // 12
   THREAD_TYPE_MAX                    // Used to check shell function arguments
 };
 
@@ -83,9 +84,10 @@ namespace oom {
 #  if defined(DEBUG) || defined(JS_OOM_BREAKPOINT)
 
 // Define the range of threads tested by simulated OOM testing and the
-// like. Testing worker threads is not supported.
+// like. Testing worker threads is not supported, so THREAD_TYPE_WORKER is
+// skipped within this range.
 const ThreadType FirstThreadTypeToTest = THREAD_TYPE_MAIN;
-const ThreadType LastThreadTypeToTest = THREAD_TYPE_WASM_GENERATOR_TIER2;
+const ThreadType LastThreadTypeToTest = THREAD_TYPE_REGEXP_COMPILE;
 
 extern bool InitThreadType(void);
 extern void SetThreadType(ThreadType);
@@ -0,0 +1,44 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef js_experimental_JitBailouts_h
+#define js_experimental_JitBailouts_h
+
+#include <stddef.h>  // size_t
+
+#include "jstypes.h"     // JS_PUBLIC_API
+#include "js/Utility.h"  // JS::UniqueChars
+
+struct JS_PUBLIC_API JSContext;
+
+namespace js {
+
+/**
+ * Describe the bailouts from optimized JIT code in the context's runtime as
+ * JSON, and return it in a newly allocated buffer. The length of the content
+ * is stored in the length out-param.
+ *
+ * The result is an object with a "sites" list and a "droppedBailouts" count.
+ * Each site is a bytecode op where bailouts of one kind happened, and has
+ * "filename", "line", "column", "pcOffset", "op", "kind", "bailouts",
+ * "invalidations" and "transpilerDisabled" properties. The "ic" property
+ * describes the Baseline IC at the op, or is null if the op has no IC. Debug
+ * builds also name the MIR instruction that bailed out in "mir".
+ *
+ * In case of out-of-memory, this function returns nullptr. The length
+ * out-param is undefined on failure.
+ */
+extern JS_PUBLIC_API JS::UniqueChars GetJitBailoutRecords(JSContext* cx,
+                                                          size_t* length);
+
+/**
+ * Discard the bailout records for the context's runtime.
+ */
+extern JS_PUBLIC_API void ClearJitBailoutRecords(JSContext* cx);
+
+}  // namespace js
+
+#endif  // js_experimental_JitBailouts_h
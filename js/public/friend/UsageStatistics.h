@@ -59,7 +59,8 @@ class JS_PUBLIC_API JSObject;
   _(JS_TELEMETRY_DESERIALIZE_BYTES)         \
   _(JS_TELEMETRY_DESERIALIZE_ITEMS)         \
   _(JS_TELEMETRY_DESERIALIZE_US)            \
-  _(JS_TELEMETRY_GC_EFFECTIVENESS)
+  _(JS_TELEMETRY_GC_EFFECTIVENESS)          \
+  _(JS_TELEMETRY_BASELINE_RARELY_RUN)
 
 // clang-format off
 #define ENUM_DEF(NAME) NAME ,
@@ -1762,47 +1762,38 @@ struct NumericElement {
   size_t elementIndex;
 };
 
-static bool ComparatorNumericLeftMinusRight(const NumericElement& a,
-                                            const NumericElement& b,
-                                            bool* lessOrEqualp) {
-  *lessOrEqualp = (a.dv <= b.dv);
-  return true;
-}
-
-static bool ComparatorNumericRightMinusLeft(const NumericElement& a,
-                                            const NumericElement& b,
-                                            bool* lessOrEqualp) {
-  *lessOrEqualp = (b.dv <= a.dv);
-  return true;
-}
-
-using ComparatorNumeric = bool (*)(const NumericElement&, const NumericElement&,
-                                   bool*);
-
-static const ComparatorNumeric SortComparatorNumerics[] = {
-    nullptr, nullptr, ComparatorNumericLeftMinusRight,
-    ComparatorNumericRightMinusLeft};
-
-static bool ComparatorInt32LeftMinusRight(const Value& a, const Value& b,
-                                          bool* lessOrEqualp) {
-  *lessOrEqualp = (a.toInt32() <= b.toInt32());
-  return true;
-}
+// The numeric comparators are function objects rather than plain functions,
+// so that each MergeSort instantiation can inline its comparison.
+struct SortComparatorNumericLeftMinusRight {
+  bool operator()(const NumericElement& a, const NumericElement& b,
+                  bool* lessOrEqualp) {
+    *lessOrEqualp = (a.dv <= b.dv);
+    return true;
+  }
+};
 
-static bool ComparatorInt32RightMinusLeft(const Value& a, const Value& b,
-                                          bool* lessOrEqualp) {
-  *lessOrEqualp = (b.toInt32() <= a.toInt32());
-  return true;
-}
+struct SortComparatorNumericRightMinusLeft {
+  bool operator()(const NumericElement& a, const NumericElement& b,
+                  bool* lessOrEqualp) {
+    *lessOrEqualp = (b.dv <= a.dv);
+    return true;
+  }
+};
 
-using ComparatorInt32 = bool (*)(const Value&, const Value&, bool*);
+struct SortComparatorInt32LeftMinusRight {
+  bool operator()(const Value& a, const Value& b, bool* lessOrEqualp) {
+    *lessOrEqualp = (a.toInt32() <= b.toInt32());
+    return true;
+  }
+};
 
-static const ComparatorInt32 SortComparatorInt32s[] = {
-    nullptr, nullptr, ComparatorInt32LeftMinusRight,
-    ComparatorInt32RightMinusLeft};
+struct SortComparatorInt32RightMinusLeft {
+  bool operator()(const Value& a, const Value& b, bool* lessOrEqualp) {
+    *lessOrEqualp = (b.toInt32() <= a.toInt32());
+    return true;
+  }
+};
 
-// Note: Values for this enum must match up with SortComparatorNumerics
-// and SortComparatorInt32s.
 enum ComparatorMatchResult {
   Match_Failure = 0,
   Match_None,
@@ -1984,8 +1975,15 @@ static bool SortNumerically(JSContext* cx, MutableHandle<GCVector<Value>> vec,
   }
 
   /* Sort Values in vec numerically. */
-  return MergeSortByKey(numElements.begin(), len, numElements.begin() + len,
-                        SortComparatorNumerics[comp], vec);
+  NumericElement* keys = numElements.begin();
+  NumericElement* scratch = numElements.begin() + len;
+  if (comp == Match_LeftMinusRight) {
+    return MergeSortByKey(keys, len, scratch,
+                          SortComparatorNumericLeftMinusRight(), vec);
+  }
+  MOZ_ASSERT(comp == Match_RightMinusLeft);
+  return MergeSortByKey(keys, len, scratch,
+                        SortComparatorNumericRightMinusLeft(), vec);
 }
 
 static bool FillWithUndefined(JSContext* cx, HandleObject obj, uint32_t start,
@@ -2193,8 +2191,16 @@ bool js::intrinsic_ArrayNativeSort(JSContext* cx, unsigned argc, Value* vp) {
     } else {
       if (allInts) {
         MOZ_ALWAYS_TRUE(vec.resize(n * 2));
-        if (!MergeSort(vec.begin(), n, vec.begin() + n,
-                       SortComparatorInt32s[comp])) {
+        bool ok;
+        if (comp == Match_LeftMinusRight) {
+          ok = MergeSort(vec.begin(), n, vec.begin() + n,
+                         SortComparatorInt32LeftMinusRight());
+        } else {
+          MOZ_ASSERT(comp == Match_RightMinusLeft);
+          ok = MergeSort(vec.begin(), n, vec.begin() + n,
+                         SortComparatorInt32RightMinusLeft());
+        }
+        if (!ok) {
           return false;
         }
       } else {
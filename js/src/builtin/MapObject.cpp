@@ -8,6 +8,7 @@
 
 #include "ds/OrderedHashTable.h"
 #include "gc/FreeOp.h"
+#include "jit/InlinableNatives.h"
 #include "js/PropertySpec.h"
 #include "js/Utility.h"
 #include "vm/BigIntType.h"
@@ -409,10 +410,10 @@ const JSPropertySpec MapObject::properties[] = {
 
 // clang-format off
 const JSFunctionSpec MapObject::methods[] = {
-    JS_FN("get", get, 1, 0),
-    JS_FN("has", has, 1, 0),
-    JS_FN("set", set, 2, 0),
-    JS_FN("delete", delete_, 1, 0),
+    JS_INLINABLE_FN("get", get, 1, 0, MapGet),
+    JS_INLINABLE_FN("has", has, 1, 0, MapHas),
+    JS_INLINABLE_FN("set", set, 2, 0, MapSet),
+    JS_INLINABLE_FN("delete", delete_, 1, 0, MapDelete),
     JS_FN("keys", keys, 0, 0),
     JS_FN("values", values, 0, 0),
     JS_FN("clear", clear, 0, 0),
@@ -639,6 +640,7 @@ MapObject* MapObject::create(JSContext* cx,
     return nullptr;
   }
 
+  MOZ_ASSERT(mapObj->numFixedSlots() == MapObject::NUM_FIXED_SLOTS);
   InitObjectPrivate(mapObj, map.release(), MemoryUse::MapObjectTable);
   mapObj->initReservedSlot(NurseryKeysSlot, PrivateValue(nullptr));
   mapObj->initReservedSlot(HasNurseryMemorySlot,
@@ -1197,9 +1199,9 @@ const JSPropertySpec SetObject::properties[] = {
 
 // clang-format off
 const JSFunctionSpec SetObject::methods[] = {
-    JS_FN("has", has, 1, 0),
-    JS_FN("add", add, 1, 0),
-    JS_FN("delete", delete_, 1, 0),
+    JS_INLINABLE_FN("has", has, 1, 0, SetHas),
+    JS_INLINABLE_FN("add", add, 1, 0, SetAdd),
+    JS_INLINABLE_FN("delete", delete_, 1, 0, SetDelete),
     JS_FN("entries", entries, 0, 0),
     JS_FN("clear", clear, 0, 0),
     JS_SELF_HOSTED_FN("forEach", "SetForEach", 2, 0),
@@ -1299,6 +1301,7 @@ SetObject* SetObject::create(JSContext* cx,
     return nullptr;
   }
 
+  MOZ_ASSERT(obj->numFixedSlots() == SetObject::NUM_FIXED_SLOTS);
   InitObjectPrivate(obj, set.release(), MemoryUse::MapObjectTable);
   obj->initReservedSlot(NurseryKeysSlot, PrivateValue(nullptr));
   obj->initReservedSlot(HasNurseryMemorySlot, JS::BooleanValue(insideNursery));
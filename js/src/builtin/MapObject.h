@@ -115,6 +115,9 @@ class MapObject : public NativeObject {
 
   enum { NurseryKeysSlot, HasNurseryMemorySlot, SlotCount };
 
+  // The JITs use this constant to load the private value (the ValueMap*).
+  static const uint32_t NUM_FIXED_SLOTS = 3;
+
   [[nodiscard]] static bool getKeysAndValuesInterleaved(
       HandleObject obj, JS::MutableHandle<GCVector<JS::Value>> entries);
   [[nodiscard]] static bool entries(JSContext* cx, unsigned argc, Value* vp);
@@ -246,6 +249,9 @@ class SetObject : public NativeObject {
 
   enum { NurseryKeysSlot, HasNurseryMemorySlot, SlotCount };
 
+  // The JITs use this constant to load the private value (the ValueSet*).
+  static const uint32_t NUM_FIXED_SLOTS = 3;
+
   [[nodiscard]] static bool keys(JSContext* cx, HandleObject obj,
                                  JS::MutableHandle<GCVector<JS::Value>> keys);
   [[nodiscard]] static bool values(JSContext* cx, unsigned argc, Value* vp);
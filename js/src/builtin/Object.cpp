@@ -1410,6 +1410,135 @@ static bool HasEnumerableStringNonDataProperties(NativeObject* obj) {
   return false;
 }
 
+// The enumerable own properties of |nobj| are fully determined by its Shape if
+// it has no indexed properties and no hooks which can add properties. Objects
+// in dictionary mode are excluded, because they're rarely shared and change
+// their Shape whenever a property is added or removed.
+static bool CanUseEnumerablePropertiesCache(NativeObject* nobj) {
+  const JSClass* clasp = nobj->getClass();
+  return nobj->getDenseInitializedLength() == 0 && !nobj->isIndexed() &&
+         !nobj->inDictionaryMode() && !IsTypedArrayClass(clasp) &&
+         !clasp->getEnumerate() && !clasp->getNewEnumerate() &&
+         !nobj->is<StringObject>();
+}
+
+// Return the cached enumerable properties of |nobj|, adding a new cache entry
+// if necessary. Returns nullptr on OOM. This function can't GC.
+static const EnumerablePropertiesCache::Entry* LookupOrAddEnumerableProperties(
+    JSContext* cx, NativeObject* nobj) {
+  MOZ_ASSERT(CanUseEnumerablePropertiesCache(nobj));
+
+  EnumerablePropertiesCache& cache = cx->realm()->enumerablePropertiesCache;
+  Shape* shape = nobj->shape();
+  if (const EnumerablePropertiesCache::Entry* entry = cache.lookup(shape)) {
+    return entry;
+  }
+
+  EnumerablePropertiesCache::Entry& entry = cache.add(shape);
+  bool allDataProperties = true;
+  for (ShapePropertyIter<NoGC> iter(shape); !iter.done(); iter++) {
+    jsid id = iter->key();
+    if (!iter->enumerable() || id.isSymbol()) {
+      continue;
+    }
+    MOZ_ASSERT(!JSID_IS_INT(id), "Unexpected indexed property");
+
+    uint32_t slot = 0;
+    if (iter->isDataProperty()) {
+      slot = iter->slot();
+    } else {
+      allDataProperties = false;
+    }
+
+    if (!entry.properties.append(
+            EnumerablePropertiesCache::Property{id.toAtom(), slot})) {
+      cache.remove(entry);
+      ReportOutOfMemory(cx);
+      return nullptr;
+    }
+  }
+
+  // The properties were visited in reverse iteration order.
+  std::reverse(entry.properties.begin(), entry.properties.end());
+  entry.allDataProperties = allDataProperties;
+  return &entry;
+}
+
+template <EnumerableOwnPropertiesKind kind>
+static bool EnumerableOwnPropertiesFromCache(JSContext* cx,
+                                             HandleNativeObject nobj,
+                                             MutableHandleValue rval) {
+  MOZ_ASSERT(kind != EnumerableOwnPropertiesKind::Names,
+             "the cache only contains enumerable properties");
+
+  const EnumerablePropertiesCache::Entry* entry =
+      LookupOrAddEnumerableProperties(cx, nobj);
+  if (!entry) {
+    return false;
+  }
+  MOZ_ASSERT_IF(kind != EnumerableOwnPropertiesKind::Keys,
+                entry->allDataProperties);
+
+  uint32_t length = entry->properties.length();
+
+  if (kind == EnumerableOwnPropertiesKind::KeysAndValues) {
+    // Allocating the key-value pairs can GC, which purges the cache, so copy
+    // the keys and values into a rooted vector first.
+    RootedValueVector properties(cx);
+    if (!properties.resize(length)) {
+      return false;
+    }
+    RootedValueVector keys(cx);
+    if (!keys.resize(length)) {
+      return false;
+    }
+    for (uint32_t i = 0; i < length; i++) {
+      const EnumerablePropertiesCache::Property& prop = entry->properties[i];
+      keys[i].setString(prop.key);
+      properties[i].set(nobj->getSlot(prop.slot));
+    }
+
+    for (uint32_t i = 0; i < length; i++) {
+      if (!NewValuePair(cx, keys[i], properties[i], properties[i])) {
+        return false;
+      }
+    }
+
+    JSObject* array = NewDenseCopiedArray(cx, length, properties.begin());
+    if (!array) {
+      return false;
+    }
+
+    rval.setObject(*array);
+    return true;
+  }
+
+  ArrayObject* array = NewDenseFullyAllocatedArray(cx, length);
+  if (!array) {
+    return false;
+  }
+
+  // Allocating the array can GC, so look up the entry again.
+  entry = LookupOrAddEnumerableProperties(cx, nobj);
+  if (!entry) {
+    return false;
+  }
+  MOZ_ASSERT(entry->properties.length() == length);
+
+  array->setDenseInitializedLength(length);
+  for (uint32_t i = 0; i < length; i++) {
+    const EnumerablePropertiesCache::Property& prop = entry->properties[i];
+    if (kind == EnumerableOwnPropertiesKind::Keys) {
+      array->initDenseElement(i, StringValue(prop.key));
+    } else {
+      array->initDenseElement(i, nobj->getSlot(prop.slot));
+    }
+  }
+
+  rval.setObject(*array);
+  return true;
+}
+
 template <EnumerableOwnPropertiesKind kind>
 static bool TryEnumerableOwnPropertiesNative(JSContext* cx, HandleObject obj,
                                              MutableHandleValue rval,
@@ -1428,6 +1557,22 @@ static bool TryEnumerableOwnPropertiesNative(JSContext* cx, HandleObject obj,
 
   HandleNativeObject nobj = obj.as<NativeObject>();
 
+  // Try the per-Shape cache first. Values can only be read from the cached
+  // slots if there are no enumerable accessor properties.
+  if (kind != EnumerableOwnPropertiesKind::Names &&
+      CanUseEnumerablePropertiesCache(nobj)) {
+    const EnumerablePropertiesCache::Entry* entry =
+        LookupOrAddEnumerableProperties(cx, nobj);
+    if (!entry) {
+      return false;
+    }
+    if (kind == EnumerableOwnPropertiesKind::Keys ||
+        entry->allDataProperties) {
+      *optimized = true;
+      return EnumerableOwnPropertiesFromCache<kind>(cx, nobj, rval);
+    }
+  }
+
   // Resolve lazy properties on |nobj|.
   if (JSEnumerateOp enumerate = nobj->getClass()->getEnumerate()) {
     if (!enumerate(cx, nobj)) {
@@ -1800,6 +1945,43 @@ static bool obj_keys(JSContext* cx, unsigned argc, Value* vp) {
   return GetOwnPropertyKeys(cx, obj, JSITER_OWNONLY, args.rval());
 }
 
+JSObject* js::ObjectKeys(JSContext* cx, HandleObject obj) {
+  RootedValue rval(cx);
+  bool optimized;
+  static constexpr EnumerableOwnPropertiesKind kind =
+      EnumerableOwnPropertiesKind::Keys;
+  if (!TryEnumerableOwnPropertiesNative<kind>(cx, obj, &rval, &optimized)) {
+    return nullptr;
+  }
+  if (!optimized) {
+    if (!GetOwnPropertyKeys(cx, obj, JSITER_OWNONLY, &rval)) {
+      return nullptr;
+    }
+  }
+  return &rval.toObject();
+}
+
+bool js::ObjectKeysLength(JSContext* cx, HandleObject obj, int32_t* length) {
+  // Avoid allocating the keys array when the cache can answer directly.
+  if (obj->is<NativeObject>() &&
+      CanUseEnumerablePropertiesCache(&obj->as<NativeObject>())) {
+    const EnumerablePropertiesCache::Entry* entry =
+        LookupOrAddEnumerableProperties(cx, &obj->as<NativeObject>());
+    if (!entry) {
+      return false;
+    }
+    *length = int32_t(entry->properties.length());
+    return true;
+  }
+
+  JSObject* keys = ObjectKeys(cx, obj);
+  if (!keys) {
+    return false;
+  }
+  *length = int32_t(keys->as<ArrayObject>().length());
+  return true;
+}
+
 // ES2018 draft rev c164be80f7ea91de5526b33d54e5c9321ed03d3f
 // 19.1.2.21 Object.values ( O )
 static bool obj_values(JSContext* cx, unsigned argc, Value* vp) {
@@ -2093,7 +2275,7 @@ static const JSFunctionSpec object_static_methods[] = {
                       "ObjectGetOwnPropertyDescriptor", 2, 0),
     JS_SELF_HOSTED_FN("getOwnPropertyDescriptors",
                       "ObjectGetOwnPropertyDescriptors", 1, 0),
-    JS_FN("keys", obj_keys, 1, 0),
+    JS_INLINABLE_FN("keys", obj_keys, 1, 0, ObjectKeys),
     JS_FN("values", obj_values, 1, 0),
     JS_FN("entries", obj_entries, 1, 0),
     JS_INLINABLE_FN("is", obj_is, 2, 0, ObjectIs),
@@ -25,6 +25,14 @@ PlainObject* ObjectCreateImpl(JSContext* cx, HandleObject proto,
 PlainObject* ObjectCreateWithTemplate(JSContext* cx,
                                       Handle<PlainObject*> templateObj);
 
+// Object.keys, called from JIT code with an already-converted object.
+JSObject* ObjectKeys(JSContext* cx, HandleObject obj);
+
+// Equivalent to |Object.keys(obj).length|, but doesn't allocate the keys
+// array when the enumerable properties of |obj| are cached.
+[[nodiscard]] bool ObjectKeysLength(JSContext* cx, HandleObject obj,
+                                    int32_t* length);
+
 // Object methods exposed so they can be installed in the self-hosting global.
 [[nodiscard]] bool obj_propertyIsEnumerable(JSContext* cx, unsigned argc,
                                             Value* vp);
@@ -800,6 +800,21 @@ class PromiseReactionRecord : public NativeObject {
     int32_t flags = this->flags();
     return flags & REACTION_FLAG_ASYNC_FUNCTION;
   }
+  // Prepare an async function's reaction record, whose job has already run,
+  // for the next await in the same async function.
+  void resetForAsyncFunctionAwait(JSObject* incumbentGlobalObject) {
+    MOZ_ASSERT(isAsyncFunction());
+    MOZ_ASSERT(targetState() != JS::PromiseState::Pending);
+    MOZ_ASSERT(!promise());
+    setFixedSlot(ReactionRecordSlot_Flags,
+                 Int32Value(REACTION_FLAG_ASYNC_FUNCTION));
+    setFixedSlot(ReactionRecordSlot_OnFulfilled,
+                 Int32Value(PromiseHandlerAsyncFunctionAwaitedFulfilled));
+    setFixedSlot(ReactionRecordSlot_OnRejected,
+                 Int32Value(PromiseHandlerAsyncFunctionAwaitedRejected));
+    setFixedSlot(ReactionRecordSlot_IncumbentGlobalObject,
+                 ObjectOrNullValue(incumbentGlobalObject));
+  }
   AsyncFunctionGeneratorObject* asyncFunctionGenerator() {
     MOZ_ASSERT(isAsyncFunction());
     const Value& generator =
@@ -4509,14 +4524,11 @@ bool js::IsPromiseForAsyncFunctionOrGenerator(JSObject* promise) {
 
 // https://tc39.github.io/ecma262/#await
 //
-// Helper function that performs 6.2.3.1 Await(promise) steps 2 and 9.
-// The same steps are also used in a few other places in the spec.
+// Helper function that performs 6.2.3.1 Await(promise) steps 2 and 9, using
+// the reaction record returned by |getReaction|.
 template <typename T>
-[[nodiscard]] static bool InternalAwait(JSContext* cx, HandleValue value,
-                                        HandleObject resultPromise,
-                                        PromiseHandler onFulfilled,
-                                        PromiseHandler onRejected,
-                                        T extraStep) {
+[[nodiscard]] static bool AwaitWithReaction(JSContext* cx, HandleValue value,
+                                            T getReaction) {
   // Step 2: Let promise be ? PromiseResolve(%Promise%, « value »).
   RootedObject promise(cx, PromiseObject::unforgeableResolve(cx, value));
   if (!promise) {
@@ -4535,20 +4547,76 @@ template <typename T>
   // Steps 3-8 of the spec create onFulfilled and onRejected functions.
 
   // Step 9: Perform ! PerformPromiseThen(promise, onFulfilled, onRejected).
-  RootedValue onFulfilledValue(cx, Int32Value(onFulfilled));
-  RootedValue onRejectedValue(cx, Int32Value(onRejected));
-  Rooted<PromiseCapability> resultCapability(cx);
-  resultCapability.promise().set(resultPromise);
-  Rooted<PromiseReactionRecord*> reaction(
-      cx, NewReactionRecord(cx, resultCapability, onFulfilledValue,
-                            onRejectedValue, IncumbentGlobalObject::Yes));
+  Rooted<PromiseReactionRecord*> reaction(cx, getReaction());
   if (!reaction) {
     return false;
   }
-  extraStep(reaction);
   return PerformPromiseThenWithReaction(cx, unwrappedPromise, reaction);
 }
 
+// https://tc39.github.io/ecma262/#await
+//
+// Helper function that performs 6.2.3.1 Await(promise) steps 2 and 9.
+// The same steps are also used in a few other places in the spec.
+template <typename T>
+[[nodiscard]] static bool InternalAwait(JSContext* cx, HandleValue value,
+                                        HandleObject resultPromise,
+                                        PromiseHandler onFulfilled,
+                                        PromiseHandler onRejected,
+                                        T extraStep) {
+  auto getReaction = [&]() -> PromiseReactionRecord* {
+    RootedValue onFulfilledValue(cx, Int32Value(onFulfilled));
+    RootedValue onRejectedValue(cx, Int32Value(onRejected));
+    Rooted<PromiseCapability> resultCapability(cx);
+    resultCapability.promise().set(resultPromise);
+    Rooted<PromiseReactionRecord*> reaction(
+        cx, NewReactionRecord(cx, resultCapability, onFulfilledValue,
+                              onRejectedValue, IncumbentGlobalObject::Yes));
+    if (!reaction) {
+      return nullptr;
+    }
+    extraStep(reaction);
+    return reaction;
+  };
+  return AwaitWithReaction(cx, value, getReaction);
+}
+
+// Return the reaction record for an await in an async function. The record
+// from the generator's previous await is reused when its job has already run,
+// which is always the case once the generator has been resumed from it.
+static PromiseReactionRecord* GetAsyncFunctionAwaitReaction(
+    JSContext* cx, Handle<AsyncFunctionGeneratorObject*> genObj) {
+  if (JSObject* cached = genObj->awaitReaction()) {
+    auto* reaction = &cached->as<PromiseReactionRecord>();
+    if (reaction->targetState() != JS::PromiseState::Pending) {
+      RootedObject incumbentGlobalObject(cx);
+      if (!GetObjectFromIncumbentGlobal(cx, &incumbentGlobalObject)) {
+        return nullptr;
+      }
+      cx->check(incumbentGlobalObject);
+
+      reaction = &genObj->awaitReaction()->as<PromiseReactionRecord>();
+      reaction->resetForAsyncFunctionAwait(incumbentGlobalObject);
+      return reaction;
+    }
+  }
+
+  RootedValue onFulfilled(
+      cx, Int32Value(PromiseHandlerAsyncFunctionAwaitedFulfilled));
+  RootedValue onRejected(cx,
+                         Int32Value(PromiseHandlerAsyncFunctionAwaitedRejected));
+  Rooted<PromiseCapability> resultCapability(cx);
+  PromiseReactionRecord* reaction =
+      NewReactionRecord(cx, resultCapability, onFulfilled, onRejected,
+                        IncumbentGlobalObject::Yes);
+  if (!reaction) {
+    return nullptr;
+  }
+  reaction->setIsAsyncFunction(genObj);
+  genObj->setAwaitReaction(reaction);
+  return reaction;
+}
+
 // https://tc39.github.io/ecma262/#await
 //
 // 6.2.3.1 Await(promise) steps 2-10 when the running execution context is
@@ -4556,12 +4624,32 @@ template <typename T>
 [[nodiscard]] JSObject* js::AsyncFunctionAwait(
     JSContext* cx, Handle<AsyncFunctionGeneratorObject*> genObj,
     HandleValue value) {
-  auto extra = [&](Handle<PromiseReactionRecord*> reaction) {
-    reaction->setIsAsyncFunction(genObj);
+  // Step 2: Let promise be ? PromiseResolve(%Promise%, « value »).
+  //
+  // For a primitive value this creates an already fulfilled promise, which is
+  // only used to enqueue the reaction job in step 9. Skip allocating it unless
+  // async stack capture is enabled, because then the promise is observable
+  // through devtools. Async generators and the other users of InternalAwait
+  // always create the promise.
+  if (!value.isObject() && !JS::IsAsyncStackCaptureEnabledForRealm(cx)) {
+    Rooted<PromiseReactionRecord*> reaction(
+        cx, GetAsyncFunctionAwaitReaction(cx, genObj));
+    if (!reaction) {
+      return nullptr;
+    }
+
+    // Step 9: Perform ! PerformPromiseThen(promise, onFulfilled, onRejected).
+    if (!EnqueuePromiseReactionJob(cx, reaction, value,
+                                   JS::PromiseState::Fulfilled)) {
+      return nullptr;
+    }
+    return genObj->promise();
+  }
+
+  auto getReaction = [&]() {
+    return GetAsyncFunctionAwaitReaction(cx, genObj);
   };
-  if (!InternalAwait(cx, value, nullptr,
-                     PromiseHandlerAsyncFunctionAwaitedFulfilled,
-                     PromiseHandlerAsyncFunctionAwaitedRejected, extra)) {
+  if (!AwaitWithReaction(cx, value, getReaction)) {
     return nullptr;
   }
   return genObj->promise();
@@ -113,6 +113,7 @@
 #include "vm/PlainObject.h"    // js::PlainObject
 #include "vm/PromiseObject.h"  // js::PromiseObject, js::PromiseSlot_*
 #include "vm/ProxyObject.h"
+#include "vm/RegExpShared.h"
 #include "vm/SavedStacks.h"
 #include "vm/ScopeKind.h"
 #include "vm/Stack.h"
@@ -2349,6 +2350,36 @@ static bool GCState(JSContext* cx, unsigned argc, Value* vp) {
   return ReturnStringCopy(cx, args, state);
 }
 
+static bool RegExpCodeStats(JSContext* cx, unsigned argc, Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+
+  if (args.length() != 0) {
+    RootedObject callee(cx, &args.callee());
+    ReportUsageErrorASCII(cx, callee, "Too many arguments");
+    return false;
+  }
+
+  RootedObject result(cx, JS_NewPlainObject(cx));
+  if (!result) {
+    return false;
+  }
+
+  RegExpZone& regExps = cx->zone()->regExps();
+
+  RootedValue val(cx, NumberValue(regExps.codeKeptCount()));
+  if (!JS_DefineProperty(cx, result, "kept", val, JSPROP_ENUMERATE)) {
+    return false;
+  }
+
+  val = NumberValue(regExps.codeDiscardedCount());
+  if (!JS_DefineProperty(cx, result, "discarded", val, JSPROP_ENUMERATE)) {
+    return false;
+  }
+
+  args.rval().setObject(*result);
+  return true;
+}
+
 static bool ScheduleZoneForGC(JSContext* cx, unsigned argc, Value* vp) {
   CallArgs args = CallArgsFromVp(argc, vp);
 
@@ -3147,6 +3178,10 @@ bool RunIterativeFailureTest(JSContext* cx,
 
   for (unsigned thread = params.threadStart; thread <= params.threadEnd;
        thread++) {
+    if (thread == js::THREAD_TYPE_WORKER) {
+      continue;
+    }
+
     if (params.verbose) {
       fprintf(stderr, "thread %u\n", thread);
     }
@@ -3299,7 +3334,8 @@ bool ParseIterativeFailureTestParams(JSContext* cx, const CallArgs& args,
   int threadOption = 0;
   if (EnvVarAsInt("OOM_THREAD", &threadOption)) {
     if (threadOption < oom::FirstThreadTypeToTest ||
-        threadOption > oom::LastThreadTypeToTest) {
+        threadOption > oom::LastThreadTypeToTest ||
+        threadOption == js::THREAD_TYPE_WORKER) {
       JS_ReportErrorASCII(cx, "OOM_THREAD value out of range.");
       return false;
     }
@@ -7707,6 +7743,12 @@ gc::ZealModeHelpText),
 "gcstate([obj])",
 "  Report the global GC state, or the GC state for the zone containing |obj|."),
 
+    JS_FN_HELP("regExpCodeStats", RegExpCodeStats, 0, 0,
+"regExpCodeStats()",
+"  Report how many times shrinking GCs have kept or discarded the native code\n"
+"  of regexps in the current zone. Code is kept for recently executed regexps,\n"
+"  saving a recompile."),
+
     JS_FN_HELP("schedulezone", ScheduleZoneForGC, 1, 0,
 "schedulezone([obj | string])",
 "  If obj is given, schedule a GC of obj's zone.\n"
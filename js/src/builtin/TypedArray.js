@@ -314,9 +314,8 @@ function TypedArrayFill(value, start = 0, end = undefined) {
         ThrowTypeError(JSMSG_TYPED_ARRAY_DETACHED);
 
     // Step 10.
-    for (; k < final; k++) {
-        O[k] = value;
-    }
+    if (k < final)
+        TypedArrayNativeFill(O, value, k, final);
 
     // Step 11.
     return O;
@@ -555,18 +554,14 @@ function TypedArrayIndexOf(searchElement, fromIndex = 0) {
             k = 0;
     }
 
-    // Step 11.
-    for (; k < len; k++) {
-        // Step 11.a (not necessary in our implementation).
-        assert(k in O, "unexpected missing element");
-
-        // Steps 11.b.i-iii.
-        if (O[k] === searchElement)
-            return k;
-    }
+    // Step 12 (no elements to search, e.g. ToInteger() detached the buffer).
+    if (k >= len)
+        return -1;
 
-    // Step 12.
-    return -1;
+    // Steps 11-12.
+    // Step 11.a is not necessary in our implementation, all elements in
+    // [k, len) exist.
+    return TypedArrayNativeIndexOf(O, searchElement, k);
 }
 
 // ES2021 draft rev 190d474c3d8728653fbf8a5a37db1de34b9c1472
@@ -846,24 +841,9 @@ function TypedArrayReverse() {
     // Step 3.
     var len = TypedArrayLength(O);
 
-    // Step 4.
-    var middle = std_Math_floor(len / 2);
-
-    // Steps 5-6.
-    for (var lower = 0; lower !== middle; lower++) {
-        // Step 6.a.
-        var upper = len - lower - 1;
-
-        // Step 6.d.
-        var lowerValue = O[lower];
-
-        // Step 6.e.
-        var upperValue = O[upper];
-
-        // Steps 6.f-g.
-        O[lower] = upperValue;
-        O[upper] = lowerValue;
-    }
+    // Steps 4-6.
+    if (len > 1)
+        TypedArrayNativeReverse(O);
 
     // Step 7.
     return O;
@@ -1389,18 +1369,17 @@ function TypedArrayIncludes(searchElement, fromIndex = 0) {
             k = 0;
     }
 
-    // Step 11.
-    while (k < len) {
-        // Steps 11.a-b.
-        if (SameValueZero(searchElement, O[k]))
-            return true;
+    // Step 12 (no elements to search).
+    if (k >= len)
+        return false;
 
-        // Step 11.c.
-        k++;
-    }
+    // Reload O.[[ArrayLength]] to detect if ToInteger() detached the
+    // ArrayBuffer. All elements of a detached TypedArray read as undefined.
+    if (TypedArrayLength(O) === 0)
+        return searchElement === undefined;
 
-    // Step 12.
-    return false;
+    // Steps 11-12.
+    return TypedArrayNativeIncludes(O, searchElement, k);
 }
 
 // ES2017 draft rev 6859bb9ccaea9c6ede81d71e5320e3833b92cb3e
@@ -1467,6 +1467,7 @@ static bool BytecodeIsEffectful(JSOp op) {
     case JSOp::PopN:
     case JSOp::DupAt:
     case JSOp::NewArray:
+    case JSOp::NewArrayCopy:
     case JSOp::NewInit:
     case JSOp::NewObject:
     case JSOp::InitElem:
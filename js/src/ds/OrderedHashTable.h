@@ -605,6 +605,22 @@ class OrderedHashTable {
   }
   static constexpr size_t sizeofData() { return sizeof(Data); }
 
+  static size_t offsetOfHashTable() {
+    return offsetof(OrderedHashTable, hashTable);
+  }
+  static size_t offsetOfHashShift() {
+    return offsetof(OrderedHashTable, hashShift);
+  }
+  static size_t offsetOfHcsK0() {
+    return offsetof(OrderedHashTable, hcs) +
+           mozilla::HashCodeScrambler::offsetOfMK0();
+  }
+  static size_t offsetOfHcsK1() {
+    return offsetof(OrderedHashTable, hcs) +
+           mozilla::HashCodeScrambler::offsetOfMK1();
+  }
+  static constexpr size_t offsetOfDataChain() { return offsetof(Data, chain); }
+
  private:
   /* Logarithm base 2 of the number of buckets in the hash table initially. */
   static uint32_t initialBucketsLog2() { return 1; }
@@ -844,6 +860,7 @@ class OrderedHashMap {
   void destroyNurseryRanges() { impl.destroyNurseryRanges(); }
 
   static size_t offsetOfEntryKey() { return Entry::offsetOfKey(); }
+  static size_t offsetOfEntryValue() { return Entry::offsetOfValue(); }
   static size_t offsetOfImplDataLength() { return Impl::offsetOfDataLength(); }
   static size_t offsetOfImplData() { return Impl::offsetOfData(); }
   static constexpr size_t offsetOfImplDataElement() {
@@ -851,6 +868,14 @@ class OrderedHashMap {
   }
   static constexpr size_t sizeofImplData() { return Impl::sizeofData(); }
 
+  static size_t offsetOfImplHashTable() { return Impl::offsetOfHashTable(); }
+  static size_t offsetOfImplHashShift() { return Impl::offsetOfHashShift(); }
+  static size_t offsetOfImplHcsK0() { return Impl::offsetOfHcsK0(); }
+  static size_t offsetOfImplHcsK1() { return Impl::offsetOfHcsK1(); }
+  static constexpr size_t offsetOfImplDataChain() {
+    return Impl::offsetOfDataChain();
+  }
+
   size_t sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) const {
     return impl.sizeOfExcludingThis(mallocSizeOf);
   }
@@ -906,6 +931,14 @@ class OrderedHashSet {
   }
   static constexpr size_t sizeofImplData() { return Impl::sizeofData(); }
 
+  static size_t offsetOfImplHashTable() { return Impl::offsetOfHashTable(); }
+  static size_t offsetOfImplHashShift() { return Impl::offsetOfHashShift(); }
+  static size_t offsetOfImplHcsK0() { return Impl::offsetOfHcsK0(); }
+  static size_t offsetOfImplHcsK1() { return Impl::offsetOfHcsK1(); }
+  static constexpr size_t offsetOfImplDataChain() {
+    return Impl::offsetOfDataChain();
+  }
+
   size_t sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) const {
     return impl.sizeOfExcludingThis(mallocSizeOf);
   }
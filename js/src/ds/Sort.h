@@ -61,35 +61,66 @@ MOZ_ALWAYS_INLINE bool MergeArrayRuns(T* dst, const T* src, size_t run1,
   return true;
 }
 
-} /* namespace detail */
-
 /*
- * Sort the array using the merge sort algorithm. The scratch should point to
- * a temporary storage that can hold nelems elements.
- *
- * The comparator must provide the () operator with the following signature:
- *
- *     bool operator()(const T& a, const T& a, bool* lessOrEqualp);
- *
- * It should return true on success and set *lessOrEqualp to the result of
- * a <= b operation. If it returns false, the sort terminates immediately with
- * the false result. In this case the content of the array and scratch is
- * arbitrary.
- *
- * Note: The merge sort algorithm is a stable sort, preserving relative ordering
- * of entries that compare equal. This makes it a useful substitute for
- * |std::stable_sort|, which can't be used in SpiderMonkey because it internally
- * allocates memory without using SpiderMonkey's allocator.
+ * Helper function for MergeSort. Sets *runLengthp to the length of the sorted
+ * run at the start of the array, which is at least two elements. A strictly
+ * descending run is reversed in place to make it ascending. Runs which are
+ * only non-ascending end at the first pair of equal elements, because
+ * reversing them would change the relative order of equal elements.
  */
 template <typename T, typename Comparator>
-[[nodiscard]] bool MergeSort(T* array, size_t nelems, T* scratch,
-                             Comparator c) {
-  const size_t INS_SORT_LIMIT = 3;
+MOZ_ALWAYS_INLINE bool ScanNaturalRun(T* array, size_t nelems, Comparator& c,
+                                      size_t* runLengthp) {
+  MOZ_ASSERT(nelems >= 2);
 
-  if (nelems <= 1) {
+  bool lessOrEqual;
+  if (!c(array[0], array[1], &lessOrEqual)) {
+    return false;
+  }
+
+  size_t i = 2;
+  if (lessOrEqual) {
+    for (; i < nelems; i++) {
+      if (!c(array[i - 1], array[i], &lessOrEqual)) {
+        return false;
+      }
+      if (!lessOrEqual) {
+        break;
+      }
+    }
+    *runLengthp = i;
     return true;
   }
 
+  for (; i < nelems; i++) {
+    // Check |array[i] < array[i - 1]|, i.e. |!(array[i - 1] <= array[i])|.
+    if (!c(array[i - 1], array[i], &lessOrEqual)) {
+      return false;
+    }
+    if (lessOrEqual) {
+      break;
+    }
+  }
+
+  /* Strictly descending: reverse in place. */
+  for (size_t lo = 0, hi = i - 1; lo < hi; lo++, hi--) {
+    T tmp = array[lo];
+    array[lo] = array[hi];
+    array[hi] = tmp;
+  }
+  *runLengthp = i;
+  return true;
+}
+
+/*
+ * Helper function for MergeSort. Sorts the array without looking for natural
+ * runs first: insertion sort on small chunks, followed by merge passes which
+ * alternate between the array and the scratch space.
+ */
+template <typename T, typename Comparator>
+bool MergeSortChunks(T* array, size_t nelems, T* scratch, Comparator& c) {
+  const size_t INS_SORT_LIMIT = 3;
+
   /*
    * Apply insertion sort to small chunks to reduce the number of merge
    * passes needed.
@@ -124,11 +155,11 @@ template <typename T, typename Comparator>
     for (size_t lo = 0; lo < nelems; lo += 2 * run) {
       size_t hi = lo + run;
       if (hi >= nelems) {
-        detail::CopyNonEmptyArray(vec2 + lo, vec1 + lo, nelems - lo);
+        CopyNonEmptyArray(vec2 + lo, vec1 + lo, nelems - lo);
         break;
       }
       size_t run2 = (run <= nelems - hi) ? run : nelems - hi;
-      if (!detail::MergeArrayRuns(vec2 + lo, vec1 + lo, run, run2, c)) {
+      if (!MergeArrayRuns(vec2 + lo, vec1 + lo, run, run2, c)) {
         return false;
       }
     }
@@ -137,11 +168,74 @@ template <typename T, typename Comparator>
     vec2 = swap;
   }
   if (vec1 == scratch) {
-    detail::CopyNonEmptyArray(array, scratch, nelems);
+    CopyNonEmptyArray(array, scratch, nelems);
   }
   return true;
 }
 
+} /* namespace detail */
+
+/*
+ * Sort the array using the merge sort algorithm. The scratch should point to
+ * a temporary storage that can hold nelems elements.
+ *
+ * The comparator must provide the () operator with the following signature:
+ *
+ *     bool operator()(const T& a, const T& a, bool* lessOrEqualp);
+ *
+ * It should return true on success and set *lessOrEqualp to the result of
+ * a <= b operation. If it returns false, the sort terminates immediately with
+ * the false result. In this case the content of the array and scratch is
+ * arbitrary.
+ *
+ * Note: The merge sort algorithm is a stable sort, preserving relative ordering
+ * of entries that compare equal. This makes it a useful substitute for
+ * |std::stable_sort|, which can't be used in SpiderMonkey because it internally
+ * allocates memory without using SpiderMonkey's allocator.
+ */
+template <typename T, typename Comparator>
+[[nodiscard]] bool MergeSort(T* array, size_t nelems, T* scratch,
+                             Comparator c) {
+  if (nelems <= 1) {
+    return true;
+  }
+
+  /*
+   * Like TimSort, look for a natural run at the start of the array first.
+   * Inputs which are already sorted, or sorted in strictly descending order,
+   * are handled in a single linear pass.
+   */
+  size_t runLength;
+  if (!detail::ScanNaturalRun(array, nelems, c, &runLength)) {
+    return false;
+  }
+  if (runLength == nelems) {
+    return true;
+  }
+
+  /*
+   * If the run breaks late, keep it as the first run: sort only the rest of
+   * the array and merge the two. This saves merge passes over the run, which
+   * pays for the final merge once the run is a sizeable part of the array.
+   * Runs which break early, as they do for most unsorted inputs, aren't worth
+   * it and the whole array is sorted instead.
+   */
+  if (runLength >= nelems / 4) {
+    size_t rest = nelems - runLength;
+    if (!detail::MergeSortChunks(array + runLength, rest, scratch + runLength,
+                                 c)) {
+      return false;
+    }
+    if (!detail::MergeArrayRuns(scratch, array, runLength, rest, c)) {
+      return false;
+    }
+    detail::CopyNonEmptyArray(array, scratch, nelems);
+    return true;
+  }
+
+  return detail::MergeSortChunks(array, nelems, scratch, c);
+}
+
 } /* namespace js */
 
 #endif /* ds_Sort_h */
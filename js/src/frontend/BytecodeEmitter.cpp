@@ -7800,6 +7800,19 @@ bool BytecodeEmitter::isOptimizableSpreadArgument(ParseNode* expr) {
     return true;
   }
 
+  // Property accesses on a name or |this|, like |f(...this.items)| or
+  // |f(...obj.list[i])|, are also likely to be packed arrays. The operand is
+  // evaluated only once either way, so the only cost of getting this wrong is
+  // the extra JSOp::OptimizeSpreadCall check.
+  if (expr->isKind(ParseNodeKind::DotExpr) ||
+      expr->isKind(ParseNodeKind::ElemExpr)) {
+    ParseNode* base = expr->isKind(ParseNodeKind::DotExpr)
+                          ? &expr->as<PropertyAccess>().expression()
+                          : &expr->as<PropertyByValue>().expression();
+    return base->isKind(ParseNodeKind::ThisExpr) ||
+           isOptimizableSpreadArgument(base);
+  }
+
   return allowSelfHostedIter(expr) &&
          isOptimizableSpreadArgument(
              expr->as<BinaryNode>().right()->as<ListNode>().head());
@@ -9465,12 +9478,14 @@ bool BytecodeEmitter::emitDestructuringRestExclusionSetObjLiteral(
   return true;
 }
 
-bool BytecodeEmitter::emitObjLiteralArray(ParseNode* arrayHead) {
-  MOZ_ASSERT(checkSingletonContext());
+bool BytecodeEmitter::emitObjLiteralArray(ParseNode* arrayHead,
+                                          bool singleton) {
+  MOZ_ASSERT_IF(singleton, checkSingletonContext());
 
   ObjLiteralWriter writer;
 
-  ObjLiteralFlags flags({ObjLiteralFlag::Array, ObjLiteralFlag::Singleton});
+  ObjLiteralFlags flags({ObjLiteralFlag::Array});
+  flags.setFlag(ObjLiteralFlag::Singleton, singleton);
 
   writer.beginObject(flags);
 
@@ -9486,8 +9501,11 @@ bool BytecodeEmitter::emitObjLiteralArray(ParseNode* arrayHead) {
     return false;
   }
 
-  if (!emitGCIndexOp(JSOp::Object, index)) {
-    //              [stack] OBJ
+  // JSOp::Object pushes the template array itself, so it may only be used in a
+  // singleton context. Otherwise copy the template's elements into a new array.
+  JSOp op = singleton ? JSOp::Object : JSOp::NewArrayCopy;
+  if (!emitGCIndexOp(op, index)) {
+    //              [stack] ARRAY
     return false;
   }
 
@@ -10259,12 +10277,21 @@ MOZ_NEVER_INLINE bool BytecodeEmitter::emitObject(ListNode* objNode) {
   return true;
 }
 
+// Array literals consisting of at least this many constant primitive values
+// are copied from a template array with JSOp::NewArrayCopy. Shorter literals
+// are cheaper to initialize one element at a time, especially in JIT code.
+static constexpr uint32_t MinNewArrayCopyLength = 8;
+
 bool BytecodeEmitter::emitArrayLiteral(ListNode* array) {
   // Emit JSOp::Object if the array consists entirely of primitive values and we
-  // are in a singleton context.
-  if (checkSingletonContext() && !array->hasNonConstInitializer() &&
-      array->head() && isArrayObjLiteralCompatible(array->head())) {
-    return emitObjLiteralArray(array->head());
+  // are in a singleton context. Emit JSOp::NewArrayCopy for longer arrays of
+  // primitive values outside of a singleton context.
+  if (!array->hasNonConstInitializer() && array->head()) {
+    bool singleton = checkSingletonContext();
+    if ((singleton || array->count() >= MinNewArrayCopyLength) &&
+        isArrayObjLiteralCompatible(array->head())) {
+      return emitObjLiteralArray(array->head(), singleton);
+    }
   }
 
   return emitArray(array->head(), array->count());
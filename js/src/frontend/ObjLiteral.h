@@ -83,6 +83,10 @@
  *   sure that the script, and this program point within the script, will run
  *   *once*. (See the `treatAsRunOnce` flag on JSScript.)
  *
+ * - JSOp::NewArrayCopy, with an array as argument, allocates a new array
+ *   holding a copy of the argument's elements. The argument itself is never
+ *   exposed, so this can be used for array literals anywhere.
+ *
  * An operation occurs in a "singleton context", according to the parser, if it
  * will only ever execute once. In particular, this happens when (i) the script
  * is a "run-once" script, which is usually the case for e.g. top-level scripts
@@ -95,6 +99,9 @@
  *
  * - If in a singleton context, and if we support the values, we use
  *   JSOp::Object and we build the ObjLiteral instructions with values.
+ * - For array literals outside a singleton context, if we support the values
+ *   and the array is long enough, we use JSOp::NewArrayCopy and we build the
+ *   ObjLiteral instructions with values.
  * - Otherwise, if we support the keys but not the values, or if we are not
  *   in a singleton context, we use JSOp::NewObject. In this case, the initial
  *   opcode only creates an object with empty values, so BytecodeEmitter then
@@ -4383,7 +4383,10 @@ void GCRuntime::purgePropMapTablesForShrinkingGC() {
     }
     for (auto map = zone->cellIterUnsafe<DictionaryPropMap>(); !map.done();
          map.next()) {
-      if (map->asLinked()->hasTable()) {
+      JS::AutoCheckCannotGC nogc;
+      PropMapTable* table = map->asLinked()->maybeTable(nogc);
+      if (table &&
+          table->entryCount() < DictionaryPropMap::MinEntriesToKeepTable) {
         map->asLinked()->purgeTable(rt->defaultFreeOp());
       }
     }
@@ -5735,6 +5738,10 @@ IncrementalProgress GCRuntime::beginSweepingSweepGroup(JSFreeOp* fop,
   validateIncrementalMarking();
 #endif
 
+  // The mutator may have cached shapes that died during marking. These must
+  // be dropped before their cells can be reused.
+  rt->caches().interpreterPropertyCache.purge();
+
 #ifdef DEBUG
   for (auto cell : cellsToAssertNotGray.ref()) {
     JS::AssertCellIsNotGray(cell);
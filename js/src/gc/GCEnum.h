@@ -110,6 +110,7 @@ enum class GCAbortReason {
   _(RegExpStatics)                         \
   _(RegExpSharedBytecode)                  \
   _(RegExpSharedNamedCaptureData)          \
+  _(RegExpSharedLinearProgram)             \
   _(TypedArrayElements)                    \
   _(NativeIterator)                        \
   _(JitScript)                             \
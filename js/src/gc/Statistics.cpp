@@ -19,6 +19,7 @@
 #include "gc/GC.h"
 #include "gc/GCInternals.h"
 #include "gc/Memory.h"
+#include "jit/JitRuntime.h"
 #include "js/friend/UsageStatistics.h"  // JS_TELEMETRY_*
 #include "util/GetPidProvider.h"
 #include "util/Text.h"
@@ -1098,6 +1099,16 @@ void Statistics::sendGCTelemetry() {
                             uint32_t(effectiveness));
     }
   }
+
+  // Most Baseline code is released by GC, so report how much of it was
+  // compiled needlessly here.
+  if (jit::JitRuntime* jitRuntime = runtime->jitRuntime()) {
+    uint32_t rarelyRunPercent;
+    if (jitRuntime->takeRarelyRunBaselineScriptsPercent(&rarelyRunPercent)) {
+      runtime->addTelemetry(JS_TELEMETRY_BASELINE_RARELY_RUN,
+                            rarelyRunPercent);
+    }
+  }
 }
 
 void Statistics::beginNurseryCollection(JS::GCReason reason) {
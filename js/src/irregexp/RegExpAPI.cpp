@@ -23,12 +23,17 @@
 #include "irregexp/imported/regexp-parser.h"
 #include "irregexp/imported/regexp-stack.h"
 #include "irregexp/imported/regexp.h"
+#include "irregexp/RegExpLinear.h"
 #include "irregexp/RegExpNativeMacroAssembler.h"
 #include "irregexp/RegExpShim.h"
+#include "jit/CompileWrappers.h"
+#include "jit/Ion.h"
 #include "jit/JitCommon.h"
 #include "js/friend/ErrorMessages.h"  // JSMSG_*
 #include "js/friend/StackLimits.h"    // js::ReportOverRecursed
 #include "util/StringBuffer.h"
+#include "vm/HelperThreads.h"
+#include "vm/HelperThreadState.h"
 #include "vm/MatchPairs.h"
 #include "vm/RegExpShared.h"
 
@@ -44,13 +49,16 @@ using mozilla::Some;
 using frontend::DummyTokenStream;
 using frontend::TokenStreamAnyChars;
 
+using v8::internal::CharacterRange;
 using v8::internal::DisallowGarbageCollection;
 using v8::internal::FlatStringReader;
 using v8::internal::HandleScope;
 using v8::internal::InputOutputData;
 using v8::internal::IrregexpInterpreter;
 using v8::internal::NativeRegExpMacroAssembler;
+using v8::internal::RegExpAtom;
 using v8::internal::RegExpBytecodeGenerator;
+using v8::internal::RegExpCharacterClass;
 using v8::internal::RegExpCompileData;
 using v8::internal::RegExpCompiler;
 using v8::internal::RegExpError;
@@ -58,8 +66,12 @@ using v8::internal::RegExpMacroAssembler;
 using v8::internal::RegExpMacroAssemblerTracer;
 using v8::internal::RegExpNode;
 using v8::internal::RegExpParser;
+using v8::internal::RegExpQuantifier;
+using v8::internal::RegExpTree;
 using v8::internal::SMRegExpMacroAssembler;
+using v8::internal::TextElement;
 using v8::internal::Zone;
+using v8::internal::ZoneList;
 
 using V8HandleString = v8::internal::Handle<v8::internal::String>;
 using V8HandleRegExp = v8::internal::Handle<v8::internal::JSRegExp>;
@@ -460,35 +472,17 @@ enum class AssembleResult {
   OutOfMemory,
 };
 
-[[nodiscard]] static AssembleResult Assemble(
-    JSContext* cx, RegExpCompiler* compiler, RegExpCompileData* data,
-    MutableHandleRegExpShared re, HandleAtom pattern, Zone* zone,
-    bool useNativeCode, bool isLatin1) {
-  // Because we create a StackMacroAssembler, this function is not allowed
-  // to GC. If needed, we allocate and throw errors in the caller.
-  Maybe<jit::JitContext> jctx;
-  Maybe<js::jit::StackMacroAssembler> stack_masm;
-  UniquePtr<RegExpMacroAssembler> masm;
-  if (useNativeCode) {
-    NativeRegExpMacroAssembler::Mode mode =
-        isLatin1 ? NativeRegExpMacroAssembler::LATIN1
-                 : NativeRegExpMacroAssembler::UC16;
-    // If we are compiling native code, we need a macroassembler,
-    // which needs a jit context.
-    jctx.emplace(cx, nullptr);
-    stack_masm.emplace();
-    uint32_t num_capture_registers = re->pairCount() * 2;
-    masm = MakeUnique<SMRegExpMacroAssembler>(cx, stack_masm.ref(), zone, mode,
-                                              num_capture_registers);
-  } else {
-    masm = MakeUnique<RegExpBytecodeGenerator>(cx->isolate, zone);
-  }
-  if (!masm) {
-    return AssembleResult::OutOfMemory;
-  }
-
+// Generate code for |data|, which |compiler| has preprocessed, with |masm|.
+// |pattern| is only used for tracing, so off-thread compilations pass a
+// placeholder; |patternLength| is the length of the real pattern.
+[[nodiscard]] static AssembleResult AssembleCode(
+    Isolate* isolate, RegExpCompiler* compiler, RegExpCompileData* data,
+    RegExpMacroAssembler* masm, JSAtom* pattern, size_t patternLength,
+    JS::RegExpFlags flags, uint32_t backtrackLimit,
+    v8::internal::Handle<v8::internal::Object>* code,
+    uint32_t* numRegisters) {
   bool isLargePattern =
-      pattern->length() > v8::internal::RegExp::kRegExpTooLargeToOptimize;
+      patternLength > v8::internal::RegExp::kRegExpTooLargeToOptimize;
   masm->set_slow_safe(isLargePattern);
   if (compiler->optimize()) {
     compiler->set_optimize(!isLargePattern);
@@ -503,62 +497,125 @@ enum class AssembleResult {
   bool is_end_anchored = data->tree->IsAnchoredAtEnd();
   int max_length = data->tree->max_match();
   static const int kMaxBacksearchLimit = 1024;
-  if (is_end_anchored && !is_start_anchored && !re->sticky() &&
+  if (is_end_anchored && !is_start_anchored && !flags.sticky() &&
       max_length < kMaxBacksearchLimit) {
     masm->SetCurrentPositionFromEnd(max_length);
   }
 
-  if (re->global()) {
+  if (backtrackLimit) {
+    masm->set_backtrack_limit(backtrackLimit);
+    masm->set_can_fallback(true);
+  }
+
+  if (flags.global()) {
     RegExpMacroAssembler::GlobalMode mode = RegExpMacroAssembler::GLOBAL;
     if (data->tree->min_match() > 0) {
       mode = RegExpMacroAssembler::GLOBAL_NO_ZERO_LENGTH_CHECK;
-    } else if (re->unicode()) {
+    } else if (flags.unicode()) {
       mode = RegExpMacroAssembler::GLOBAL_UNICODE;
     }
     masm->set_global_mode(mode);
   }
 
   // The masm tracer works as a thin wrapper around another macroassembler.
-  RegExpMacroAssembler* masm_ptr = masm.get();
+  RegExpMacroAssembler* masm_ptr = masm;
 #ifdef DEBUG
   UniquePtr<RegExpMacroAssembler> tracer_masm;
   if (jit::JitOptions.traceRegExpAssembler) {
-    tracer_masm = MakeUnique<RegExpMacroAssemblerTracer>(cx->isolate, masm_ptr);
+    tracer_masm = MakeUnique<RegExpMacroAssemblerTracer>(isolate, masm_ptr);
     masm_ptr = tracer_masm.get();
   }
 #endif
 
   // Compile the regexp.
-  V8HandleString wrappedPattern(v8::internal::String(pattern), cx->isolate);
+  V8HandleString wrappedPattern(v8::internal::String(pattern), isolate);
   RegExpCompiler::CompilationResult result = compiler->Assemble(
-      cx->isolate, masm_ptr, data->node, data->capture_count, wrappedPattern);
+      isolate, masm_ptr, data->node, data->capture_count, wrappedPattern);
   if (!result.Succeeded()) {
     MOZ_ASSERT(result.error == RegExpError::kTooLarge);
     return AssembleResult::TooLarge;
   }
   if (result.code->value().isUndefined()) {
     // SMRegExpMacroAssembler::GetCode returns undefined on OOM.
-    MOZ_ASSERT(useNativeCode);
     return AssembleResult::OutOfMemory;
   }
 
-  re->updateMaxRegisters(result.num_registers);
+  *code = result.code;
+  *numRegisters = result.num_registers;
+  return AssembleResult::Success;
+}
+
+// Move the tables that |masm|'s code refers to into |re|, and install the
+// code.
+[[nodiscard]] static bool InstallJitCode(MutableHandleRegExpShared re,
+                                         SMRegExpMacroAssembler* masm,
+                                         jit::JitCode* code,
+                                         uint32_t numRegisters,
+                                         bool isLatin1) {
+  // Transfer ownership of the tables from the macroassembler to the
+  // RegExpShared.
+  SMRegExpMacroAssembler::TableVector& tables = masm->tables();
+  for (uint32_t i = 0; i < tables.length(); i++) {
+    if (!re->addTable(std::move(tables[i]))) {
+      return false;
+    }
+  }
+  re->updateMaxRegisters(numRegisters);
+  re->setJitCode(code, isLatin1);
+  return true;
+}
+
+[[nodiscard]] static AssembleResult Assemble(
+    JSContext* cx, RegExpCompiler* compiler, RegExpCompileData* data,
+    MutableHandleRegExpShared re, HandleAtom pattern, Zone* zone,
+    bool useNativeCode, bool isLatin1) {
+  // Because we create a StackMacroAssembler, this function is not allowed
+  // to GC. If needed, we allocate and throw errors in the caller.
+  Maybe<jit::JitContext> jctx;
+  Maybe<js::jit::StackMacroAssembler> stack_masm;
+  UniquePtr<RegExpMacroAssembler> masm;
   if (useNativeCode) {
-    // Transfer ownership of the tables from the macroassembler to the
-    // RegExpShared.
-    SMRegExpMacroAssembler::TableVector& tables =
-        static_cast<SMRegExpMacroAssembler*>(masm.get())->tables();
-    for (uint32_t i = 0; i < tables.length(); i++) {
-      if (!re->addTable(std::move(tables[i]))) {
-        return AssembleResult::OutOfMemory;
-      }
+    NativeRegExpMacroAssembler::Mode mode =
+        isLatin1 ? NativeRegExpMacroAssembler::LATIN1
+                 : NativeRegExpMacroAssembler::UC16;
+    // If we are compiling native code, we need a macroassembler,
+    // which needs a jit context.
+    jctx.emplace(cx, nullptr);
+    stack_masm.emplace();
+    uint32_t num_capture_registers = re->pairCount() * 2;
+    masm = MakeUnique<SMRegExpMacroAssembler>(cx, cx->isolate, cx->isolate,
+                                              stack_masm.ref(), zone, mode,
+                                              num_capture_registers);
+  } else {
+    masm = MakeUnique<RegExpBytecodeGenerator>(cx->isolate, zone);
+  }
+  if (!masm) {
+    return AssembleResult::OutOfMemory;
+  }
+
+  v8::internal::Handle<v8::internal::Object> code;
+  uint32_t numRegisters = 0;
+  AssembleResult result =
+      AssembleCode(cx->isolate, compiler, data, masm.get(), pattern,
+                   pattern->length(), re->getFlags(), re->backtrackLimit(),
+                   &code, &numRegisters);
+  if (result != AssembleResult::Success) {
+    MOZ_ASSERT_IF(result == AssembleResult::OutOfMemory, useNativeCode);
+    return result;
+  }
+
+  if (useNativeCode) {
+    if (!InstallJitCode(re, static_cast<SMRegExpMacroAssembler*>(masm.get()),
+                        v8::internal::Code::cast(*code).inner(), numRegisters,
+                        isLatin1)) {
+      return AssembleResult::OutOfMemory;
     }
-    re->setJitCode(v8::internal::Code::cast(*result.code).inner(), isLatin1);
   } else {
+    re->updateMaxRegisters(numRegisters);
     // Transfer ownership of the bytecode from the HandleScope to the
     // RegExpShared.
     ByteArray bytecode =
-        v8::internal::ByteArray::cast(*result.code).takeOwnership(cx->isolate);
+        v8::internal::ByteArray::cast(*code).takeOwnership(cx->isolate);
     uint32_t length = bytecode->length;
     re->setByteCode(bytecode.release(), isLatin1);
     js::AddCellMemory(re, length, MemoryUse::RegExpSharedBytecode);
@@ -567,6 +624,261 @@ enum class AssembleResult {
   return AssembleResult::Success;
 }
 
+using LiteralVector = Vector<char16_t, 32, SystemAllocPolicy>;
+
+// Append to |prefix| a literal that every match of |tree| starts with. Returns
+// true if every match of |tree| is exactly that literal, in which case
+// whatever follows |tree| can extend the prefix. Running out of memory only
+// makes the prefix shorter.
+static bool AppendLiteralPrefix(RegExpTree* tree, LiteralVector& prefix) {
+  if (tree->IsAtom()) {
+    RegExpAtom* atom = tree->AsAtom();
+    return prefix.append(atom->data().begin(), atom->length());
+  }
+  if (tree->IsText()) {
+    ZoneList<TextElement>* elements = tree->AsText()->elements();
+    for (int i = 0; i < elements->length(); i++) {
+      const TextElement& element = elements->at(i);
+      if (element.text_type() != TextElement::ATOM ||
+          !AppendLiteralPrefix(element.atom(), prefix)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsAlternative()) {
+    ZoneList<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (int i = 0; i < nodes->length(); i++) {
+      if (!AppendLiteralPrefix(nodes->at(i), prefix)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsDisjunction()) {
+    // Every match starts with the longest common prefix of the alternatives.
+    ZoneList<RegExpTree*>* alternatives = tree->AsDisjunction()->alternatives();
+    LiteralVector common;
+    AppendLiteralPrefix(alternatives->at(0), common);
+    for (int i = 1; i < alternatives->length() && !common.empty(); i++) {
+      LiteralVector other;
+      AppendLiteralPrefix(alternatives->at(i), other);
+      size_t length = 0;
+      while (length < common.length() && length < other.length() &&
+             common[length] == other[length]) {
+        length++;
+      }
+      common.shrinkTo(length);
+    }
+    (void)prefix.append(common.begin(), common.end());
+    return false;
+  }
+  if (tree->IsCapture()) {
+    return AppendLiteralPrefix(tree->AsCapture()->body(), prefix);
+  }
+  if (tree->IsGroup()) {
+    return AppendLiteralPrefix(tree->AsGroup()->body(), prefix);
+  }
+  if (tree->IsQuantifier()) {
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    if (quantifier->min() == 0) {
+      return false;
+    }
+    bool complete = AppendLiteralPrefix(quantifier->body(), prefix);
+    return complete && quantifier->max() == 1;
+  }
+  // Assertions don't consume any input, so they don't end the prefix.
+  return tree->IsAssertion() || tree->IsEmpty();
+}
+
+// Find the longest atom that every match of |tree| contains.
+static void FindRequiredAtom(RegExpTree* tree, RegExpAtom** best) {
+  if (tree->IsAtom()) {
+    RegExpAtom* atom = tree->AsAtom();
+    if (!*best || atom->length() > (*best)->length()) {
+      *best = atom;
+    }
+  } else if (tree->IsText()) {
+    ZoneList<TextElement>* elements = tree->AsText()->elements();
+    for (int i = 0; i < elements->length(); i++) {
+      const TextElement& element = elements->at(i);
+      if (element.text_type() == TextElement::ATOM) {
+        FindRequiredAtom(element.atom(), best);
+      }
+    }
+  } else if (tree->IsAlternative()) {
+    ZoneList<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (int i = 0; i < nodes->length(); i++) {
+      FindRequiredAtom(nodes->at(i), best);
+    }
+  } else if (tree->IsCapture()) {
+    FindRequiredAtom(tree->AsCapture()->body(), best);
+  } else if (tree->IsGroup()) {
+    FindRequiredAtom(tree->AsGroup()->body(), best);
+  } else if (tree->IsQuantifier() && tree->AsQuantifier()->min() > 0) {
+    FindRequiredAtom(tree->AsQuantifier()->body(), best);
+  }
+}
+
+// Find a literal that every match of the pattern contains, so that the input
+// can be searched for it before running the matcher. A literal that every
+// match starts with is preferred, because then the search also tells us where
+// the first possible match is. Returns false on OOM; |literal| is left null if
+// there is no useful literal.
+static bool FindRequiredLiteral(JSContext* cx, RegExpCompileData& data,
+                                JS::RegExpFlags flags,
+                                MutableHandleAtom literal, bool* isPrefix) {
+  // Sticky and start-anchored patterns are only tried at one position, and
+  // case-insensitive patterns don't match their literals exactly. Unicode
+  // patterns are left alone so that we never skip into the middle of a
+  // surrogate pair.
+  if (flags.sticky() || flags.ignoreCase() || flags.unicode() ||
+      data.tree->IsAnchoredAtStart()) {
+    return true;
+  }
+
+  LiteralVector prefix;
+  AppendLiteralPrefix(data.tree, prefix);
+  if (!prefix.empty()) {
+    literal.set(AtomizeChars(cx, prefix.begin(), prefix.length()));
+    *isPrefix = true;
+    return !!literal;
+  }
+
+  // A single required character isn't worth an extra pass over the input.
+  RegExpAtom* atom = nullptr;
+  FindRequiredAtom(data.tree, &atom);
+  if (atom && atom->length() >= 2) {
+    literal.set(AtomizeChars(cx, atom->data().begin(), atom->length()));
+    *isPrefix = false;
+    return !!literal;
+  }
+  return true;
+}
+
+using FirstCharSet = RegExpShared::FirstCharSet;
+
+enum class FirstChars {
+  // The first code unit of every match of the tree is in the set.
+  Known,
+  // The tree never consumes any input.
+  ZeroWidth,
+  // The first code unit isn't limited to a set of Latin-1 characters.
+  Unknown,
+};
+
+static FirstChars AddFirstChars(RegExpCharacterClass* cc, Zone* zone,
+                                FirstCharSet& chars) {
+  if (cc->is_negated()) {
+    return FirstChars::Unknown;
+  }
+  ZoneList<CharacterRange>* ranges = cc->ranges(zone);
+  for (int i = 0; i < ranges->length(); i++) {
+    const CharacterRange& range = ranges->at(i);
+    if (range.to() > JSString::MAX_LATIN1_CHAR) {
+      return FirstChars::Unknown;
+    }
+    for (uint32_t c = range.from(); c <= range.to(); c++) {
+      chars[c] = true;
+    }
+  }
+  return FirstChars::Known;
+}
+
+static FirstChars AddFirstChars(RegExpAtom* atom, FirstCharSet& chars) {
+  char16_t c = atom->data().at(0);
+  if (c > JSString::MAX_LATIN1_CHAR) {
+    return FirstChars::Unknown;
+  }
+  chars[c] = true;
+  return FirstChars::Known;
+}
+
+// Add to |chars| the code units that a match of |tree| can start with.
+static FirstChars AddFirstChars(RegExpTree* tree, Zone* zone,
+                                FirstCharSet& chars) {
+  if (tree->IsAtom()) {
+    return AddFirstChars(tree->AsAtom(), chars);
+  }
+  if (tree->IsText()) {
+    const TextElement& element = tree->AsText()->elements()->at(0);
+    return element.text_type() == TextElement::ATOM
+               ? AddFirstChars(element.atom(), chars)
+               : AddFirstChars(element.char_class(), zone, chars);
+  }
+  if (tree->IsCharacterClass()) {
+    return AddFirstChars(tree->AsCharacterClass(), zone, chars);
+  }
+  if (tree->IsAlternative()) {
+    // The first node that consumes input decides.
+    ZoneList<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (int i = 0; i < nodes->length(); i++) {
+      FirstChars result = AddFirstChars(nodes->at(i), zone, chars);
+      if (result != FirstChars::ZeroWidth) {
+        return result;
+      }
+    }
+    return FirstChars::ZeroWidth;
+  }
+  if (tree->IsDisjunction()) {
+    // Every alternative has to consume input, or whatever follows the
+    // disjunction could start the match.
+    ZoneList<RegExpTree*>* alternatives = tree->AsDisjunction()->alternatives();
+    for (int i = 0; i < alternatives->length(); i++) {
+      if (AddFirstChars(alternatives->at(i), zone, chars) !=
+          FirstChars::Known) {
+        return FirstChars::Unknown;
+      }
+    }
+    return FirstChars::Known;
+  }
+  if (tree->IsCapture()) {
+    return AddFirstChars(tree->AsCapture()->body(), zone, chars);
+  }
+  if (tree->IsGroup()) {
+    return AddFirstChars(tree->AsGroup()->body(), zone, chars);
+  }
+  if (tree->IsQuantifier()) {
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    if (quantifier->min() == 0) {
+      return FirstChars::Unknown;
+    }
+    return AddFirstChars(quantifier->body(), zone, chars);
+  }
+  if (tree->IsAssertion() || tree->IsLookaround() || tree->IsEmpty()) {
+    return FirstChars::ZeroWidth;
+  }
+  // Back references can match anything, including the empty string.
+  return FirstChars::Unknown;
+}
+
+// Find the set of code units that every match of the pattern starts with, so
+// that positions where no match can start are skipped before running the
+// matcher. This matters most for large alternations of literals: irregexp
+// already factors their common prefixes into a trie, but has to try each
+// branch of the trie's root at every position. Returns the size of the set,
+// or zero if there is no useful set.
+static uint32_t FindFirstChars(RegExpCompileData& data, JS::RegExpFlags flags,
+                               Zone* zone, FirstCharSet& chars) {
+  // As for required literals, case-insensitive patterns would need their
+  // first characters to be case-folded.
+  if (flags.sticky() || flags.ignoreCase() || data.tree->IsAnchoredAtStart()) {
+    return 0;
+  }
+
+  if (AddFirstChars(data.tree, zone, chars) != FirstChars::Known) {
+    return 0;
+  }
+
+  uint32_t count = 0;
+  for (size_t i = 0; i < chars.Size(); i++) {
+    if (chars.Test(i)) {
+      count++;
+    }
+  }
+  return count <= RegExpShared::MaxFirstChars ? count : 0;
+}
+
 bool CompilePattern(JSContext* cx, MutableHandleRegExpShared re,
                     HandleLinearString input, RegExpShared::CodeKind codeKind) {
   RootedAtom pattern(cx, re->getSource());
@@ -624,10 +936,33 @@ bool CompilePattern(JSContext* cx, MutableHandleRegExpShared re,
         return false;
       }
     }
+    RootedAtom requiredLiteral(cx);
+    bool requiredLiteralIsPrefix = false;
+    if (!FindRequiredLiteral(cx, data, flags, &requiredLiteral,
+                             &requiredLiteralIsPrefix)) {
+      return false;
+    }
     // All fallible initialization has succeeded, so we can change state.
     // Add one to capture_count to account for the whole-match capture.
     uint32_t pairCount = data.capture_count + 1;
     re->useRegExpMatch(pairCount);
+    if (requiredLiteral) {
+      re->setRequiredLiteral(requiredLiteral, requiredLiteralIsPrefix);
+    }
+
+    // A literal prefix already tells us where the first match can start.
+    if (!requiredLiteral || !requiredLiteralIsPrefix) {
+      FirstCharSet firstChars;
+      if (uint32_t count = FindFirstChars(data, flags, &zone, firstChars)) {
+        re->setFirstChars(firstChars, count);
+      }
+    }
+
+    // Patterns that the linear-time engine supports are run with a backtrack
+    // limit, so that catastrophic backtracking can be detected.
+    if (CanUseLinearEngine(data.tree, flags)) {
+      re->setBacktrackLimit(jit::JitOptions.regexpBacktrackLimit);
+    }
   }
 
   MOZ_ASSERT(re->kind() == RegExpShared::Kind::RegExp);
@@ -664,6 +999,195 @@ bool CompilePattern(JSContext* cx, MutableHandleRegExpShared re,
   return true;
 }
 
+RegExpCompileTask::RegExpCompileTask(JSContext* cx, RegExpShared* re,
+                                     bool isLatin1)
+    : runtime_(cx->runtime()),
+      cx_(cx),
+      cxIsolate_(cx->isolate),
+      placeholderPattern_(cx->names().empty),
+      flags_(re->getFlags()),
+      isLatin1_(isLatin1),
+      pairCount_(re->pairCount()),
+      backtrackLimit_(re->backtrackLimit()),
+      patternLength_(re->getSource()->length()),
+      alloc_(jit::TempAllocator::PreferredLifoChunkSize),
+      temp_(&alloc_) {}
+
+RegExpCompileTask::~RegExpCompileTask() = default;
+
+bool RegExpCompileTask::parse(JSContext* cx, HandleAtom pattern) {
+  zone_ = cx->make_unique<Zone>(alloc_);
+  if (!zone_) {
+    return false;
+  }
+
+  // The pattern was parsed successfully when it was first compiled, so the
+  // only way to fail here is OOM.
+  HandleScope handleScope(cx->isolate);
+  RegExpCompileData data;
+  FlatStringReader patternBytes(cx, pattern);
+  if (!RegExpParser::ParseRegExp(cx->isolate, zone_.get(), &patternBytes,
+                                 flags_, &data)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
+  tree_ = data.tree;
+  captureCount_ = data.capture_count;
+  return true;
+}
+
+void RegExpCompileTask::runHelperThreadTask(AutoLockHelperThreadState& locked) {
+  {
+    AutoSetHelperThreadContext usesContext(locked);
+    AutoUnlockHelperThreadState unlock(locked);
+    AutoSetContextRuntime ascr(runtime_);
+    runTask(TlsContext.get());
+  }
+
+  state_ = State::Finished;
+  if (abandoned_) {
+    js_delete(this);
+  }
+}
+
+void RegExpCompileTask::runTask(JSContext* cx) {
+  jit::JitContext jctx(jit::CompileRuntime::get(runtime_), &temp_);
+  HandleScope handleScope(cx->isolate);
+
+  // The depth of the pattern was checked on the main thread, but helper
+  // threads have smaller stacks.
+  RegExpDepthCheck depthCheck(cx);
+  if (!depthCheck.check(tree_)) {
+    return;
+  }
+
+  RegExpCompileData data;
+  data.tree = tree_;
+  data.capture_count = captureCount_;
+
+  // Unlike main thread compilations, there is no input string to sample
+  // character frequencies from.
+  RegExpCompiler compiler(cx->isolate, zone_.get(), captureCount_, isLatin1_);
+  data.node = compiler.PreprocessRegExp(&data, flags_, isLatin1_);
+  if (AnalyzeRegExp(cx->isolate, isLatin1_, data.node) != RegExpError::kNone) {
+    return;
+  }
+
+  masm_ = MakeUnique<jit::RegExpHeapMacroAssembler>();
+  if (!masm_) {
+    return;
+  }
+  NativeRegExpMacroAssembler::Mode mode =
+      isLatin1_ ? NativeRegExpMacroAssembler::LATIN1
+                : NativeRegExpMacroAssembler::UC16;
+  regexpMasm_ = MakeUnique<SMRegExpMacroAssembler>(
+      cx_, cxIsolate_, cx->isolate, *masm_, zone_.get(), mode, pairCount_ * 2);
+  if (!regexpMasm_) {
+    return;
+  }
+
+  v8::internal::Handle<v8::internal::Object> code;
+  AssembleResult result = AssembleCode(
+      cx->isolate, &compiler, &data, regexpMasm_.get(), placeholderPattern_,
+      patternLength_, flags_, backtrackLimit_, &code, &numRegisters_);
+  succeeded_ = result == AssembleResult::Success;
+}
+
+bool RegExpCompileTask::link(JSContext* cx, MutableHandleRegExpShared re) {
+  MOZ_ASSERT(cx == cx_);
+
+  // The regexp may have switched to the linear-time engine, or dropped its
+  // backtrack limit, while the task was running.
+  if (!succeeded_ || re->linearProgram() ||
+      re->backtrackLimit() != backtrackLimit_ ||
+      re->isCompiled(isLatin1_, RegExpShared::CodeKind::Jitcode)) {
+    return true;
+  }
+
+  jit::JitContext jctx(cx, &temp_);
+  if (!cx->realm()->ensureJitRealmExists(cx)) {
+    return false;
+  }
+
+  jit::JitCode* code = regexpMasm_->Link(cx);
+  if (!code) {
+    return false;
+  }
+  if (!InstallJitCode(re, regexpMasm_.get(), code, numRegisters_, isLatin1_)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+  return true;
+}
+
+bool ShouldCompileOffThread(JSContext* cx, RegExpShared* re) {
+  if (re->offThreadCompileTask()) {
+    return true;
+  }
+  uint32_t minLength = jit::JitOptions.regexpOffThreadCompileMinLength;
+  return minLength && re->getSource()->length() >= minLength &&
+         jit::OffThreadCompilationAvailable(cx);
+}
+
+bool CompilePatternOffThread(JSContext* cx, MutableHandleRegExpShared re,
+                             HandleLinearString input) {
+  bool isLatin1 = input->hasLatin1Chars();
+
+  auto compileByteCode = [&]() {
+    if (re->isCompiled(isLatin1, RegExpShared::CodeKind::Bytecode)) {
+      return true;
+    }
+    return CompilePattern(cx, re, input, RegExpShared::CodeKind::Bytecode);
+  };
+
+  // The pattern has to be parsed on the main thread first.
+  if (re->kind() == RegExpShared::Kind::Unparsed) {
+    if (!compileByteCode()) {
+      return false;
+    }
+    if (re->kind() == RegExpShared::Kind::Atom) {
+      return true;
+    }
+  }
+
+  if (RegExpCompileTask* task = re->offThreadCompileTask()) {
+    if (!IsOffThreadRegExpCompileFinished(task)) {
+      if (task->isLatin1() == isLatin1) {
+        return compileByteCode();
+      }
+      // Only one compilation runs at a time. Compile the code for the other
+      // encoding on the main thread.
+      return CompilePattern(cx, re, input, RegExpShared::CodeKind::Jitcode);
+    }
+
+    UniquePtr<RegExpCompileTask> finished(re->takeOffThreadCompileTask());
+    if (!finished->link(cx, re)) {
+      return false;
+    }
+    if (re->isCompiled(isLatin1, RegExpShared::CodeKind::Jitcode)) {
+      return true;
+    }
+    if (finished->isLatin1() == isLatin1) {
+      // The compilation failed or is out of date. Don't try again off
+      // thread: compiling on the main thread reports any error.
+      return CompilePattern(cx, re, input, RegExpShared::CodeKind::Jitcode);
+    }
+  }
+
+  RootedAtom pattern(cx, re->getSource());
+  auto task = cx->make_unique<RegExpCompileTask>(cx, re, isLatin1);
+  if (!task || !task->parse(cx, pattern)) {
+    return false;
+  }
+  if (!StartOffThreadRegExpCompile(task.get())) {
+    return CompilePattern(cx, re, input, RegExpShared::CodeKind::Jitcode);
+  }
+  re->setOffThreadCompileTask(task.release());
+
+  return compileByteCode();
+}
+
 template <typename CharT>
 RegExpRunStatus ExecuteRaw(jit::JitCode* code, const CharT* chars,
                            size_t length, size_t startIndex,
@@ -700,6 +1224,8 @@ RegExpRunStatus Interpret(JSContext* cx, MutableHandleRegExpShared re,
                 v8::internal::RegExp::kInternalRegExpSuccess);
   static_assert(RegExpRunStatus_Success_NotFound ==
                 v8::internal::RegExp::kInternalRegExpFailure);
+  static_assert(RegExpRunStatus_Fallback ==
+                v8::internal::RegExp::kInternalRegExpFallbackToExperimental);
 
   RegExpRunStatus status =
       (RegExpRunStatus)IrregexpInterpreter::MatchForCallFromRuntime(
@@ -708,14 +1234,17 @@ RegExpRunStatus Interpret(JSContext* cx, MutableHandleRegExpShared re,
 
   MOZ_ASSERT(status == RegExpRunStatus_Error ||
              status == RegExpRunStatus_Success ||
-             status == RegExpRunStatus_Success_NotFound);
+             status == RegExpRunStatus_Success_NotFound ||
+             status == RegExpRunStatus_Fallback);
 
   return status;
 }
 
-RegExpRunStatus Execute(JSContext* cx, MutableHandleRegExpShared re,
-                        HandleLinearString input, size_t startIndex,
-                        VectorMatchPairs* matches) {
+static RegExpRunStatus ExecuteIrregexp(JSContext* cx,
+                                       MutableHandleRegExpShared re,
+                                       HandleLinearString input,
+                                       size_t startIndex,
+                                       VectorMatchPairs* matches) {
   bool latin1 = input->hasLatin1Chars();
   jit::JitCode* jitCode = re->getJitCode(latin1);
   bool isCompiled = !!jitCode;
@@ -736,6 +1265,42 @@ RegExpRunStatus Execute(JSContext* cx, MutableHandleRegExpShared re,
   return Interpret(cx, re, input, startIndex, matches);
 }
 
+void FallBackToLinearEngine(JSContext* cx, MutableHandleRegExpShared re) {
+  MOZ_ASSERT(re->backtrackLimit());
+  MOZ_ASSERT(!re->linearProgram());
+
+  RootedAtom pattern(cx, re->getSource());
+  JS::RegExpFlags flags = re->getFlags();
+  LifoAllocScope allocScope(&cx->tempLifoAlloc());
+  HandleScope handleScope(cx->isolate);
+  Zone zone(allocScope.alloc());
+
+  RegExpCompileData data;
+  FlatStringReader patternBytes(cx, pattern);
+  if (RegExpParser::ParseRegExp(cx->isolate, &zone, &patternBytes, flags,
+                                &data)) {
+    LinearProgram* program = CompileLinearProgram(
+        cx->isolate, &zone, data.tree, re->pairCount(), flags);
+    if (program) {
+      re->useLinearProgram(program);
+      return;
+    }
+  }
+
+  // The program is too large, or we ran out of memory. Keep using irregexp,
+  // without a backtrack limit.
+  re->clearBacktrackLimit();
+}
+
+RegExpRunStatus Execute(JSContext* cx, MutableHandleRegExpShared re,
+                        HandleLinearString input, size_t startIndex,
+                        VectorMatchPairs* matches) {
+  if (LinearProgram* program = re->linearProgram()) {
+    return ExecuteLinear(cx, program, input, startIndex, matches);
+  }
+  return ExecuteIrregexp(cx, re, input, startIndex, matches);
+}
+
 RegExpRunStatus ExecuteForFuzzing(JSContext* cx, HandleAtom pattern,
                                   HandleLinearString input,
                                   JS::RegExpFlags flags, size_t startIndex,
@@ -12,12 +12,29 @@
 #include "mozilla/Maybe.h"
 #include "mozilla/MemoryReporting.h"
 
+#include "ds/LifoAlloc.h"
 #include "frontend/TokenStream.h"
 #include "irregexp/RegExpTypes.h"
+#include "jit/JitAllocPolicy.h"
+#include "js/UniquePtr.h"
+#include "vm/HelperThreadTask.h"
 #include "vm/JSContext.h"
 #include "vm/RegExpShared.h"
 
+namespace v8 {
+namespace internal {
+class RegExpTree;
+class SMRegExpMacroAssembler;
+class Zone;
+}  // namespace internal
+}  // namespace v8
+
 namespace js {
+
+namespace jit {
+class RegExpHeapMacroAssembler;
+}  // namespace jit
+
 namespace irregexp {
 
 Isolate* CreateIsolate(JSContext* cx);
@@ -37,10 +54,101 @@ bool CheckPatternSyntax(JSContext* cx, frontend::TokenStreamAnyChars& ts,
 bool CompilePattern(JSContext* cx, MutableHandleRegExpShared re,
                     HandleLinearString input, RegExpShared::CodeKind codeKind);
 
+// Compiling large patterns to native code takes long enough to be worth doing
+// on a helper thread. The pattern is parsed on the main thread, the code is
+// generated on a helper thread, and the code is linked on the main thread the
+// next time the regexp is executed after the task finishes. The regexp is
+// interpreted in the meantime.
+class RegExpCompileTask : public HelperThreadTask {
+ public:
+  enum class State { Pending, Running, Finished };
+
+ private:
+  JSRuntime* runtime_;
+
+  // The context the code will run on and its isolate. Only the addresses of
+  // their fields are used off thread.
+  //
+  // The task doesn't refer to the realm it was started from, because the
+  // RegExpShared belongs to the zone and is shared by all its realms. The
+  // realm may be destroyed while the task is pending or running, and another
+  // realm then links the code. The RegExpShared owns the task and cancels it
+  // when it is finalized, so the task can't outlive the zone.
+  JSContext* cx_;
+  Isolate* cxIsolate_;
+
+  // A permanent atom passed to the compiler in place of the pattern, which
+  // only uses it for tracing.
+  JSAtom* placeholderPattern_;
+
+  JS::RegExpFlags flags_;
+  bool isLatin1_;
+  uint32_t pairCount_;
+  uint32_t backtrackLimit_;
+  size_t patternLength_;
+
+  LifoAlloc alloc_;
+  jit::TempAllocator temp_;
+
+  // The parsed pattern, allocated in alloc_.
+  UniquePtr<v8::internal::Zone> zone_;
+  v8::internal::RegExpTree* tree_ = nullptr;
+  int captureCount_ = 0;
+
+  // The generated code, which is ready to link if succeeded_ is set.
+  UniquePtr<jit::RegExpHeapMacroAssembler> masm_;
+  UniquePtr<v8::internal::SMRegExpMacroAssembler> regexpMasm_;
+  uint32_t numRegisters_ = 0;
+  bool succeeded_ = false;
+
+  // Protected by the helper thread lock.
+  State state_ = State::Pending;
+  bool abandoned_ = false;
+
+  void runTask(JSContext* helperCx);
+
+ public:
+  RegExpCompileTask(JSContext* cx, RegExpShared* re, bool isLatin1);
+  ~RegExpCompileTask();
+
+  // Parse the pattern into this task's zone. Called on the main thread.
+  bool parse(JSContext* cx, HandleAtom pattern);
+
+  // Install the generated code in |re|, unless the compilation failed or is
+  // out of date. Returns false on OOM.
+  bool link(JSContext* cx, MutableHandleRegExpShared re);
+
+  bool runtimeMatches(JSRuntime* runtime) const { return runtime == runtime_; }
+  bool isLatin1() const { return isLatin1_; }
+
+  State state(const AutoLockHelperThreadState&) const { return state_; }
+  void setState(State state, const AutoLockHelperThreadState&) {
+    state_ = state;
+  }
+  void abandon(const AutoLockHelperThreadState&) { abandoned_ = true; }
+
+  void runHelperThreadTask(AutoLockHelperThreadState& locked) override;
+  ThreadType threadType() override { return THREAD_TYPE_REGEXP_COMPILE; }
+};
+
+// Whether native code for |re| should be compiled on a helper thread.
+bool ShouldCompileOffThread(JSContext* cx, RegExpShared* re);
+
+// Compile |re| to native code for |input| on a helper thread, or link the
+// code from a finished compilation. Compiles |re| to bytecode for |input| if
+// native code isn't ready yet.
+bool CompilePatternOffThread(JSContext* cx, MutableHandleRegExpShared re,
+                             HandleLinearString input);
+
 RegExpRunStatus Execute(JSContext* cx, MutableHandleRegExpShared re,
                         HandleLinearString input, size_t start,
                         VectorMatchPairs* matches);
 
+// Called when Execute returns RegExpRunStatus_Fallback. Switches |re| to the
+// linear-time engine, or if that isn't possible, discards its code so that it
+// is recompiled without a backtrack limit.
+void FallBackToLinearEngine(JSContext* cx, MutableHandleRegExpShared re);
+
 RegExpRunStatus ExecuteForFuzzing(JSContext* cx, HandleAtom pattern,
                                   HandleLinearString input,
                                   JS::RegExpFlags flags, size_t startIndex,
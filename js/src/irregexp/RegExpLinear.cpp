@@ -0,0 +1,753 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "irregexp/RegExpLinear.h"
+
+#include <algorithm>
+
+#include "irregexp/imported/regexp-ast.h"
+#include "irregexp/RegExpShim.h"
+#include "js/AllocPolicy.h"
+#include "vm/JSContext.h"
+#include "vm/MatchPairs.h"
+#include "vm/StringType.h"
+
+namespace js {
+namespace irregexp {
+
+using v8::internal::CharacterRange;
+using v8::internal::Interval;
+using v8::internal::RegExpAssertion;
+using v8::internal::RegExpAtom;
+using v8::internal::RegExpCapture;
+using v8::internal::RegExpCharacterClass;
+using v8::internal::RegExpQuantifier;
+using v8::internal::RegExpTree;
+using v8::internal::TextElement;
+using v8::internal::uc32;
+using v8::internal::Zone;
+using v8::internal::ZoneList;
+
+using Op = LinearProgram::Op;
+using Assertion = LinearProgram::Assertion;
+
+/*** Program length estimate ************************************************/
+
+static constexpr size_t TooLong = LinearProgram::MaxLength + 1;
+
+static size_t SaturatingAdd(size_t a, size_t b) {
+  return std::min(a + b, TooLong);
+}
+
+static size_t SaturatingMul(size_t a, size_t b) {
+  MOZ_ASSERT(b <= TooLong);
+  if (a == 0 || b == 0) {
+    return 0;
+  }
+  if (a > TooLong / b) {
+    return TooLong;
+  }
+  return std::min(a * b, TooLong);
+}
+
+// Returns the number of instructions LinearCompiler emits for |tree|, or
+// TooLong if the program would be too long or |tree| uses a feature the
+// linear-time engine doesn't support. The result is an upper bound: empty
+// quantifier bodies are counted as one instruction, so that repeating them
+// a huge number of times is rejected here instead of looping in the
+// compiler.
+static size_t ProgramLength(RegExpTree* tree) {
+  if (tree->IsDisjunction()) {
+    ZoneList<RegExpTree*>* alternatives = tree->AsDisjunction()->alternatives();
+    size_t length = 2 * (alternatives->length() - 1);
+    for (int i = 0; i < alternatives->length(); i++) {
+      length = SaturatingAdd(length, ProgramLength(alternatives->at(i)));
+    }
+    return length;
+  }
+  if (tree->IsAlternative()) {
+    ZoneList<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    size_t length = 0;
+    for (int i = 0; i < nodes->length(); i++) {
+      length = SaturatingAdd(length, ProgramLength(nodes->at(i)));
+    }
+    return length;
+  }
+  if (tree->IsAtom()) {
+    return std::min(size_t(tree->AsAtom()->length()), TooLong);
+  }
+  if (tree->IsText()) {
+    ZoneList<TextElement>* elements = tree->AsText()->elements();
+    size_t length = 0;
+    for (int i = 0; i < elements->length(); i++) {
+      length = SaturatingAdd(length, size_t(elements->at(i).length()));
+    }
+    return length;
+  }
+  if (tree->IsCharacterClass() || tree->IsAssertion()) {
+    return 1;
+  }
+  if (tree->IsEmpty()) {
+    return 0;
+  }
+  if (tree->IsCapture()) {
+    return SaturatingAdd(ProgramLength(tree->AsCapture()->body()), 2);
+  }
+  if (tree->IsGroup()) {
+    return ProgramLength(tree->AsGroup()->body());
+  }
+  if (tree->IsQuantifier()) {
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    if (quantifier->is_possessive()) {
+      return TooLong;
+    }
+
+    // Optional iterations that can match the empty string need the
+    // empty-check from RepeatMatcher, which the Pike VM doesn't implement.
+    RegExpTree* body = quantifier->body();
+    size_t min = size_t(quantifier->min());
+    size_t max = size_t(quantifier->max());
+    if (max > min && body->min_match() == 0) {
+      return TooLong;
+    }
+
+    size_t iteration = std::max(ProgramLength(body), size_t(1));
+    if (!quantifier->CaptureRegisters().is_empty()) {
+      iteration = SaturatingAdd(iteration, 1);
+    }
+    size_t length = SaturatingMul(min, iteration);
+    if (quantifier->max() == RegExpTree::kInfinity) {
+      return SaturatingAdd(length, SaturatingAdd(iteration, 2));
+    }
+    return SaturatingAdd(
+        length, SaturatingMul(max - min, SaturatingAdd(iteration, 1)));
+  }
+
+  // Lookarounds and back references.
+  return TooLong;
+}
+
+bool CanUseLinearEngine(RegExpTree* tree, JS::RegExpFlags flags) {
+  // Surrogate pairs and unicode case folding aren't supported.
+  if (flags.unicode()) {
+    return false;
+  }
+  // Add Save instructions for the whole match and the final Match.
+  return SaturatingAdd(ProgramLength(tree), 3) <= LinearProgram::MaxLength;
+}
+
+/*** Compiler ***************************************************************/
+
+class LinearCompiler {
+  Isolate* isolate_;
+  Zone* zone_;
+  JS::RegExpFlags flags_;
+  LinearProgram* program_;
+
+  uint32_t pc() const { return program_->insns_.length(); }
+
+  [[nodiscard]] bool emit(Op op, uint32_t arg = 0, uint32_t arg2 = 0) {
+    return program_->insns_.append(LinearProgram::Insn{op, arg, arg2});
+  }
+
+  void patchSplit(uint32_t split, uint32_t preferred, uint32_t other) {
+    LinearProgram::Insn& insn = program_->insns_[split];
+    MOZ_ASSERT(insn.op == Op::Split);
+    insn.arg = preferred;
+    insn.arg2 = other;
+  }
+
+  [[nodiscard]] bool emitRanges(ZoneList<CharacterRange>* ranges,
+                                bool negated);
+  [[nodiscard]] bool emitChar(char16_t c);
+  [[nodiscard]] bool emitCharacterClass(RegExpCharacterClass* cc);
+  [[nodiscard]] bool emitAssertion(RegExpAssertion* assertion);
+  [[nodiscard]] bool emitDisjunction(ZoneList<RegExpTree*>* alternatives);
+  [[nodiscard]] bool emitQuantifier(RegExpQuantifier* quantifier);
+
+ public:
+  LinearCompiler(Isolate* isolate, Zone* zone, JS::RegExpFlags flags,
+                 LinearProgram* program)
+      : isolate_(isolate), zone_(zone), flags_(flags), program_(program) {}
+
+  [[nodiscard]] bool compile(RegExpTree* tree);
+  [[nodiscard]] bool compileTopLevel(RegExpTree* tree, uint32_t pairCount);
+};
+
+// |ranges| must be canonical.
+bool LinearCompiler::emitRanges(ZoneList<CharacterRange>* ranges,
+                                bool negated) {
+  // Without the unicode flag the input is matched code unit by code unit, so
+  // anything above the BMP can't match.
+  uint32_t firstRange = program_->ranges_.length();
+  for (int i = 0; i < ranges->length(); i++) {
+    CharacterRange range = ranges->at(i);
+    if (range.from() > 0xFFFF) {
+      break;
+    }
+    char16_t to = char16_t(std::min(range.to(), uc32(0xFFFF)));
+    if (!program_->ranges_.append(
+            LinearProgram::CharRange{char16_t(range.from()), to})) {
+      return false;
+    }
+  }
+  uint32_t rangeCount = program_->ranges_.length() - firstRange;
+
+  if (!negated && rangeCount == 1) {
+    LinearProgram::CharRange range = program_->ranges_.popCopy();
+    if (range.from == range.to) {
+      return emit(Op::Char, range.from);
+    }
+    if (range.from == 0 && range.to == 0xFFFF) {
+      return emit(Op::Any);
+    }
+    program_->ranges_.infallibleAppend(range);
+  }
+
+  uint32_t classIndex = program_->classes_.length();
+  if (!program_->classes_.append(
+          LinearProgram::CharClass{firstRange, rangeCount, negated})) {
+    return false;
+  }
+  return emit(Op::Class, classIndex);
+}
+
+bool LinearCompiler::emitChar(char16_t c) {
+  if (!flags_.ignoreCase()) {
+    return emit(Op::Char, c);
+  }
+  ZoneList<CharacterRange>* ranges =
+      CharacterRange::List(zone_, CharacterRange::Singleton(c));
+  CharacterRange::AddCaseEquivalents(isolate_, zone_, ranges,
+                                     /* is_one_byte = */ false);
+  CharacterRange::Canonicalize(ranges);
+  return emitRanges(ranges, /* negated = */ false);
+}
+
+bool LinearCompiler::emitCharacterClass(RegExpCharacterClass* cc) {
+  // This matches TextNode::MakeCaseIndependent: the standard classes are
+  // already closed under case folding.
+  ZoneList<CharacterRange>* ranges = cc->ranges(zone_);
+  if (flags_.ignoreCase() && !cc->is_standard(zone_)) {
+    CharacterRange::AddCaseEquivalents(isolate_, zone_, ranges,
+                                       /* is_one_byte = */ false);
+  }
+  CharacterRange::Canonicalize(ranges);
+  return emitRanges(ranges, cc->is_negated());
+}
+
+bool LinearCompiler::emitAssertion(RegExpAssertion* assertion) {
+  Assertion kind;
+  switch (assertion->assertion_type()) {
+    case RegExpAssertion::START_OF_INPUT:
+      kind = Assertion::StartOfInput;
+      break;
+    case RegExpAssertion::END_OF_INPUT:
+      kind = Assertion::EndOfInput;
+      break;
+    case RegExpAssertion::START_OF_LINE:
+      kind = Assertion::StartOfLine;
+      break;
+    case RegExpAssertion::END_OF_LINE:
+      kind = Assertion::EndOfLine;
+      break;
+    case RegExpAssertion::BOUNDARY:
+      kind = Assertion::Boundary;
+      break;
+    case RegExpAssertion::NON_BOUNDARY:
+      kind = Assertion::NonBoundary;
+      break;
+    default:
+      MOZ_CRASH("Unexpected assertion type");
+  }
+  return emit(Op::Assert, uint32_t(kind));
+}
+
+bool LinearCompiler::emitDisjunction(ZoneList<RegExpTree*>* alternatives) {
+  //      split L1, L2
+  //  L1: <alternative 1>
+  //      jump end
+  //  L2: split L3, L4
+  //      ...
+  //  Ln: <alternative n>
+  // end:
+  Vector<uint32_t, 8, SystemAllocPolicy> jumps;
+  int last = alternatives->length() - 1;
+  for (int i = 0; i < last; i++) {
+    uint32_t split = pc();
+    if (!emit(Op::Split) || !compile(alternatives->at(i))) {
+      return false;
+    }
+    if (!jumps.append(pc()) || !emit(Op::Jump)) {
+      return false;
+    }
+    patchSplit(split, split + 1, pc());
+  }
+  if (!compile(alternatives->at(last))) {
+    return false;
+  }
+  for (uint32_t jump : jumps) {
+    program_->insns_[jump].arg = pc();
+  }
+  return true;
+}
+
+bool LinearCompiler::emitQuantifier(RegExpQuantifier* quantifier) {
+  RegExpTree* body = quantifier->body();
+  bool greedy = quantifier->is_greedy();
+  MOZ_ASSERT(!quantifier->is_possessive());
+
+  // Captures inside the body are reset at the start of every iteration.
+  Interval captures = quantifier->CaptureRegisters();
+  auto emitIteration = [&]() {
+    if (!captures.is_empty() &&
+        !emit(Op::ClearRegisters, captures.from(), captures.to())) {
+      return false;
+    }
+    return compile(body);
+  };
+
+  int min = quantifier->min();
+  int max = quantifier->max();
+  for (int i = 0; i < min; i++) {
+    if (!emitIteration()) {
+      return false;
+    }
+  }
+
+  if (max == RegExpTree::kInfinity) {
+    // loop: split body, end
+    // body: <iteration>
+    //       jump loop
+    //  end:
+    uint32_t loop = pc();
+    if (!emit(Op::Split) || !emitIteration() || !emit(Op::Jump, loop)) {
+      return false;
+    }
+    uint32_t end = pc();
+    if (greedy) {
+      patchSplit(loop, loop + 1, end);
+    } else {
+      patchSplit(loop, end, loop + 1);
+    }
+    return true;
+  }
+
+  // Each optional iteration is guarded by a split that can skip all of the
+  // remaining iterations.
+  Vector<uint32_t, 8, SystemAllocPolicy> splits;
+  for (int i = min; i < max; i++) {
+    if (!splits.append(pc()) || !emit(Op::Split) || !emitIteration()) {
+      return false;
+    }
+  }
+  uint32_t end = pc();
+  for (uint32_t split : splits) {
+    if (greedy) {
+      patchSplit(split, split + 1, end);
+    } else {
+      patchSplit(split, end, split + 1);
+    }
+  }
+  return true;
+}
+
+bool LinearCompiler::compile(RegExpTree* tree) {
+  if (tree->IsDisjunction()) {
+    return emitDisjunction(tree->AsDisjunction()->alternatives());
+  }
+  if (tree->IsAlternative()) {
+    ZoneList<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (int i = 0; i < nodes->length(); i++) {
+      if (!compile(nodes->at(i))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsAtom()) {
+    RegExpAtom* atom = tree->AsAtom();
+    for (int i = 0; i < atom->length(); i++) {
+      if (!emitChar(atom->data()[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsText()) {
+    ZoneList<TextElement>* elements = tree->AsText()->elements();
+    for (int i = 0; i < elements->length(); i++) {
+      TextElement element = elements->at(i);
+      bool ok = element.text_type() == TextElement::ATOM
+                    ? compile(element.atom())
+                    : emitCharacterClass(element.char_class());
+      if (!ok) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (tree->IsCharacterClass()) {
+    return emitCharacterClass(tree->AsCharacterClass());
+  }
+  if (tree->IsAssertion()) {
+    return emitAssertion(tree->AsAssertion());
+  }
+  if (tree->IsEmpty()) {
+    return true;
+  }
+  if (tree->IsCapture()) {
+    RegExpCapture* capture = tree->AsCapture();
+    return emit(Op::Save, RegExpCapture::StartRegister(capture->index())) &&
+           compile(capture->body()) &&
+           emit(Op::Save, RegExpCapture::EndRegister(capture->index()));
+  }
+  if (tree->IsGroup()) {
+    return compile(tree->AsGroup()->body());
+  }
+  if (tree->IsQuantifier()) {
+    return emitQuantifier(tree->AsQuantifier());
+  }
+  MOZ_CRASH("Unsupported node for the linear-time engine");
+}
+
+bool LinearCompiler::compileTopLevel(RegExpTree* tree, uint32_t pairCount) {
+  program_->pairCount_ = pairCount;
+  program_->sticky_ = flags_.sticky();
+  program_->anchoredAtStart_ = tree->IsAnchoredAtStart();
+  return emit(Op::Save, 0) && compile(tree) && emit(Op::Save, 1) &&
+         emit(Op::Match);
+}
+
+LinearProgram* CompileLinearProgram(Isolate* isolate, Zone* zone,
+                                    RegExpTree* tree, uint32_t pairCount,
+                                    JS::RegExpFlags flags) {
+  MOZ_ASSERT(CanUseLinearEngine(tree, flags));
+
+  UniquePtr<LinearProgram> program(js_new<LinearProgram>());
+  if (!program) {
+    return nullptr;
+  }
+
+  LinearCompiler compiler(isolate, zone, flags, program.get());
+  if (!compiler.compileTopLevel(tree, pairCount)) {
+    return nullptr;
+  }
+  if (program->length() > LinearProgram::MaxLength) {
+    return nullptr;
+  }
+  if (!program->allocateMatchState()) {
+    return nullptr;
+  }
+  return program.release();
+}
+
+/*** Matcher ****************************************************************/
+
+bool LinearProgram::allocateMatchState() {
+  // Threads only stop at consuming instructions and at Match, and at most one
+  // thread per instruction is added at each input position. The epsilon
+  // closure pushes at most one job for each Split and Save it visits, and one
+  // for each register a ClearRegisters resets, plus the job it starts with.
+  size_t maxThreads = 0;
+  size_t maxJobs = 1;
+  for (const Insn& insn : insns_) {
+    switch (insn.op) {
+      case Op::Char:
+      case Op::Class:
+      case Op::Any:
+      case Op::Match:
+        maxThreads++;
+        break;
+      case Op::Split:
+      case Op::Save:
+        maxJobs++;
+        break;
+      case Op::ClearRegisters:
+        maxJobs += insn.arg2 - insn.arg + 1;
+        break;
+      case Op::Jump:
+      case Op::Assert:
+        break;
+    }
+  }
+
+  // Both factors are bounded by MaxLength and the number of capture
+  // registers, so this can't overflow.
+  size_t maxRegisters = maxThreads * registerCount();
+  if (maxRegisters > MaxMatchStateLength || maxJobs > MaxMatchStateLength) {
+    return false;
+  }
+
+  return threads1_.pcs.reserve(maxThreads) &&
+         threads1_.registers.reserve(maxRegisters) &&
+         threads2_.pcs.reserve(maxThreads) &&
+         threads2_.registers.reserve(maxRegisters) &&
+         jobs_.reserve(maxJobs) &&
+         scratch_.appendN(MatchPair::NoMatch, registerCount()) &&
+         best_.appendN(MatchPair::NoMatch, registerCount()) &&
+         visited_.appendN(0, length());
+}
+
+bool LinearProgram::classContains(const CharClass& cls, char16_t c) const {
+  // Binary search for the first range that ends at or after |c|.
+  const CharRange* begin = ranges_.begin() + cls.firstRange;
+  const CharRange* end = begin + cls.rangeCount;
+  const CharRange* range = std::lower_bound(
+      begin, end, c,
+      [](const CharRange& range, char16_t c) { return range.to < c; });
+  bool found = range != end && range->from <= c;
+  return found != cls.negated;
+}
+
+static bool IsLineTerminator(char16_t c) {
+  return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+}
+
+static bool IsWordChar(char16_t c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_';
+}
+
+// Runs a LinearProgram, using the buffers allocated by allocateMatchState.
+template <typename CharT>
+class LinearMatcher {
+  using ThreadList = LinearProgram::ThreadList;
+  using Job = LinearProgram::Job;
+
+  // Check for interrupts every this many input positions.
+  static constexpr size_t InterruptCheckInterval = 1 << 16;
+
+  JSContext* cx_;
+  LinearProgram& program_;
+  const CharT* chars_;
+  size_t length_;
+  size_t registerCount_;
+
+  bool checkAssertion(Assertion assertion, size_t pos) const;
+  bool consumes(const LinearProgram::Insn& insn, size_t pos) const;
+  void nextGeneration();
+  void addThread(ThreadList& list, uint32_t startPc, size_t pos);
+
+ public:
+  LinearMatcher(JSContext* cx, LinearProgram& program, const CharT* chars,
+                size_t length)
+      : cx_(cx),
+        program_(program),
+        chars_(chars),
+        length_(length),
+        registerCount_(program.registerCount()) {}
+
+  RegExpRunStatus run(size_t startIndex, MatchPairs* matches);
+};
+
+template <typename CharT>
+bool LinearMatcher<CharT>::checkAssertion(Assertion assertion,
+                                          size_t pos) const {
+  switch (assertion) {
+    case Assertion::StartOfInput:
+      return pos == 0;
+    case Assertion::EndOfInput:
+      return pos == length_;
+    case Assertion::StartOfLine:
+      return pos == 0 || IsLineTerminator(chars_[pos - 1]);
+    case Assertion::EndOfLine:
+      return pos == length_ || IsLineTerminator(chars_[pos]);
+    case Assertion::Boundary:
+    case Assertion::NonBoundary: {
+      bool before = pos > 0 && IsWordChar(chars_[pos - 1]);
+      bool after = pos < length_ && IsWordChar(chars_[pos]);
+      return (before != after) == (assertion == Assertion::Boundary);
+    }
+  }
+  MOZ_CRASH("Unexpected assertion");
+}
+
+template <typename CharT>
+bool LinearMatcher<CharT>::consumes(const LinearProgram::Insn& insn,
+                                    size_t pos) const {
+  if (pos == length_) {
+    return false;
+  }
+  char16_t c = chars_[pos];
+  switch (insn.op) {
+    case Op::Char:
+      return c == insn.arg;
+    case Op::Class:
+      return program_.classContains(program_.classes_[insn.arg], c);
+    case Op::Any:
+      return true;
+    default:
+      MOZ_CRASH("Not a consuming instruction");
+  }
+}
+
+// Start a new input position: every instruction becomes unvisited.
+template <typename CharT>
+void LinearMatcher<CharT>::nextGeneration() {
+  if (++program_.generation_ == 0) {
+    std::fill(program_.visited_.begin(), program_.visited_.end(), 0);
+    program_.generation_ = 1;
+  }
+}
+
+// Add the threads reachable from |startPc| without consuming input to |list|,
+// in priority order. The registers of the thread being added are in the
+// program's |scratch_|, and are unchanged when this returns. The buffers are
+// large enough for the whole closure, see allocateMatchState.
+template <typename CharT>
+void LinearMatcher<CharT>::addThread(ThreadList& list, uint32_t startPc,
+                                     size_t pos) {
+  auto& jobs = program_.jobs_;
+  auto& scratch = program_.scratch_;
+  auto& visited = program_.visited_;
+  uint32_t generation = program_.generation_;
+
+  MOZ_ASSERT(jobs.empty());
+  jobs.infallibleAppend(Job{startPc, 0, false});
+
+  while (!jobs.empty()) {
+    Job job = jobs.popCopy();
+    if (job.restore) {
+      scratch[job.pcOrReg] = job.value;
+      continue;
+    }
+
+    uint32_t pc = job.pcOrReg;
+    while (visited[pc] != generation) {
+      visited[pc] = generation;
+      const LinearProgram::Insn& insn = program_.insns_[pc];
+
+      if (insn.op == Op::Char || insn.op == Op::Class || insn.op == Op::Any ||
+          insn.op == Op::Match) {
+        list.pcs.infallibleAppend(pc);
+        list.registers.infallibleAppend(scratch.begin(), registerCount_);
+        break;
+      }
+
+      if (insn.op == Op::Split) {
+        jobs.infallibleAppend(Job{insn.arg2, 0, false});
+        pc = insn.arg;
+      } else if (insn.op == Op::Jump) {
+        pc = insn.arg;
+      } else if (insn.op == Op::Save) {
+        jobs.infallibleAppend(Job{insn.arg, scratch[insn.arg], true});
+        scratch[insn.arg] = int32_t(pos);
+        pc++;
+      } else if (insn.op == Op::ClearRegisters) {
+        for (uint32_t reg = insn.arg; reg <= insn.arg2; reg++) {
+          jobs.infallibleAppend(Job{reg, scratch[reg], true});
+          scratch[reg] = MatchPair::NoMatch;
+        }
+        pc++;
+      } else {
+        MOZ_ASSERT(insn.op == Op::Assert);
+        if (!checkAssertion(Assertion(insn.arg), pos)) {
+          break;
+        }
+        pc++;
+      }
+    }
+  }
+}
+
+template <typename CharT>
+RegExpRunStatus LinearMatcher<CharT>::run(size_t startIndex,
+                                          MatchPairs* matches) {
+  int32_t* scratch = program_.scratch_.begin();
+  int32_t* best = program_.best_.begin();
+
+  // Sticky and anchored patterns only start a thread at |startIndex|.
+  // Otherwise a new thread is started at each position, with the lowest
+  // priority, until a match is found.
+  bool startEverywhere = !program_.sticky_ && !program_.anchoredAtStart_;
+  bool matched = false;
+
+  ThreadList* current = &program_.threads1_;
+  ThreadList* next = &program_.threads2_;
+  current->pcs.clear();
+  current->registers.clear();
+
+  std::fill_n(scratch, registerCount_, MatchPair::NoMatch);
+  nextGeneration();
+  addThread(*current, 0, startIndex);
+
+  for (size_t pos = startIndex;; pos++) {
+    if ((pos - startIndex) % InterruptCheckInterval == 0 &&
+        cx_->hasPendingInterrupt(InterruptReason::CallbackUrgent)) {
+      return RegExpRunStatus_Error;
+    }
+
+    nextGeneration();
+    next->pcs.clear();
+    next->registers.clear();
+
+    for (size_t i = 0; i < current->length(); i++) {
+      const LinearProgram::Insn& insn = program_.insns_[current->pcs[i]];
+      int32_t* registers = current->registersOf(i, registerCount_);
+      if (insn.op == Op::Match) {
+        // Threads with lower priority than this one are cut off.
+        std::copy_n(registers, registerCount_, best);
+        matched = true;
+        break;
+      }
+      if (consumes(insn, pos)) {
+        std::copy_n(registers, registerCount_, scratch);
+        addThread(*next, current->pcs[i] + 1, pos + 1);
+      }
+    }
+
+    if (pos == length_) {
+      break;
+    }
+
+    if (!matched && startEverywhere) {
+      std::fill_n(scratch, registerCount_, MatchPair::NoMatch);
+      addThread(*next, 0, pos + 1);
+    }
+
+    if (next->length() == 0) {
+      break;
+    }
+    std::swap(current, next);
+  }
+
+  if (!matched) {
+    return RegExpRunStatus_Success_NotFound;
+  }
+
+  for (size_t i = 0; i < program_.pairCount_; i++) {
+    int32_t start = best[i * 2];
+    int32_t limit = best[i * 2 + 1];
+    if (start < 0 || limit < 0) {
+      (*matches)[i] = MatchPair();
+    } else {
+      (*matches)[i] = MatchPair(start, limit);
+    }
+  }
+  matches->checkAgainst(length_);
+  return RegExpRunStatus_Success;
+}
+
+RegExpRunStatus ExecuteLinear(JSContext* cx, LinearProgram* program,
+                              HandleLinearString input, size_t startIndex,
+                              MatchPairs* matches) {
+  MOZ_ASSERT(startIndex <= input->length());
+  MOZ_ASSERT(matches->length() >= program->pairCount());
+
+  JS::AutoCheckCannotGC nogc;
+  if (input->hasLatin1Chars()) {
+    LinearMatcher<Latin1Char> matcher(cx, *program, input->latin1Chars(nogc),
+                                      input->length());
+    return matcher.run(startIndex, matches);
+  }
+  LinearMatcher<char16_t> matcher(cx, *program, input->twoByteChars(nogc),
+                                  input->length());
+  return matcher.run(startIndex, matches);
+}
+
+}  // namespace irregexp
+}  // namespace js
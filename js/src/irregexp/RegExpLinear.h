@@ -0,0 +1,216 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+/*
+ * A linear-time regexp engine, used when the backtracking engine gives up.
+ *
+ * Irregexp is a backtracking engine, so some patterns take exponential time
+ * on inputs that almost match, e.g. /(a+)+b/ on "aaaaaaaaaaaaaaaaaaaaaaaa".
+ * For patterns without backreferences or lookaround, the match can instead be
+ * computed by a Pike VM: the pattern is compiled to a small NFA program, and
+ * all paths through it are simulated in lockstep over the input, keeping at
+ * most one thread per program counter. Threads are kept in priority order, so
+ * the result is the same as the one the backtracking engine would find, and
+ * matching takes O(program length * input length) time.
+ *
+ * Irregexp is compiled with a backtrack limit for patterns this engine
+ * supports. When the limit is hit, RegExpShared switches to the linear-time
+ * engine for good and reruns the match.
+ */
+
+#ifndef regexp_RegExpLinear_h
+#define regexp_RegExpLinear_h
+
+#include "mozilla/MemoryReporting.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "js/AllocPolicy.h"
+#include "js/RegExpFlags.h"
+#include "js/Vector.h"
+#include "vm/RegExpShared.h"
+
+namespace v8 {
+namespace internal {
+class RegExpTree;
+class Zone;
+}  // namespace internal
+}  // namespace v8
+
+namespace js {
+
+class MatchPairs;
+
+namespace irregexp {
+
+class LinearProgram {
+ public:
+  enum class Op : uint8_t {
+    // Consume the code unit |arg|.
+    Char,
+    // Consume a code unit in the character class |arg|.
+    Class,
+    // Consume any code unit.
+    Any,
+    // Continue at |arg|, and with lower priority at |arg2|.
+    Split,
+    // Continue at |arg|.
+    Jump,
+    // Store the current position in capture register |arg|.
+    Save,
+    // Reset capture registers |arg| to |arg2| inclusive.
+    ClearRegisters,
+    // Check the Assertion |arg| at the current position.
+    Assert,
+    // Report a match.
+    Match,
+  };
+
+  enum class Assertion : uint32_t {
+    StartOfInput,
+    EndOfInput,
+    StartOfLine,
+    EndOfLine,
+    Boundary,
+    NonBoundary,
+  };
+
+  struct Insn {
+    Op op;
+    uint32_t arg;
+    uint32_t arg2;
+  };
+
+  struct CharRange {
+    char16_t from;
+    char16_t to;
+  };
+
+  // A character class is a sorted list of disjoint ranges.
+  struct CharClass {
+    uint32_t firstRange;
+    uint32_t rangeCount;
+    bool negated;
+  };
+
+  // Programs longer than this are not supported, so that counted repetition
+  // of large subpatterns can't make matching arbitrarily expensive.
+  static constexpr size_t MaxLength = 10000;
+
+  // Programs whose matcher state would need more entries than this in one of
+  // its buffers are not supported either.
+  static constexpr size_t MaxMatchStateLength = 1 << 20;
+
+ private:
+  friend class LinearCompiler;
+  template <typename CharT>
+  friend class LinearMatcher;
+
+  Vector<Insn, 0, SystemAllocPolicy> insns_;
+  Vector<CharClass, 0, SystemAllocPolicy> classes_;
+  Vector<CharRange, 0, SystemAllocPolicy> ranges_;
+
+  uint32_t pairCount_ = 0;
+  bool sticky_ = false;
+  bool anchoredAtStart_ = false;
+
+  // A list of threads in priority order. Each thread is stopped at a
+  // consuming instruction or at Match, and has its own copy of the capture
+  // registers.
+  struct ThreadList {
+    Vector<uint32_t, 0, SystemAllocPolicy> pcs;
+    Vector<int32_t, 0, SystemAllocPolicy> registers;
+
+    size_t length() const { return pcs.length(); }
+    int32_t* registersOf(size_t thread, size_t registerCount) {
+      return registers.begin() + thread * registerCount;
+    }
+  };
+
+  // Work item for the epsilon closure: either explore from |pcOrReg|, or
+  // restore capture register |pcOrReg| to |value| when backing out of a Save.
+  struct Job {
+    uint32_t pcOrReg;
+    int32_t value;
+    bool restore;
+  };
+
+  // The matcher's state. The buffers are allocated with their maximum size
+  // when the program is compiled and reused by every match, so that matching
+  // doesn't allocate. Matching never runs JS, so a program is only ever used
+  // by one match at a time.
+  ThreadList threads1_;
+  ThreadList threads2_;
+  Vector<Job, 0, SystemAllocPolicy> jobs_;
+  Vector<int32_t, 0, SystemAllocPolicy> scratch_;
+  Vector<int32_t, 0, SystemAllocPolicy> best_;
+
+  // visited_[pc] == generation_ if |pc| has already been reached at the
+  // current input position. A lower priority thread reaching the same
+  // instruction at the same position can never win, so it is dropped.
+  Vector<uint32_t, 0, SystemAllocPolicy> visited_;
+  uint32_t generation_ = 0;
+
+  bool classContains(const CharClass& cls, char16_t c) const;
+
+ public:
+  size_t length() const { return insns_.length(); }
+  uint32_t pairCount() const { return pairCount_; }
+  size_t registerCount() const { return size_t(pairCount_) * 2; }
+
+  // Allocate the matcher's state. Returns false on OOM, or if the state would
+  // be too large, without reporting an error.
+  [[nodiscard]] bool allocateMatchState();
+
+  size_t sizeOfIncludingThis(mozilla::MallocSizeOf mallocSizeOf) const {
+    return mallocSizeOf(this) + insns_.sizeOfExcludingThis(mallocSizeOf) +
+           classes_.sizeOfExcludingThis(mallocSizeOf) +
+           ranges_.sizeOfExcludingThis(mallocSizeOf) +
+           threads1_.pcs.sizeOfExcludingThis(mallocSizeOf) +
+           threads1_.registers.sizeOfExcludingThis(mallocSizeOf) +
+           threads2_.pcs.sizeOfExcludingThis(mallocSizeOf) +
+           threads2_.registers.sizeOfExcludingThis(mallocSizeOf) +
+           jobs_.sizeOfExcludingThis(mallocSizeOf) +
+           scratch_.sizeOfExcludingThis(mallocSizeOf) +
+           best_.sizeOfExcludingThis(mallocSizeOf) +
+           visited_.sizeOfExcludingThis(mallocSizeOf);
+  }
+
+  // The number of bytes allocated for this program, for memory accounting.
+  // This doesn't change once the program has been compiled.
+  size_t allocatedBytes() const {
+    return sizeof(*this) + insns_.capacity() * sizeof(Insn) +
+           classes_.capacity() * sizeof(CharClass) +
+           ranges_.capacity() * sizeof(CharRange) +
+           (threads1_.pcs.capacity() + threads2_.pcs.capacity() +
+            visited_.capacity()) *
+               sizeof(uint32_t) +
+           (threads1_.registers.capacity() + threads2_.registers.capacity() +
+            scratch_.capacity() + best_.capacity()) *
+               sizeof(int32_t) +
+           jobs_.capacity() * sizeof(Job);
+  }
+};
+
+// Whether the linear-time engine supports the parsed pattern |tree|.
+bool CanUseLinearEngine(v8::internal::RegExpTree* tree, JS::RegExpFlags flags);
+
+// Compile |tree|, which must be supported by the linear-time engine. Returns
+// nullptr on OOM, or if the program is too large after all, without reporting
+// an error.
+LinearProgram* CompileLinearProgram(Isolate* isolate, v8::internal::Zone* zone,
+                                    v8::internal::RegExpTree* tree,
+                                    uint32_t pairCount, JS::RegExpFlags flags);
+
+RegExpRunStatus ExecuteLinear(JSContext* cx, LinearProgram* program,
+                              HandleLinearString input, size_t startIndex,
+                              MatchPairs* matches);
+
+}  // namespace irregexp
+}  // namespace js
+
+#endif  // regexp_RegExpLinear_h
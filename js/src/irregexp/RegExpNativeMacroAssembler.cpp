@@ -39,15 +39,18 @@ using js::jit::Linker;
 using js::jit::LiveGeneralRegisterSet;
 using js::jit::Register;
 using js::jit::Registers;
-using js::jit::StackMacroAssembler;
 
 SMRegExpMacroAssembler::SMRegExpMacroAssembler(JSContext* cx,
-                                               StackMacroAssembler& masm,
+                                               Isolate* cxIsolate,
+                                               Isolate* isolate,
+                                               js::jit::MacroAssembler& masm,
                                                Zone* zone, Mode mode,
                                                uint32_t num_capture_registers)
-    : NativeRegExpMacroAssembler(cx->isolate.ref(), zone),
+    : NativeRegExpMacroAssembler(isolate, zone),
       cx_(cx),
+      cxIsolate_(cxIsolate),
       masm_(masm),
+      deferLinking_(isolate != cxIsolate),
       mode_(mode),
       num_registers_(num_capture_registers),
       num_capture_registers_(num_capture_registers) {
@@ -91,7 +94,7 @@ void SMRegExpMacroAssembler::Backtrack() {
   js::jit::Label bailOut;
   // Check for simulating interrupt
   masm_.branch32(Assembler::NotEqual,
-                 AbsoluteAddress(&cx_->isolate->shouldSimulateInterrupt_),
+                 AbsoluteAddress(&cxIsolate_->shouldSimulateInterrupt_),
                  Imm32(0), &bailOut);
 #endif
   // Check for an interrupt. We have to restart from the beginning if we
@@ -108,6 +111,22 @@ void SMRegExpMacroAssembler::Backtrack() {
   masm_.jump(&exit_label_);
   masm_.bind(&noInterrupt);
 
+  if (has_backtrack_limit()) {
+    // If we have backtracked too many times, give up. The match is rerun
+    // with the linear-time engine if possible, see RegExpLinear.h.
+    js::jit::Label belowLimit;
+    masm_.add32(Imm32(1), backtrackCount());
+    masm_.branch32(Assembler::NotEqual, backtrackCount(),
+                   Imm32(backtrack_limit()), &belowLimit);
+    if (can_fallback()) {
+      masm_.movePtr(ImmWord(js::RegExpRunStatus_Fallback), temp0_);
+      masm_.jump(&exit_label_);
+    } else {
+      Fail();
+    }
+    masm_.bind(&belowLimit);
+  }
+
   // Pop code location from backtrack stack and jump to location.
   Pop(temp0_);
   masm_.jump(temp0_);
@@ -815,7 +834,7 @@ void SMRegExpMacroAssembler::CheckBacktrackStackLimit() {
   js::jit::Label no_stack_overflow;
   masm_.branchPtr(
       Assembler::BelowOrEqual,
-      AbsoluteAddress(isolate()->regexp_stack()->limit_address_address()),
+      AbsoluteAddress(cxIsolate_->regexp_stack()->limit_address_address()),
       backtrack_stack_pointer_, &no_stack_overflow);
 
   masm_.call(&stack_overflow_label_);
@@ -835,7 +854,7 @@ static Handle<HeapObject> DummyCode() {
 // Finalize code. This is called last, so that we know how many
 // registers we need.
 Handle<HeapObject> SMRegExpMacroAssembler::GetCode(Handle<String> source) {
-  if (!cx_->realm()->ensureJitRealmExists(cx_)) {
+  if (!deferLinking_ && !cx_->realm()->ensureJitRealmExists(cx_)) {
     return DummyCode();
   }
 
@@ -851,19 +870,36 @@ Handle<HeapObject> SMRegExpMacroAssembler::GetCode(Handle<String> source) {
   backtrackHandler();
   stackOverflowHandler();
 
-  Linker linker(masm_);
-  JitCode* code = linker.newCode(cx_, js::jit::CodeKind::RegExp);
+  if (deferLinking_) {
+    // The caller links the code on cx_'s thread. Return anything other than
+    // undefined, which means OOM.
+    return Handle<HeapObject>::fromHandleValue(JS::TrueHandleValue);
+  }
+
+  JitCode* code = Link(cx_);
   if (!code) {
     return DummyCode();
   }
 
+  return Handle<HeapObject>(JS::PrivateGCThingValue(code), isolate());
+}
+
+JitCode* SMRegExpMacroAssembler::Link(JSContext* cx) {
+  MOZ_ASSERT(cx == cx_);
+
+  Linker linker(masm_);
+  JitCode* code = linker.newCode(cx, js::jit::CodeKind::RegExp);
+  if (!code) {
+    return nullptr;
+  }
+
   for (LabelPatch& lp : labelPatches_) {
     Assembler::PatchDataWithValueCheck(CodeLocationLabel(code, lp.patchOffset_),
                                        ImmPtr(code->raw() + lp.labelOffset_),
                                        ImmPtr(nullptr));
   }
 
-  return Handle<HeapObject>(JS::PrivateGCThingValue(code), isolate());
+  return code;
 }
 
 /*
@@ -873,6 +909,7 @@ Handle<HeapObject> SMRegExpMacroAssembler::GetCode(Handle<String> source) {
  *         - backtrack stack base
  *         - matches
  *         - numMatches
+ *         - backtrackCount
  *       - Registers
  *         - Capture positions
  *         - Scratch registers
@@ -952,6 +989,10 @@ void SMRegExpMacroAssembler::initFrameAndRegs() {
   masm_.load32(Address(matchesReg, MatchPairs::offsetOfPairCount()), temp2_);
   masm_.store32(temp2_, numMatches());
 
+  if (has_backtrack_limit()) {
+    masm_.store32(Imm32(0), backtrackCount());
+  }
+
 #ifdef DEBUG
   // Bounds-check numMatches.
   js::jit::Label enoughRegisters;
@@ -1018,7 +1059,7 @@ void SMRegExpMacroAssembler::initFrameAndRegs() {
   }
 
   // Initialize backtrack stack pointer
-  masm_.loadPtr(AbsoluteAddress(isolate()->top_of_regexp_stack()),
+  masm_.loadPtr(AbsoluteAddress(cxIsolate_->top_of_regexp_stack()),
                 backtrack_stack_pointer_);
   masm_.storePtr(backtrack_stack_pointer_, backtrackStackBase());
 }
@@ -1121,7 +1162,7 @@ void SMRegExpMacroAssembler::stackOverflowHandler() {
   masm_.bind(&stack_overflow_label_);
 
   // Load argument
-  masm_.movePtr(ImmPtr(isolate()->regexp_stack()), temp1_);
+  masm_.movePtr(ImmPtr(cxIsolate_->regexp_stack()), temp1_);
 
   // Save registers before calling C function
   LiveGeneralRegisterSet volatileRegs(GeneralRegisterSet::Volatile());
@@ -1157,7 +1198,7 @@ void SMRegExpMacroAssembler::stackOverflowHandler() {
                      offsetof(FrameData, backtrackStackBase) + frameOffset);
   masm_.subPtr(bsbAddress, backtrack_stack_pointer_);
 
-  masm_.loadPtr(AbsoluteAddress(isolate()->top_of_regexp_stack()), temp1_);
+  masm_.loadPtr(AbsoluteAddress(cxIsolate_->top_of_regexp_stack()), temp1_);
   masm_.storePtr(temp1_, bsbAddress);
   masm_.addPtr(temp1_, backtrack_stack_pointer_);
 
@@ -33,12 +33,20 @@ struct FrameData {
   // Copy of the input MatchPairs.
   int32_t* matches;    // pointer to capture array
   int32_t numMatches;  // size of capture array
+
+  // Number of backtracks so far. Only used if there is a backtrack limit.
+  uint32_t backtrackCount;
 };
 
 class SMRegExpMacroAssembler final : public NativeRegExpMacroAssembler {
  public:
-  SMRegExpMacroAssembler(JSContext* cx, js::jit::StackMacroAssembler& masm,
-                         Zone* zone, Mode mode, uint32_t num_capture_registers);
+  // Generate code to run on |cx|, whose isolate is |cxIsolate|. The code is
+  // usually generated on |cx|'s thread with |isolate| == |cxIsolate|. When it
+  // is generated on a helper thread, |isolate| is that thread's isolate, and
+  // the code must be linked on |cx|'s thread by calling Link after GetCode.
+  SMRegExpMacroAssembler(JSContext* cx, Isolate* cxIsolate, Isolate* isolate,
+                         js::jit::MacroAssembler& masm, Zone* zone, Mode mode,
+                         uint32_t num_capture_registers);
   virtual ~SMRegExpMacroAssembler() = default;
 
   virtual int stack_limit_slack();
@@ -101,6 +109,7 @@ class SMRegExpMacroAssembler final : public NativeRegExpMacroAssembler {
   virtual void ClearRegisters(int reg_from, int reg_to);
 
   virtual Handle<HeapObject> GetCode(Handle<String> source);
+  js::jit::JitCode* Link(JSContext* cx);
 
   virtual bool CanReadUnaligned();
 
@@ -178,6 +187,10 @@ class SMRegExpMacroAssembler final : public NativeRegExpMacroAssembler {
     return js::jit::Address(masm_.getStackPointer(),
                             offsetof(FrameData, numMatches));
   }
+  js::jit::Address backtrackCount() {
+    return js::jit::Address(masm_.getStackPointer(),
+                            offsetof(FrameData, backtrackCount));
+  }
 
   // The stack-pointer-relative location of a regexp register.
   js::jit::Address register_location(int register_index) {
@@ -195,7 +208,9 @@ class SMRegExpMacroAssembler final : public NativeRegExpMacroAssembler {
   }
 
   JSContext* cx_;
-  js::jit::StackMacroAssembler& masm_;
+  Isolate* cxIsolate_;
+  js::jit::MacroAssembler& masm_;
+  bool deferLinking_;
 
   /*
    * This assembler uses the following registers:
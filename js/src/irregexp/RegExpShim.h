@@ -945,8 +945,7 @@ class JSRegExp : public HeapObject {
     return Object(JS::PrivateValue(inner()->getByteCode(is_latin1)));
   }
 
-  // TODO: should we expose this?
-  uint32_t BacktrackLimit() const { return 0; }
+  uint32_t BacktrackLimit() const { return inner()->backtrackLimit(); }
 
   static JSRegExp cast(Object object) {
     JSRegExp regexp;
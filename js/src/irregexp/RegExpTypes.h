@@ -59,6 +59,12 @@ using ByteArrayData = v8::internal::ByteArrayData;
 using ByteArray = js::UniquePtr<v8::internal::ByteArrayData, JS::FreePolicy>;
 using InputOutputData = v8::internal::InputOutputData;
 
+// Compiled program for the linear-time engine, see RegExpLinear.h.
+class LinearProgram;
+
+// Off-thread native code compilation, see RegExpAPI.h.
+class RegExpCompileTask;
+
 }  // namespace irregexp
 }  // namespace js
 
@@ -43,7 +43,8 @@
 
 #include "vm/ArgumentsObject.h"  // js::ArgumentsObject::finishForIonPure
 #include "vm/NativeObject.h"     // js::NativeObject
-#include "vm/RegExpShared.h"     // js::ExecuteRegExpAtomRaw
+#include "vm/RegExpShared.h"     // js::ExecuteRegExpAtomRaw,
+                                 // js::RegExpSkipToPossibleMatchRaw
 #include "vm/TraceLogging.h"     // js::TraceLogStartEventPrivate,
                                  // js::TraceLogStartEvent,
                                  // js::TraceLogStopEventPrivate
@@ -161,6 +162,7 @@ namespace jit {
   _(js::ProxyGetProperty)                                             \
   _(js::RegExpInstanceOptimizableRaw)                                 \
   _(js::RegExpPrototypeOptimizableRaw)                                \
+  _(js::RegExpSkipToPossibleMatchRaw)                                 \
   _(js::SetIteratorObject::next)                                      \
   _(js::StringToNumberPure)                                           \
   _(js::TraceLogStartEventPrivate)                                    \
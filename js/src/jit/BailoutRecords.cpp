@@ -0,0 +1,192 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jit/BailoutRecords.h"
+
+#include "jit/BaselineIC.h"
+#include "jit/JitRuntime.h"
+#include "jit/JitScript.h"
+#ifdef TRACK_SNAPSHOTS
+#  include "jit/MIR.h"
+#endif
+#include "js/experimental/JitBailouts.h"  // js::GetJitBailoutRecords
+#include "util/Text.h"
+#include "vm/JSContext.h"
+#include "vm/JSONPrinter.h"
+#include "vm/JSScript.h"
+#include "vm/Printer.h"
+
+using namespace js;
+using namespace js::jit;
+
+BailoutRecords::Record* BailoutRecords::recordBailout(
+    JSScript* script, jsbytecode* pc, BailoutKind kind, ICScript* icScript,
+    [[maybe_unused]] uint32_t mirOpcode) {
+  uint32_t pcOffset = script->pcToOffset(pc);
+  Site site{script->scriptSource()->id(), script->sourceStart(), pcOffset,
+            kind};
+
+  Map::AddPtr p = map_.lookupForAdd(site);
+  if (!p) {
+    if (map_.count() >= MaxSites) {
+      droppedBailouts_++;
+      return nullptr;
+    }
+
+    Record record;
+    if (const char* filename = script->filename()) {
+      record.filename = DuplicateString(filename);
+      if (!record.filename) {
+        droppedBailouts_++;
+        return nullptr;
+      }
+    }
+    unsigned column;
+    record.line = PCToLineNumber(script, pc, &column);
+    record.column = column;
+    record.op = JSOp(*pc);
+
+    if (!map_.add(p, site, std::move(record))) {
+      droppedBailouts_++;
+      return nullptr;
+    }
+  }
+
+  Record& record = p->value();
+  record.bailouts++;
+
+#ifdef TRACK_SNAPSHOTS
+  record.mirOpcode = mirOpcode;
+#endif
+
+  record.hasIC = false;
+  if (icScript) {
+    ICEntry* entry = icScript->interpreterICEntryFromPCOffset(pcOffset);
+    if (entry) {
+      ICFallbackStub* fallback = icScript->fallbackStubForICEntry(entry);
+      if (fallback->pcOffset() == pcOffset) {
+        const ICState& state = fallback->state();
+        record.hasIC = true;
+        record.icMode = state.mode();
+        record.icNumOptimizedStubs = state.numOptimizedStubs();
+        record.icUsedByTranspiler = state.usedByTranspiler();
+      }
+    }
+  }
+
+  return &record;
+}
+
+void BailoutRecords::clear() {
+  map_.clearAndCompact();
+  droppedBailouts_ = 0;
+}
+
+static void PutEscapedString(GenericPrinter& out, const char* s) {
+  for (; *s; s++) {
+    unsigned char c = *s;
+    if (c == '"' || c == '\\') {
+      out.printf("\\%c", c);
+    } else if (c < ' ') {
+      out.printf("\\u%04x", c);
+    } else {
+      out.putChar(c);
+    }
+  }
+}
+
+static const char* ICModeString(ICState::Mode mode) {
+  switch (mode) {
+    case ICState::Mode::Specialized:
+      return "Specialized";
+    case ICState::Mode::Megamorphic:
+      return "Megamorphic";
+    case ICState::Mode::Generic:
+      return "Generic";
+  }
+  MOZ_CRASH("Unexpected mode");
+}
+
+void BailoutRecords::writeJSON(JSONPrinter& json) const {
+  json.beginObject();
+
+  json.beginListProperty("sites");
+  for (Map::Range r = map_.all(); !r.empty(); r.popFront()) {
+    const Site& site = r.front().key();
+    const Record& record = r.front().value();
+
+    json.beginObject();
+
+    GenericPrinter& filename = json.beginStringProperty("filename");
+    if (record.filename) {
+      PutEscapedString(filename, record.filename.get());
+    }
+    json.endStringProperty();
+
+    json.property("line", record.line);
+    json.property("column", record.column);
+    json.property("pcOffset", site.pcOffset);
+    json.property("op", CodeName(record.op));
+    json.property("kind", BailoutKindString(site.kind));
+    json.property("bailouts", record.bailouts);
+    json.property("invalidations", record.invalidations);
+    json.boolProperty("transpilerDisabled", record.transpilerDisabled);
+
+#ifdef TRACK_SNAPSHOTS
+    if (record.mirOpcode != UINT32_MAX) {
+      GenericPrinter& mir = json.beginStringProperty("mir");
+      MDefinition::PrintOpcodeName(mir,
+                                   MDefinition::Opcode(record.mirOpcode));
+      json.endStringProperty();
+    }
+#endif
+
+    if (record.hasIC) {
+      json.beginObjectProperty("ic");
+      json.property("mode", ICModeString(record.icMode));
+      json.property("optimizedStubs", uint32_t(record.icNumOptimizedStubs));
+      json.boolProperty("transpiled", record.icUsedByTranspiler);
+      json.endObject();
+    } else {
+      json.nullProperty("ic");
+    }
+
+    json.endObject();
+  }
+  json.endList();
+
+  json.property("droppedBailouts", droppedBailouts_);
+
+  json.endObject();
+}
+
+JS_PUBLIC_API JS::UniqueChars js::GetJitBailoutRecords(JSContext* cx,
+                                                       size_t* length) {
+  Sprinter out(cx);
+  if (!out.init()) {
+    return nullptr;
+  }
+
+  JSONPrinter json(out, /* indent = */ false);
+  if (JitRuntime* jrt = cx->runtime()->jitRuntime()) {
+    jrt->bailoutRecords().writeJSON(json);
+  } else {
+    BailoutRecords().writeJSON(json);
+  }
+
+  if (out.hadOutOfMemory()) {
+    return nullptr;
+  }
+
+  *length = out.getOffset();
+  return js::DuplicateString(cx, out.string(), *length);
+}
+
+JS_PUBLIC_API void js::ClearJitBailoutRecords(JSContext* cx) {
+  if (JitRuntime* jrt = cx->runtime()->jitRuntime()) {
+    jrt->bailoutRecords().clear();
+  }
+}
@@ -0,0 +1,122 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef jit_BailoutRecords_h
+#define jit_BailoutRecords_h
+
+#include "mozilla/HashFunctions.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jstypes.h"
+
+#include "jit/ICState.h"
+#include "jit/IonTypes.h"
+#include "js/AllocPolicy.h"
+#include "js/HashTable.h"
+#include "js/TypeDecls.h"
+#include "js/Utility.h"
+#include "vm/BytecodeUtil.h"
+
+namespace js {
+
+class JSONPrinter;
+
+namespace jit {
+
+class ICScript;
+
+// [SMDOC] Bailout records
+//
+// To find out why hot code keeps bailing out of Ion, the JitRuntime keeps a
+// record for each bailout site: a bytecode op in a script together with the
+// kind of bailout. A record counts the bailouts and invalidations at the site
+// and describes the Baseline IC at the op. In builds with TRACK_SNAPSHOTS it
+// also names the MIR instruction that bailed out.
+//
+// Sites are identified by their script's source and position, not by a
+// JSScript pointer, so records outlive the script and don't need tracing.
+// The number of sites is bounded; bailouts at new sites are only counted once
+// the table is full.
+//
+// The records can be dumped as JSON with js::GetJitBailoutRecords.
+class BailoutRecords {
+ public:
+  struct Site {
+    uint32_t scriptSourceId;
+    uint32_t sourceStart;
+    uint32_t pcOffset;
+    BailoutKind kind;
+
+    bool operator==(const Site& other) const {
+      return scriptSourceId == other.scriptSourceId &&
+             sourceStart == other.sourceStart && pcOffset == other.pcOffset &&
+             kind == other.kind;
+    }
+  };
+
+  struct SiteHasher {
+    using Lookup = Site;
+    static HashNumber hash(const Site& site) {
+      return mozilla::HashGeneric(site.scriptSourceId, site.sourceStart,
+                                  site.pcOffset, uint8_t(site.kind));
+    }
+    static bool match(const Site& a, const Site& b) { return a == b; }
+  };
+
+  struct Record {
+    UniqueChars filename;
+    uint32_t line = 0;
+    uint32_t column = 0;
+    JSOp op = JSOp::Nop;
+
+    uint32_t bailouts = 0;
+    uint32_t invalidations = 0;
+
+    // Whether the Baseline IC at this op was marked so that it is no longer
+    // transpiled. See ICState::hadUnfixableBailouts.
+    bool transpilerDisabled = false;
+
+    // The Baseline IC at this op at the time of the last bailout.
+    bool hasIC = false;
+    ICState::Mode icMode = ICState::Mode::Specialized;
+    uint8_t icNumOptimizedStubs = 0;
+    bool icUsedByTranspiler = false;
+
+#ifdef TRACK_SNAPSHOTS
+    uint32_t mirOpcode = UINT32_MAX;
+#endif
+  };
+
+  static const size_t MaxSites = 1024;
+
+ private:
+  using Map = HashMap<Site, Record, SiteHasher, SystemAllocPolicy>;
+  Map map_;
+
+  // Bailouts that weren't recorded because the table was full or we ran out
+  // of memory.
+  uint64_t droppedBailouts_ = 0;
+
+ public:
+  // Count a bailout in |script| at |pc|. |icScript| is the ICScript of the
+  // Baseline frame we bailed out to. Returns nullptr if the bailout couldn't
+  // be recorded; that's not an error.
+  Record* recordBailout(JSScript* script, jsbytecode* pc, BailoutKind kind,
+                        ICScript* icScript, uint32_t mirOpcode);
+
+  void clear();
+
+  bool empty() const { return map_.empty() && droppedBailouts_ == 0; }
+
+  void writeJSON(JSONPrinter& json) const;
+};
+
+}  // namespace jit
+}  // namespace js
+
+#endif /* jit_BailoutRecords_h */
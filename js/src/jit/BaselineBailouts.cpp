@@ -10,6 +10,7 @@
 #include "builtin/ModuleObject.h"
 #include "debugger/DebugAPI.h"
 #include "jit/arm/Simulator-arm.h"
+#include "jit/BailoutRecords.h"
 #include "jit/BaselineFrame.h"
 #include "jit/BaselineIC.h"
 #include "jit/BaselineJIT.h"
@@ -1699,6 +1700,12 @@ bool jit::BailoutIonToBaseline(JSContext* cx, JitActivation* activation,
   info = builder.takeBuffer();
   info->numFrames = builder.frameNo() + 1;
   info->bailoutKind.emplace(bailoutKind);
+  if (!excInfo) {
+    info->bailoutPC = builder.pc();
+#ifdef TRACK_SNAPSHOTS
+    info->mirOpcode = snapIter.mirOpcode();
+#endif
+  }
   *bailoutInfo = info;
   guardRemoveRematerializedFramesFromDebugger.release();
   return true;
@@ -1792,6 +1799,36 @@ static bool CopyFromRematerializedFrame(JSContext* cx, JitActivation* act,
   return true;
 }
 
+// Mark the Baseline IC at |pc| in |frame| so that WarpOracle no longer
+// transpiles it. Returns false if there's no transpiled IC at |pc| or if the IC
+// has been marked before.
+static bool DisableTranspilerAtBailoutSite(BaselineFrame* frame,
+                                           jsbytecode* pc) {
+  ICScript* icScript = frame->icScript();
+  if (!icScript) {
+    return false;
+  }
+
+  uint32_t pcOffset = frame->script()->pcToOffset(pc);
+  ICEntry* entry = icScript->interpreterICEntryFromPCOffset(pcOffset);
+  if (!entry) {
+    return false;
+  }
+
+  ICFallbackStub* fallback = icScript->fallbackStubForICEntry(entry);
+  if (fallback->pcOffset() != pcOffset) {
+    return false;
+  }
+
+  ICState& state = fallback->state();
+  if (!state.usedByTranspiler() || state.hadUnfixableBailouts()) {
+    return false;
+  }
+
+  state.setHadUnfixableBailouts();
+  return true;
+}
+
 enum class BailoutAction {
   InvalidateImmediately,
   InvalidateIfFrequent,
@@ -1951,6 +1988,18 @@ bool jit::FinishBailoutToBaseline(BaselineBailoutInfo* bailoutInfoArg) {
           innerScript->lineno(), innerScript->column(),
           innerScript->getWarmUpCount(), (unsigned)bailoutKind);
 
+  jsbytecode* bailoutPC = bailoutInfo->bailoutPC;
+  BailoutRecords::Record* record = nullptr;
+  if (bailoutPC) {
+    uint32_t mirOpcode = UINT32_MAX;
+#ifdef TRACK_SNAPSHOTS
+    mirOpcode = bailoutInfo->mirOpcode;
+#endif
+    record = cx->runtime()->jitRuntime()->bailoutRecords().recordBailout(
+        innerScript, bailoutPC, bailoutKind, topFrame->icScript(), mirOpcode);
+  }
+  bool hadIonScript = outerScript->hasIonScript();
+
   BailoutAction action = BailoutAction::InvalidateImmediately;
   DebugOnly<bool> saveFailedICHash = false;
   switch (bailoutKind) {
@@ -2107,8 +2156,20 @@ bool jit::FinishBailoutToBaseline(BaselineBailoutInfo* bailoutInfoArg) {
       case BailoutAction::DisableIfFrequent:
         ionScript->incNumUnfixableBailouts();
         if (ionScript->shouldInvalidateAndDisable()) {
-          InvalidateAfterBailout(cx, outerScript, "unfixable bailouts");
-          outerScript->disableIon();
+          // If the bailouts come from code transpiled from a Baseline IC,
+          // stop transpiling that IC and recompile. We only disable Ion for
+          // the whole script if that doesn't help.
+          if (bailoutPC && bailoutKind != BailoutKind::DuringVMCall &&
+              DisableTranspilerAtBailoutSite(topFrame, bailoutPC)) {
+            if (record) {
+              record->transpilerDisabled = true;
+            }
+            InvalidateAfterBailout(cx, outerScript,
+                                   "unfixable bailouts at one IC");
+          } else {
+            InvalidateAfterBailout(cx, outerScript, "unfixable bailouts");
+            outerScript->disableIon();
+          }
         }
         break;
       case BailoutAction::NoAction:
@@ -2116,5 +2177,9 @@ bool jit::FinishBailoutToBaseline(BaselineBailoutInfo* bailoutInfoArg) {
     }
   }
 
+  if (record && hadIonScript && !outerScript->hasIonScript()) {
+    record->invalidations++;
+  }
+
   return true;
 }
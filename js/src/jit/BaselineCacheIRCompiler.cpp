@@ -2062,6 +2062,7 @@ ICCacheIRStub* js::jit::AttachBaselineCacheIRStub(
   writer.copyStubData(newStub->stubDataStart());
   newStub->setTypeData(writer.typeData());
   stub->addNewStub(icEntry, newStub);
+  outerScript->jitScript()->noteStubAttached(outerScript);
   *attached = true;
   return newStub;
 }
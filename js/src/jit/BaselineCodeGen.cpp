@@ -1503,10 +1503,19 @@ bool BaselineInterpreterCodeGen::emitWarmUpCounterIncrement() {
   masm.store32(countReg, warmUpCounterAddr);
 
   // If the script is warm enough for Baseline compilation, call into the VM to
-  // compile it.
-  Label done;
-  masm.branch32(Assembler::BelowOrEqual, countReg,
-                Imm32(JitOptions.baselineJitWarmUpThreshold), &done);
+  // compile it. Also call into the VM if JitOptions.baselineJitWarmUpThreshold
+  // has changed since the script's threshold was computed, to recompute it.
+  Label done, checkCompile;
+  Address thresholdAddr(scriptReg,
+                        JitScript::offsetOfBaselineJitWarmUpThreshold());
+  masm.branch32(Assembler::Below, thresholdAddr, countReg, &checkCompile);
+  masm.load32(
+      Address(scriptReg, JitScript::offsetOfBaselineJitWarmUpThresholdOption()),
+      countReg);
+  masm.branch32(Assembler::Equal,
+                AbsoluteAddress(&JitOptions.baselineJitWarmUpThreshold),
+                countReg, &done);
+  masm.bind(&checkCompile);
   masm.branchPtr(Assembler::Equal,
                  Address(scriptReg, JitScript::offsetOfBaselineScript()),
                  ImmPtr(BaselineDisabledScriptPtr), &done);
@@ -2577,6 +2586,25 @@ bool BaselineCodeGen<Handler>::emit_RegExp() {
   return true;
 }
 
+template <typename Handler>
+bool BaselineCodeGen<Handler>::emit_NewArrayCopy() {
+  frame.syncStack(0);
+
+  prepareVMCall();
+  pushScriptGCThingArg(ScriptGCThingType::Object, R0.scratchReg(),
+                       R1.scratchReg());
+
+  using Fn = ArrayObject* (*)(JSContext*, Handle<ArrayObject*>);
+  if (!callVM<Fn, NewArrayCopyOperation>()) {
+    return false;
+  }
+
+  // Box and push return value.
+  masm.tagValue(JSVAL_TYPE_OBJECT, ReturnReg, R0);
+  frame.push(R0);
+  return true;
+}
+
 template <typename Handler>
 bool BaselineCodeGen<Handler>::emit_Lambda() {
   prepareVMCall();
@@ -2881,8 +2909,10 @@ bool BaselineInterpreterCodeGen::emit_InitElemArray() {
   masm.add32(Imm32(1), index);
   masm.store32(index, initLength);
 
-  // Mark elements as NON_PACKED if we stored the hole value.
+  // Mark elements as NON_PACKED if we stored the hole value and as NON_INT32
+  // if we stored anything other than an Int32 value.
   MarkElementsNonPackedIfHoleValue(masm, obj, R0);
+  masm.markElementsNonInt32IfNeeded(obj, R0);
 
   // Post-barrier.
   Label skipBarrier;
@@ -2938,6 +2968,17 @@ bool BaselineCompilerCodeGen::emit_InitElemArray() {
 #endif
   }
 
+  // Mark elements as NON_INT32 if we stored anything other than an Int32
+  // value.
+  if (knownValue) {
+    if (!knownValue->isInt32()) {
+      Address elementsFlags(obj, ObjectElements::offsetOfFlags());
+      masm.or32(Imm32(ObjectElements::NON_INT32), elementsFlags);
+    }
+  } else {
+    masm.markElementsNonInt32IfNeeded(obj, R0);
+  }
+
   // Post-barrier.
   if (knownValue) {
     MOZ_ASSERT(JS::GCPolicy<Value>::isTenured(*knownValue));
@@ -309,7 +309,11 @@ static MethodStatus CanEnterBaselineJIT(JSContext* cx, HandleScript script,
   }
 
   // Check script warm-up counter.
-  if (script->getWarmUpCount() <= JitOptions.baselineJitWarmUpThreshold) {
+  uint32_t warmUpThreshold =
+      script->hasJitScript()
+          ? script->jitScript()->baselineJitWarmUpThreshold(script)
+          : ComputeBaselineJitWarmUpThreshold(script);
+  if (script->getWarmUpCount() <= warmUpThreshold) {
     return Method_Skipped;
   }
 
@@ -353,6 +357,23 @@ bool jit::CanBaselineInterpretScript(JSScript* script) {
   return true;
 }
 
+uint32_t jit::ComputeBaselineJitWarmUpThreshold(JSScript* script) {
+  uint32_t warmUpThreshold = JitOptions.baselineJitWarmUpThreshold;
+
+  // Large scripts take longer to compile and many of them, e.g. top-level
+  // scripts and module bodies, only run once or twice. Require more warm-up for
+  // them. Scripts with hot loops still get there quickly because every loop
+  // iteration counts.
+  uint32_t largeScriptSize = JitOptions.baselineJitLargeScriptSize;
+  if (largeScriptSize && script->length() > largeScriptSize) {
+    double scale = std::min(script->length() / double(largeScriptSize),
+                            double(BaselineMaxWarmUpScale));
+    warmUpThreshold *= scale;
+  }
+
+  return warmUpThreshold;
+}
+
 static MethodStatus CanEnterBaselineInterpreter(JSContext* cx,
                                                 JSScript* script) {
   MOZ_ASSERT(IsBaselineInterpreterEnabled());
@@ -972,6 +993,7 @@ void jit::FinishDiscardBaselineScript(JSFreeOp* fop, JSScript* script) {
   MOZ_ASSERT(script->hasBaselineScript());
   MOZ_ASSERT(!script->jitScript()->active());
 
+  script->jitScript()->noteBaselineScriptReleased(fop, script);
   BaselineScript* baseline =
       script->jitScript()->clearBaselineScript(fop, script);
   BaselineScript::Destroy(fop, baseline);
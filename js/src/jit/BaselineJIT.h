@@ -86,6 +86,10 @@ static constexpr uint32_t BaselineMaxScriptLength = 0x0fffffffu;
 // stack frames.
 static constexpr uint32_t BaselineMaxScriptSlots = 0xffffu;
 
+// Upper bound on how much JitOptions.baselineJitLargeScriptSize can scale up
+// the Baseline JIT warm-up threshold of a large script.
+static constexpr uint32_t BaselineMaxWarmUpScale = 10;
+
 // An entry in the BaselineScript return address table. These entries are used
 // to determine the bytecode pc for a return address into Baseline code.
 //
@@ -428,6 +432,10 @@ JitExecStatus EnterBaselineInterpreterAtBranch(JSContext* cx,
 
 bool CanBaselineInterpretScript(JSScript* script);
 
+// The warm-up count |script| needs before it's compiled with the Baseline JIT.
+// This is stored in the JitScript, see JitScript::baselineJitWarmUpThreshold.
+uint32_t ComputeBaselineJitWarmUpThreshold(JSScript* script);
+
 // Called by the Baseline Interpreter to compile a script for the Baseline JIT.
 // |res| is set to the native code address in the BaselineScript to jump to, or
 // nullptr if we were unable to compile this script.
@@ -473,6 +481,15 @@ struct alignas(uintptr_t) BaselineBailoutInfo {
   // The bailout kind.
   mozilla::Maybe<BailoutKind> bailoutKind = {};
 
+  // The pc in the innermost frame where the bailout happened. This is nullptr
+  // when bailing out to handle an exception.
+  jsbytecode* bailoutPC = nullptr;
+
+#ifdef TRACK_SNAPSHOTS
+  // The opcode of the MIR instruction whose snapshot we bailed out from.
+  uint32_t mirOpcode = UINT32_MAX;
+#endif
+
   BaselineBailoutInfo() = default;
   BaselineBailoutInfo(const BaselineBailoutInfo&) = default;
 
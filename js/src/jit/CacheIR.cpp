@@ -2355,6 +2355,17 @@ AttachDecision GetPropIRGenerator::tryAttachDenseElement(
   }
 
   TestMatchingNativeReceiver(writer, nobj, objId);
+
+  // If the elements are currently all Int32 values, optimistically assume
+  // they'll stay that way so that Warp can load them as unboxed Int32 values.
+  if (nobj->denseElementsAreInt32()) {
+    writer.loadDenseElementInt32Result(objId, indexId);
+    writer.returnFromIC();
+
+    trackAttached("DenseElementInt32");
+    return AttachDecision::Attach;
+  }
+
   writer.loadDenseElementResult(objId, indexId);
   writer.returnFromIC();
 
@@ -7682,6 +7693,40 @@ AttachDecision CallIRGenerator::tryAttachObjectIsPrototypeOf(
   return AttachDecision::Attach;
 }
 
+AttachDecision CallIRGenerator::tryAttachObjectKeys(HandleFunction callee) {
+  // Only handle the common case of a single native object argument. Proxies
+  // can run arbitrary code when their keys are enumerated.
+  if (argc_ != 1 || !args_[0].isObject() ||
+      !args_[0].toObject().is<NativeObject>()) {
+    return AttachDecision::NoAction;
+  }
+
+  // ObjectKeys isn't effectful, so it mustn't be used for classes whose
+  // resolve or enumerate hooks can define properties, like functions, the
+  // global object and arguments objects.
+  const JSClass* clasp = args_[0].toObject().getClass();
+  if (clasp->getResolve() || clasp->getEnumerate() ||
+      clasp->getNewEnumerate()) {
+    return AttachDecision::NoAction;
+  }
+
+  // Initialize the input operand.
+  Int32OperandId argcId(writer.setInputOperandId(0));
+
+  // Guard callee is the 'keys' native function.
+  emitNativeCalleeGuard(callee);
+
+  ValOperandId argId = writer.loadArgumentFixedSlot(ArgumentKind::Arg0, argc_);
+  ObjOperandId objId = writer.guardToObject(argId);
+  writer.guardAnyClass(objId, clasp);
+
+  writer.objectKeysResult(objId);
+  writer.returnFromIC();
+
+  trackAttached("ObjectKeys");
+  return AttachDecision::Attach;
+}
+
 AttachDecision CallIRGenerator::tryAttachObjectToString(HandleFunction callee) {
   // Expecting no arguments.
   if (argc_ != 0) {
@@ -8068,6 +8113,177 @@ AttachDecision CallIRGenerator::tryAttachGetNextMapSetEntryForIterator(
   return AttachDecision::Attach;
 }
 
+bool CallIRGenerator::emitMapSetKeyHash(ObjOperandId objId,
+                                        ValOperandId keyId,
+                                        Int32OperandId* hashId) {
+  // Guard on the type of the key and emit its hash for an inline lookup in
+  // the Map or Set |objId|. Returns false if the key has to be looked up
+  // through the VM instead.
+#ifdef JS_PUNBOX64
+  const Value& key = args_[0];
+  switch (key.type()) {
+    case ValueType::Undefined:
+    case ValueType::Null:
+    case ValueType::Boolean:
+    case ValueType::Int32:
+      writer.guardNonDoubleType(keyId, key.type());
+      *hashId = writer.hashNonGCThing(keyId);
+      return true;
+    case ValueType::String: {
+      // HashableValue atomizes strings. Non-atoms have to be atomized in the
+      // VM before they can be compared by their address.
+      if (!key.toString()->isAtom()) {
+        return false;
+      }
+      StringOperandId strId = writer.guardToString(keyId);
+      *hashId = writer.hashString(strId);
+      return true;
+    }
+    case ValueType::Symbol: {
+      SymbolOperandId symId = writer.guardToSymbol(keyId);
+      *hashId = writer.hashSymbol(symId);
+      return true;
+    }
+    case ValueType::Object: {
+      ObjOperandId keyObjId = writer.guardToObject(keyId);
+      *hashId = writer.hashObject(objId, keyObjId);
+      return true;
+    }
+    case ValueType::Double:
+      // HashableValue normalizes doubles, so they're handled in the VM.
+    case ValueType::BigInt:
+      // BigInts are compared by value, not by address.
+      return false;
+    case ValueType::Magic:
+    case ValueType::PrivateGCThing:
+      break;
+  }
+  MOZ_CRASH("Unexpected value type");
+#else
+  // The inline lookup needs more registers than IC stubs have available on
+  // 32-bit platforms.
+  return false;
+#endif
+}
+
+AttachDecision CallIRGenerator::tryAttachMapMethod(HandleFunction callee,
+                                                   InlinableNative native) {
+  // Ensure |this| is a MapObject.
+  if (!thisval_.isObject() || !thisval_.toObject().is<MapObject>()) {
+    return AttachDecision::NoAction;
+  }
+
+  // Map.prototype.set takes (key, value), the other methods take (key).
+  uint32_t expectedArgc = native == InlinableNative::MapSet ? 2 : 1;
+  if (argc_ != expectedArgc) {
+    return AttachDecision::NoAction;
+  }
+
+  // Initialize the input operand.
+  Int32OperandId argcId(writer.setInputOperandId(0));
+
+  // Guard callee is this Map native function.
+  emitNativeCalleeGuard(callee);
+
+  // Guard |this| is a MapObject.
+  ValOperandId thisValId =
+      writer.loadArgumentFixedSlot(ArgumentKind::This, argc_);
+  ObjOperandId objId = writer.guardToObject(thisValId);
+  writer.guardAnyClass(objId, &MapObject::class_);
+
+  ValOperandId keyId = writer.loadArgumentFixedSlot(ArgumentKind::Arg0, argc_);
+
+  Int32OperandId hashId;
+  switch (native) {
+    case InlinableNative::MapGet:
+      if (emitMapSetKeyHash(objId, keyId, &hashId)) {
+        writer.mapGetNonBigIntResult(objId, keyId, hashId);
+      } else {
+        writer.mapGetResult(objId, keyId);
+      }
+      trackAttached("MapGet");
+      break;
+    case InlinableNative::MapHas:
+      if (emitMapSetKeyHash(objId, keyId, &hashId)) {
+        writer.mapHasNonBigIntResult(objId, keyId, hashId);
+      } else {
+        writer.mapHasResult(objId, keyId);
+      }
+      trackAttached("MapHas");
+      break;
+    case InlinableNative::MapSet: {
+      ValOperandId valueId =
+          writer.loadArgumentFixedSlot(ArgumentKind::Arg1, argc_);
+      writer.mapSetResult(objId, keyId, valueId);
+      trackAttached("MapSet");
+      break;
+    }
+    case InlinableNative::MapDelete:
+      writer.mapDeleteResult(objId, keyId);
+      trackAttached("MapDelete");
+      break;
+    default:
+      MOZ_CRASH("Unexpected native");
+  }
+  writer.returnFromIC();
+
+  return AttachDecision::Attach;
+}
+
+AttachDecision CallIRGenerator::tryAttachSetMethod(HandleFunction callee,
+                                                   InlinableNative native) {
+  // Ensure |this| is a SetObject.
+  if (!thisval_.isObject() || !thisval_.toObject().is<SetObject>()) {
+    return AttachDecision::NoAction;
+  }
+
+  // Expected arguments: value.
+  if (argc_ != 1) {
+    return AttachDecision::NoAction;
+  }
+
+  // Initialize the input operand.
+  Int32OperandId argcId(writer.setInputOperandId(0));
+
+  // Guard callee is this Set native function.
+  emitNativeCalleeGuard(callee);
+
+  // Guard |this| is a SetObject.
+  ValOperandId thisValId =
+      writer.loadArgumentFixedSlot(ArgumentKind::This, argc_);
+  ObjOperandId objId = writer.guardToObject(thisValId);
+  writer.guardAnyClass(objId, &SetObject::class_);
+
+  ValOperandId valueId =
+      writer.loadArgumentFixedSlot(ArgumentKind::Arg0, argc_);
+
+  switch (native) {
+    case InlinableNative::SetHas: {
+      Int32OperandId hashId;
+      if (emitMapSetKeyHash(objId, valueId, &hashId)) {
+        writer.setHasNonBigIntResult(objId, valueId, hashId);
+      } else {
+        writer.setHasResult(objId, valueId);
+      }
+      trackAttached("SetHas");
+      break;
+    }
+    case InlinableNative::SetAdd:
+      writer.setAddResult(objId, valueId);
+      trackAttached("SetAdd");
+      break;
+    case InlinableNative::SetDelete:
+      writer.setDeleteResult(objId, valueId);
+      trackAttached("SetDelete");
+      break;
+    default:
+      MOZ_CRASH("Unexpected native");
+  }
+  writer.returnFromIC();
+
+  return AttachDecision::Attach;
+}
+
 AttachDecision CallIRGenerator::tryAttachFinishBoundFunctionInit(
     HandleFunction callee) {
   // Self-hosted code calls this with (boundFunction, targetObj, argCount)
@@ -8944,7 +9160,12 @@ AttachDecision CallIRGenerator::tryAttachInlinableNative(
     case InlinableNative::MathMax:
       return tryAttachMathMinMax(callee, /* isMax = */ true);
 
-    // Map intrinsics.
+    // Map natives and intrinsics.
+    case InlinableNative::MapGet:
+    case InlinableNative::MapHas:
+    case InlinableNative::MapSet:
+    case InlinableNative::MapDelete:
+      return tryAttachMapMethod(callee, native);
     case InlinableNative::IntrinsicGuardToMapObject:
       return tryAttachGuardToClass(callee, native);
     case InlinableNative::IntrinsicGetNextMapEntryForIterator:
@@ -8963,10 +9184,16 @@ AttachDecision CallIRGenerator::tryAttachInlinableNative(
       return tryAttachObjectIs(callee);
     case InlinableNative::ObjectIsPrototypeOf:
       return tryAttachObjectIsPrototypeOf(callee);
+    case InlinableNative::ObjectKeys:
+      return tryAttachObjectKeys(callee);
     case InlinableNative::ObjectToString:
       return tryAttachObjectToString(callee);
 
-    // Set intrinsics.
+    // Set natives and intrinsics.
+    case InlinableNative::SetHas:
+    case InlinableNative::SetAdd:
+    case InlinableNative::SetDelete:
+      return tryAttachSetMethod(callee, native);
     case InlinableNative::IntrinsicGuardToSetObject:
       return tryAttachGuardToClass(callee, native);
     case InlinableNative::IntrinsicGetNextSetEntryForIterator:
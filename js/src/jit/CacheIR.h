@@ -1735,6 +1735,12 @@ class MOZ_RAII CallIRGenerator : public IRGenerator {
   AttachDecision tryAttachIsConstructing(HandleFunction callee);
   AttachDecision tryAttachGetNextMapSetEntryForIterator(HandleFunction callee,
                                                         bool isMap);
+  bool emitMapSetKeyHash(ObjOperandId objId, ValOperandId keyId,
+                         Int32OperandId* hashId);
+  AttachDecision tryAttachMapMethod(HandleFunction callee,
+                                    InlinableNative native);
+  AttachDecision tryAttachSetMethod(HandleFunction callee,
+                                    InlinableNative native);
   AttachDecision tryAttachFinishBoundFunctionInit(HandleFunction callee);
   AttachDecision tryAttachNewArrayIterator(HandleFunction callee);
   AttachDecision tryAttachNewStringIterator(HandleFunction callee);
@@ -1762,6 +1768,7 @@ class MOZ_RAII CallIRGenerator : public IRGenerator {
   AttachDecision tryAttachAssertRecoveredOnBailout(HandleFunction callee);
   AttachDecision tryAttachObjectIs(HandleFunction callee);
   AttachDecision tryAttachObjectIsPrototypeOf(HandleFunction callee);
+  AttachDecision tryAttachObjectKeys(HandleFunction callee);
   AttachDecision tryAttachObjectToString(HandleFunction callee);
   AttachDecision tryAttachBigIntAsIntN(HandleFunction callee);
   AttachDecision tryAttachBigIntAsUintN(HandleFunction callee);
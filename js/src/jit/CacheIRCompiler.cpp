@@ -3448,6 +3448,38 @@ bool CacheIRCompiler::emitLoadDenseElementResult(ObjOperandId objId,
   return true;
 }
 
+bool CacheIRCompiler::emitLoadDenseElementInt32Result(ObjOperandId objId,
+                                                      Int32OperandId indexId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+  AutoOutputRegister output(*this);
+  Register obj = allocator.useRegister(masm, objId);
+  Register index = allocator.useRegister(masm, indexId);
+  AutoScratchRegister scratch1(allocator, masm);
+  AutoScratchRegisterMaybeOutput scratch2(allocator, masm, output);
+
+  FailurePath* failure;
+  if (!addFailurePath(&failure)) {
+    return false;
+  }
+
+  // Load obj->elements.
+  masm.loadPtr(Address(obj, NativeObject::offsetOfElements()), scratch1);
+
+  // Guard the elements contain only Int32 values.
+  Address flags(scratch1, ObjectElements::offsetOfFlags());
+  masm.branchTest32(Assembler::NonZero, flags,
+                    Imm32(ObjectElements::NON_INT32), failure->label());
+
+  // Bounds check.
+  Address initLength(scratch1, ObjectElements::offsetOfInitializedLength());
+  masm.spectreBoundsCheck32(index, initLength, scratch2, failure->label());
+
+  // No hole check needed: elements without the NON_INT32 flag are packed.
+  BaseObjectElementIndex element(scratch1, index);
+  masm.loadTypedOrValue(element, output);
+  return true;
+}
+
 bool CacheIRCompiler::emitGuardInt32IsNonNegative(Int32OperandId indexId) {
   JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
   Register index = allocator.useRegister(masm, indexId);
@@ -4167,6 +4199,258 @@ bool CacheIRCompiler::emitGetNextMapSetEntryForIteratorResult(
   return true;
 }
 
+bool CacheIRCompiler::emitMapGetResult(ObjOperandId mapId, ValOperandId keyId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoCallVM callvm(masm, this, allocator);
+
+  Register map = allocator.useRegister(masm, mapId);
+  ValueOperand key = allocator.useValueRegister(masm, keyId);
+
+  callvm.prepare();
+  masm.Push(key);
+  masm.Push(map);
+
+  using Fn =
+      bool (*)(JSContext*, HandleObject, HandleValue, MutableHandleValue);
+  callvm.call<Fn, jit::MapObjectGet>();
+  return true;
+}
+
+bool CacheIRCompiler::emitMapHasResult(ObjOperandId mapId, ValOperandId keyId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoCallVM callvm(masm, this, allocator);
+
+  Register map = allocator.useRegister(masm, mapId);
+  ValueOperand key = allocator.useValueRegister(masm, keyId);
+
+  callvm.prepare();
+  masm.Push(key);
+  masm.Push(map);
+
+  using Fn = bool (*)(JSContext*, HandleObject, HandleValue, bool*);
+  callvm.call<Fn, jit::MapObjectHas>();
+  return true;
+}
+
+bool CacheIRCompiler::emitMapSetResult(ObjOperandId mapId, ValOperandId keyId,
+                                       ValOperandId valueId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoCallVM callvm(masm, this, allocator);
+
+  Register map = allocator.useRegister(masm, mapId);
+  ValueOperand key = allocator.useValueRegister(masm, keyId);
+  ValueOperand value = allocator.useValueRegister(masm, valueId);
+
+  callvm.prepare();
+  masm.Push(value);
+  masm.Push(key);
+  masm.Push(map);
+
+  using Fn = JSObject* (*)(JSContext*, HandleObject, HandleValue, HandleValue);
+  callvm.call<Fn, jit::MapObjectSet>();
+  return true;
+}
+
+bool CacheIRCompiler::emitMapDeleteResult(ObjOperandId mapId,
+                                          ValOperandId keyId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoCallVM callvm(masm, this, allocator);
+
+  Register map = allocator.useRegister(masm, mapId);
+  ValueOperand key = allocator.useValueRegister(masm, keyId);
+
+  callvm.prepare();
+  masm.Push(key);
+  masm.Push(map);
+
+  using Fn = bool (*)(JSContext*, HandleObject, HandleValue, bool*);
+  callvm.call<Fn, jit::MapObjectDelete>();
+  return true;
+}
+
+bool CacheIRCompiler::emitSetHasResult(ObjOperandId setId,
+                                       ValOperandId valueId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoCallVM callvm(masm, this, allocator);
+
+  Register set = allocator.useRegister(masm, setId);
+  ValueOperand value = allocator.useValueRegister(masm, valueId);
+
+  callvm.prepare();
+  masm.Push(value);
+  masm.Push(set);
+
+  using Fn = bool (*)(JSContext*, HandleObject, HandleValue, bool*);
+  callvm.call<Fn, jit::SetObjectHas>();
+  return true;
+}
+
+bool CacheIRCompiler::emitSetAddResult(ObjOperandId setId,
+                                       ValOperandId valueId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoCallVM callvm(masm, this, allocator);
+
+  Register set = allocator.useRegister(masm, setId);
+  ValueOperand value = allocator.useValueRegister(masm, valueId);
+
+  callvm.prepare();
+  masm.Push(value);
+  masm.Push(set);
+
+  using Fn = JSObject* (*)(JSContext*, HandleObject, HandleValue);
+  callvm.call<Fn, jit::SetObjectAdd>();
+  return true;
+}
+
+bool CacheIRCompiler::emitSetDeleteResult(ObjOperandId setId,
+                                          ValOperandId valueId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoCallVM callvm(masm, this, allocator);
+
+  Register set = allocator.useRegister(masm, setId);
+  ValueOperand value = allocator.useValueRegister(masm, valueId);
+
+  callvm.prepare();
+  masm.Push(value);
+  masm.Push(set);
+
+  using Fn = bool (*)(JSContext*, HandleObject, HandleValue, bool*);
+  callvm.call<Fn, jit::SetObjectDelete>();
+  return true;
+}
+
+bool CacheIRCompiler::emitHashNonGCThing(ValOperandId inputId,
+                                         Int32OperandId resultId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  ValueOperand input = allocator.useValueRegister(masm, inputId);
+  Register result = allocator.defineRegister(masm, resultId);
+  AutoScratchRegister scratch(allocator, masm);
+
+  masm.prepareHashNonGCThing(input, result, scratch);
+  return true;
+}
+
+bool CacheIRCompiler::emitHashString(StringOperandId strId,
+                                     Int32OperandId resultId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  Register str = allocator.useRegister(masm, strId);
+  Register result = allocator.defineRegister(masm, resultId);
+  AutoScratchRegister scratch(allocator, masm);
+
+  FailurePath* failure;
+  if (!addFailurePath(&failure)) {
+    return false;
+  }
+
+  masm.branchTest32(Assembler::Zero, Address(str, JSString::offsetOfFlags()),
+                    Imm32(JSString::ATOM_BIT), failure->label());
+
+  masm.prepareHashString(str, result, scratch);
+  return true;
+}
+
+bool CacheIRCompiler::emitHashSymbol(SymbolOperandId symId,
+                                     Int32OperandId resultId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  Register sym = allocator.useRegister(masm, symId);
+  Register result = allocator.defineRegister(masm, resultId);
+  AutoScratchRegister scratch(allocator, masm);
+
+  masm.prepareHashSymbol(sym, result, scratch);
+  return true;
+}
+
+bool CacheIRCompiler::emitHashObject(ObjOperandId setOrMapId,
+                                     ObjOperandId objId,
+                                     Int32OperandId resultId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+#ifdef JS_PUNBOX64
+  Register setOrMap = allocator.useRegister(masm, setOrMapId);
+  Register obj = allocator.useRegister(masm, objId);
+  Register result = allocator.defineRegister(masm, resultId);
+  AutoScratchRegister scratch1(allocator, masm);
+  AutoScratchRegister scratch2(allocator, masm);
+  AutoScratchRegister scratch3(allocator, masm);
+  AutoScratchRegister scratch4(allocator, masm);
+
+  masm.prepareHashObject(setOrMap, obj, result, scratch1, scratch2, scratch3,
+                         scratch4);
+  return true;
+#else
+  MOZ_CRASH("Inline object hashing requires 64-bit registers");
+#endif
+}
+
+bool CacheIRCompiler::emitSetHasNonBigIntResult(ObjOperandId setId,
+                                                ValOperandId valueId,
+                                                Int32OperandId hashId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoOutputRegister output(*this);
+  Register set = allocator.useRegister(masm, setId);
+  ValueOperand value = allocator.useValueRegister(masm, valueId);
+  Register hash = allocator.useRegister(masm, hashId);
+  AutoScratchRegister scratch1(allocator, masm);
+  AutoScratchRegister scratch2(allocator, masm);
+  AutoScratchRegisterMaybeOutput scratch3(allocator, masm, output);
+
+  masm.move32(hash, scratch3);
+  masm.setObjectHas(set, value, scratch3, scratch3, scratch1, scratch2);
+  masm.tagValue(JSVAL_TYPE_BOOLEAN, scratch3, output.valueReg());
+  return true;
+}
+
+bool CacheIRCompiler::emitMapHasNonBigIntResult(ObjOperandId mapId,
+                                                ValOperandId keyId,
+                                                Int32OperandId hashId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoOutputRegister output(*this);
+  Register map = allocator.useRegister(masm, mapId);
+  ValueOperand key = allocator.useValueRegister(masm, keyId);
+  Register hash = allocator.useRegister(masm, hashId);
+  AutoScratchRegister scratch1(allocator, masm);
+  AutoScratchRegister scratch2(allocator, masm);
+  AutoScratchRegisterMaybeOutput scratch3(allocator, masm, output);
+
+  masm.move32(hash, scratch3);
+  masm.mapObjectHas(map, key, scratch3, scratch3, scratch1, scratch2);
+  masm.tagValue(JSVAL_TYPE_BOOLEAN, scratch3, output.valueReg());
+  return true;
+}
+
+bool CacheIRCompiler::emitMapGetNonBigIntResult(ObjOperandId mapId,
+                                                ValOperandId keyId,
+                                                Int32OperandId hashId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoOutputRegister output(*this);
+  Register map = allocator.useRegister(masm, mapId);
+  ValueOperand key = allocator.useValueRegister(masm, keyId);
+  Register hash = allocator.useRegister(masm, hashId);
+  AutoScratchRegister scratch1(allocator, masm);
+  AutoScratchRegister scratch2(allocator, masm);
+  AutoScratchRegisterMaybeOutput scratch3(allocator, masm, output);
+
+  // |mapObjectGet| only writes the output once |hash| is no longer needed,
+  // so the hash can live in the output register.
+  masm.move32(hash, scratch3);
+  masm.mapObjectGet(map, key, scratch3, output.valueReg(), scratch1,
+                    scratch2);
+  return true;
+}
+
 bool CacheIRCompiler::emitFinishBoundFunctionInitResult(
     ObjOperandId boundId, ObjOperandId targetId, Int32OperandId argCountId) {
   JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
@@ -4247,6 +4531,20 @@ bool CacheIRCompiler::emitObjectCreateResult(uint32_t templateObjectOffset) {
   return true;
 }
 
+bool CacheIRCompiler::emitObjectKeysResult(ObjOperandId objId) {
+  JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
+
+  AutoCallVM callvm(masm, this, allocator);
+  Register obj = allocator.useRegister(masm, objId);
+
+  callvm.prepare();
+  masm.Push(obj);
+
+  using Fn = JSObject* (*)(JSContext*, HandleObject);
+  callvm.call<Fn, ObjectKeys>();
+  return true;
+}
+
 bool CacheIRCompiler::emitNewArrayFromLengthResult(
     uint32_t templateObjectOffset, Int32OperandId lengthId) {
   JitSpew(JitSpew_Codegen, "%s", __FUNCTION__);
@@ -4875,6 +5173,8 @@ bool CacheIRCompiler::emitMathFunctionNumberResult(NumberOperandId inputId,
 static void EmitStoreDenseElement(MacroAssembler& masm,
                                   const ConstantOrRegister& value,
                                   BaseObjectElementIndex target) {
+  masm.markElementsNonInt32IfNeeded(target.base, value);
+
   if (value.constant()) {
     Value v = value.value();
     masm.storeValue(v, target);
@@ -5117,6 +5417,7 @@ bool CacheIRCompiler::emitArrayPush(ObjOperandId objId, ValOperandId rhsId) {
 
   // Store the value.
   BaseObjectElementIndex element(scratch, scratchLength);
+  masm.markElementsNonInt32IfNeeded(scratch, val);
   masm.storeValue(val, element);
   emitPostBarrierElement(obj, val, scratch, scratchLength);
 
@@ -2129,6 +2129,47 @@ static bool PrepareAndExecuteRegExp(JSContext* cx, MacroAssembler& masm,
   // Update lastIndex if necessary.
   StepBackToLeadSurrogate(masm, regexpReg, input, lastIndex, temp2, temp3);
 
+  // If every match contains a particular literal, or starts with one of a few
+  // characters, search for that first. This either rules out a match or lets
+  // us skip ahead in the input, and is much faster than trying to match at
+  // every position.
+  masm.storePtr(lastIndex, startIndexAddress);
+  {
+    Label prefilter, noPrefilter;
+    masm.branchPtr(Assembler::NotEqual,
+                   Address(regexpReg, RegExpShared::offsetOfRequiredLiteral()),
+                   ImmWord(0), &prefilter);
+    masm.branch32(Assembler::Equal,
+                  Address(regexpReg, RegExpShared::offsetOfFirstCharCount()),
+                  Imm32(0), &noPrefilter);
+    masm.bind(&prefilter);
+
+    LiveGeneralRegisterSet regsToSave(GeneralRegisterSet::Volatile());
+    regsToSave.takeUnchecked(temp2);
+    regsToSave.takeUnchecked(temp3);
+
+    masm.computeEffectiveAddress(startIndexAddress, temp3);
+
+    masm.PushRegsInMask(regsToSave);
+    using Fn =
+        bool (*)(RegExpShared * re, JSLinearString * input, size_t * start);
+    masm.setupUnalignedABICall(temp2);
+    masm.passABIArg(regexpReg);
+    masm.passABIArg(input);
+    masm.passABIArg(temp3);
+    masm.callWithABI<Fn, js::RegExpSkipToPossibleMatchRaw>();
+
+    masm.storeCallBoolResult(temp2);
+    masm.PopRegsInMask(regsToSave);
+
+    masm.branchIfFalseBool(temp2, notFound);
+    masm.bind(&noPrefilter);
+  }
+
+  // Keep the code alive across shrinking GCs while the regexp is in use.
+  masm.store32(Imm32(0),
+               Address(regexpReg, RegExpShared::offsetOfGCsSinceExecution()));
+
   // Load code pointer and length of input (in bytes).
   // Store the input start in the InputOutputData.
   Register codePointer = temp1;  // Note: temp1 was previously regexpReg.
@@ -2173,7 +2214,6 @@ static bool PrepareAndExecuteRegExp(JSContext* cx, MacroAssembler& masm,
   // Finish filling in the InputOutputData instance on the stack
   masm.computeEffectiveAddress(matchPairsAddress, temp2);
   masm.storePtr(temp2, matchesAddress);
-  masm.storePtr(lastIndex, startIndexAddress);
 
   // Save any volatile inputs.
   LiveGeneralRegisterSet volatileRegs;
@@ -2215,7 +2255,9 @@ static bool PrepareAndExecuteRegExp(JSContext* cx, MacroAssembler& masm,
   masm.bind(&checkSuccess);
   masm.branch32(Assembler::Equal, temp1,
                 Imm32(RegExpRunStatus_Success_NotFound), notFound);
-  masm.branch32(Assembler::Equal, temp1, Imm32(RegExpRunStatus_Error), failure);
+  // Errors, and falling back to the linear-time engine, are handled in the VM.
+  static_assert(RegExpRunStatus_Error < 0 && RegExpRunStatus_Fallback < 0);
+  masm.branch32(Assembler::LessThan, temp1, Imm32(0), failure);
 
   // Lazily update the RegExpStatics.
   RegExpStatics* res = GlobalObject::getRegExpStatics(cx, cx->global());
@@ -2743,7 +2785,11 @@ JitCode* JitRealm::generateRegExpMatcherStub(JSContext* cx) {
     masm.bind(&done);
   }
 
-  // Fill in the rest of the output object.
+  // Fill in the rest of the output object. The match elements are strings or
+  // undefined, so they're never all Int32 values.
+  masm.or32(
+      Imm32(ObjectElements::NON_INT32),
+      Address(object, elementsOffset + ObjectElements::offsetOfFlags()));
   masm.store32(
       matchIndex,
       Address(object,
@@ -4838,18 +4884,20 @@ void CodeGenerator::emitPostWriteBarrier(const LAllocation* obj) {
   EmitPostWriteBarrier(masm, gen->runtime, objreg, object, isGlobal, regs);
 }
 
-void CodeGenerator::emitPostWriteBarrier(Register objreg) {
-  AllocatableGeneralRegisterSet regs(GeneralRegisterSet::Volatile());
-  regs.takeUnchecked(objreg);
-  EmitPostWriteBarrier(masm, gen->runtime, objreg, nullptr, false, regs);
-}
-
 void CodeGenerator::visitOutOfLineCallPostWriteBarrier(
     OutOfLineCallPostWriteBarrier* ool) {
-  saveLiveVolatile(ool->lir());
   const LAllocation* obj = ool->object();
-  emitPostWriteBarrier(obj);
-  restoreLiveVolatile(ool->lir());
+  if (obj->isConstant()) {
+    // Constant objects have an inline fast path, see EmitPostWriteBarrier.
+    saveLiveVolatile(ool->lir());
+    emitPostWriteBarrier(obj);
+    restoreLiveVolatile(ool->lir());
+  } else {
+    LiveRegisterSet floats = liveVolatileFloatRegs(ool->lir());
+    masm.PushRegsInMask(floats);
+    masm.callPostBarrierStub(ToRegister(obj));
+    masm.PopRegsInMask(floats);
+  }
 
   masm.jump(ool->rejoin());
 }
@@ -4982,23 +5030,27 @@ class OutOfLineCallPostWriteElementBarrier
 
 void CodeGenerator::visitOutOfLineCallPostWriteElementBarrier(
     OutOfLineCallPostWriteElementBarrier* ool) {
-  saveLiveVolatile(ool->lir());
-
   const LAllocation* obj = ool->object();
   const LAllocation* index = ool->index();
 
-  Register objreg = obj->isConstant() ? InvalidReg : ToRegister(obj);
+  if (!obj->isConstant()) {
+    LiveRegisterSet floats = liveVolatileFloatRegs(ool->lir());
+    masm.PushRegsInMask(floats);
+    masm.callPostElementBarrierStub(ToRegister(obj), ToRegister(index));
+    masm.PopRegsInMask(floats);
+    masm.jump(ool->rejoin());
+    return;
+  }
+
+  saveLiveVolatile(ool->lir());
+
   Register indexreg = ToRegister(index);
 
   AllocatableGeneralRegisterSet regs(GeneralRegisterSet::Volatile());
   regs.takeUnchecked(indexreg);
 
-  if (obj->isConstant()) {
-    objreg = regs.takeAny();
-    masm.movePtr(ImmGCPtr(&obj->toConstant()->toObject()), objreg);
-  } else {
-    regs.takeUnchecked(objreg);
-  }
+  Register objreg = regs.takeAny();
+  masm.movePtr(ImmGCPtr(&obj->toConstant()->toObject()), objreg);
 
   Register runtimereg = regs.takeAny();
   using Fn = void (*)(JSRuntime * rt, JSObject * obj, int32_t index);
@@ -7757,6 +7809,15 @@ static inline void RangeDestruct(MacroAssembler& masm, Register iter,
   masm.bind(&nurseryAllocated);
 }
 
+void CodeGenerator::callPostBarrierStubForIterator(Register result) {
+  // LGetNextEntryForIterator has no safepoint, so we don't know which float
+  // registers are live. This is only reached when a nursery value is copied.
+  LiveRegisterSet floats(GeneralRegisterSet(), FloatRegisterSet::Volatile());
+  masm.PushRegsInMask(floats);
+  masm.callPostBarrierStub(result);
+  masm.PopRegsInMask(floats);
+}
+
 template <>
 void CodeGenerator::emitLoadIteratorValues<ValueMap>(Register result,
                                                      Register temp,
@@ -7777,12 +7838,8 @@ void CodeGenerator::emitLoadIteratorValues<ValueMap>(Register result,
                                 &emitBarrier);
   masm.branchValueIsNurseryCell(Assembler::NotEqual, valueAddress, temp,
                                 &skipBarrier);
-  {
-    masm.bind(&emitBarrier);
-    saveVolatile(temp);
-    emitPostWriteBarrier(result);
-    restoreVolatile(temp);
-  }
+  masm.bind(&emitBarrier);
+  callPostBarrierStubForIterator(result);
   masm.bind(&skipBarrier);
 }
 
@@ -7800,11 +7857,7 @@ void CodeGenerator::emitLoadIteratorValues<ValueSet>(Register result,
   Label skipBarrier;
   masm.branchValueIsNurseryCell(Assembler::NotEqual, keyAddress, temp,
                                 &skipBarrier);
-  {
-    saveVolatile(temp);
-    emitPostWriteBarrier(result);
-    restoreVolatile(temp);
-  }
+  callPostBarrierStubForIterator(result);
   masm.bind(&skipBarrier);
 }
 
@@ -7872,6 +7925,197 @@ void CodeGenerator::emitGetNextEntryForIterator(LGetNextEntryForIterator* lir) {
   masm.bind(&done);
 }
 
+void CodeGenerator::visitNewArrayCopy(LNewArrayCopy* lir) {
+  pushArg(ImmGCPtr(lir->mir()->templateObject()));
+
+  using Fn = ArrayObject* (*)(JSContext*, Handle<ArrayObject*>);
+  callVM<Fn, NewArrayCopyOperation>(lir);
+}
+
+void CodeGenerator::visitObjectKeys(LObjectKeys* lir) {
+  Register object = ToRegister(lir->object());
+
+  pushArg(object);
+
+  using Fn = JSObject* (*)(JSContext*, HandleObject);
+  callVM<Fn, ObjectKeys>(lir);
+}
+
+void CodeGenerator::visitObjectKeysLength(LObjectKeysLength* lir) {
+  Register object = ToRegister(lir->object());
+
+  pushArg(object);
+
+  using Fn = bool (*)(JSContext*, HandleObject, int32_t*);
+  callVM<Fn, ObjectKeysLength>(lir);
+}
+
+void CodeGenerator::visitMapObjectGet(LMapObjectGet* lir) {
+  Register map = ToRegister(lir->map());
+  ValueOperand key = ToValue(lir, LMapObjectGet::KeyIndex);
+
+  pushArg(key);
+  pushArg(map);
+
+  using Fn =
+      bool (*)(JSContext*, HandleObject, HandleValue, MutableHandleValue);
+  callVM<Fn, jit::MapObjectGet>(lir);
+}
+
+void CodeGenerator::visitMapObjectHas(LMapObjectHas* lir) {
+  Register map = ToRegister(lir->map());
+  ValueOperand key = ToValue(lir, LMapObjectHas::KeyIndex);
+
+  pushArg(key);
+  pushArg(map);
+
+  using Fn = bool (*)(JSContext*, HandleObject, HandleValue, bool*);
+  callVM<Fn, jit::MapObjectHas>(lir);
+}
+
+void CodeGenerator::visitMapObjectSet(LMapObjectSet* lir) {
+  Register map = ToRegister(lir->map());
+  ValueOperand key = ToValue(lir, LMapObjectSet::KeyIndex);
+  ValueOperand value = ToValue(lir, LMapObjectSet::ValueIndex);
+
+  pushArg(value);
+  pushArg(key);
+  pushArg(map);
+
+  using Fn = JSObject* (*)(JSContext*, HandleObject, HandleValue, HandleValue);
+  callVM<Fn, jit::MapObjectSet>(lir);
+}
+
+void CodeGenerator::visitMapObjectDelete(LMapObjectDelete* lir) {
+  Register map = ToRegister(lir->map());
+  ValueOperand key = ToValue(lir, LMapObjectDelete::KeyIndex);
+
+  pushArg(key);
+  pushArg(map);
+
+  using Fn = bool (*)(JSContext*, HandleObject, HandleValue, bool*);
+  callVM<Fn, jit::MapObjectDelete>(lir);
+}
+
+void CodeGenerator::visitSetObjectHas(LSetObjectHas* lir) {
+  Register set = ToRegister(lir->set());
+  ValueOperand value = ToValue(lir, LSetObjectHas::ValueIndex);
+
+  pushArg(value);
+  pushArg(set);
+
+  using Fn = bool (*)(JSContext*, HandleObject, HandleValue, bool*);
+  callVM<Fn, jit::SetObjectHas>(lir);
+}
+
+void CodeGenerator::visitSetObjectAdd(LSetObjectAdd* lir) {
+  Register set = ToRegister(lir->set());
+  ValueOperand value = ToValue(lir, LSetObjectAdd::ValueIndex);
+
+  pushArg(value);
+  pushArg(set);
+
+  using Fn = JSObject* (*)(JSContext*, HandleObject, HandleValue);
+  callVM<Fn, jit::SetObjectAdd>(lir);
+}
+
+void CodeGenerator::visitSetObjectDelete(LSetObjectDelete* lir) {
+  Register set = ToRegister(lir->set());
+  ValueOperand value = ToValue(lir, LSetObjectDelete::ValueIndex);
+
+  pushArg(value);
+  pushArg(set);
+
+  using Fn = bool (*)(JSContext*, HandleObject, HandleValue, bool*);
+  callVM<Fn, jit::SetObjectDelete>(lir);
+}
+
+void CodeGenerator::visitHashNonGCThing(LHashNonGCThing* ins) {
+  ValueOperand input = ToValue(ins, LHashNonGCThing::Input);
+  Register temp = ToRegister(ins->temp());
+  Register output = ToRegister(ins->output());
+
+  masm.prepareHashNonGCThing(input, output, temp);
+}
+
+void CodeGenerator::visitHashString(LHashString* ins) {
+  Register input = ToRegister(ins->input());
+  Register temp = ToRegister(ins->temp());
+  Register output = ToRegister(ins->output());
+
+  // HashableValue atomizes strings, so non-atoms can't be in the table under
+  // their own address.
+  Label bail;
+  masm.branchTest32(Assembler::Zero, Address(input, JSString::offsetOfFlags()),
+                    Imm32(JSString::ATOM_BIT), &bail);
+  bailoutFrom(&bail, ins->snapshot());
+
+  masm.prepareHashString(input, output, temp);
+}
+
+void CodeGenerator::visitHashSymbol(LHashSymbol* ins) {
+  Register input = ToRegister(ins->input());
+  Register temp = ToRegister(ins->temp());
+  Register output = ToRegister(ins->output());
+
+  masm.prepareHashSymbol(input, output, temp);
+}
+
+void CodeGenerator::visitHashObject(LHashObject* ins) {
+#ifdef JS_PUNBOX64
+  Register setOrMap = ToRegister(ins->setOrMap());
+  Register input = ToRegister(ins->input());
+  Register temp1 = ToRegister(ins->temp1());
+  Register temp2 = ToRegister(ins->temp2());
+  Register temp3 = ToRegister(ins->temp3());
+  Register temp4 = ToRegister(ins->temp4());
+  Register output = ToRegister(ins->output());
+
+  masm.prepareHashObject(setOrMap, input, output, temp1, temp2, temp3, temp4);
+#else
+  MOZ_CRASH("Inline object hashing requires 64-bit registers");
+#endif
+}
+
+void CodeGenerator::visitSetObjectHasNonBigInt(LSetObjectHasNonBigInt* ins) {
+  Register set = ToRegister(ins->set());
+  ValueOperand value = ToValue(ins, LSetObjectHasNonBigInt::ValueIndex);
+  Register hash = ToRegister(ins->hash());
+  Register temp1 = ToRegister(ins->temp1());
+  Register temp2 = ToRegister(ins->temp2());
+  Register temp3 = ToRegister(ins->temp3());
+  Register output = ToRegister(ins->output());
+
+  masm.move32(hash, temp1);
+  masm.setObjectHas(set, value, temp1, output, temp2, temp3);
+}
+
+void CodeGenerator::visitMapObjectHasNonBigInt(LMapObjectHasNonBigInt* ins) {
+  Register map = ToRegister(ins->map());
+  ValueOperand key = ToValue(ins, LMapObjectHasNonBigInt::KeyIndex);
+  Register hash = ToRegister(ins->hash());
+  Register temp1 = ToRegister(ins->temp1());
+  Register temp2 = ToRegister(ins->temp2());
+  Register temp3 = ToRegister(ins->temp3());
+  Register output = ToRegister(ins->output());
+
+  masm.move32(hash, temp1);
+  masm.mapObjectHas(map, key, temp1, output, temp2, temp3);
+}
+
+void CodeGenerator::visitMapObjectGetNonBigInt(LMapObjectGetNonBigInt* ins) {
+  Register map = ToRegister(ins->map());
+  ValueOperand key = ToValue(ins, LMapObjectGetNonBigInt::KeyIndex);
+  Register hash = ToRegister(ins->hash());
+  Register temp1 = ToRegister(ins->temp1());
+  Register temp2 = ToRegister(ins->temp2());
+  Register temp3 = ToRegister(ins->temp3());
+  ValueOperand output = ToOutValue(ins);
+
+  masm.move32(hash, temp1);
+  masm.mapObjectGet(map, key, temp1, output, temp2, temp3);
+}
+
 void CodeGenerator::visitGetNextEntryForIterator(
     LGetNextEntryForIterator* lir) {
   if (lir->mir()->mode() == MGetNextEntryForIterator::Map) {
@@ -10255,6 +10499,71 @@ void JitRuntime::generateFreeStub(MacroAssembler& masm) {
   masm.ret();
 }
 
+void JitRuntime::generatePostBarrierStub(JSContext* cx, MacroAssembler& masm) {
+  // This register must match the one in MacroAssembler::callPostBarrierStub.
+  const Register regObj = CallTempReg0;
+
+  postBarrierStubOffset_ = startTrampolineCode(masm);
+
+#ifdef JS_USE_LINK_REGISTER
+  masm.pushReturnAddress();
+#endif
+  // Float registers are saved by the callers, which know which ones are live.
+  AllocatableGeneralRegisterSet regs(GeneralRegisterSet::Volatile());
+  LiveRegisterSet save(GeneralRegisterSet::Volatile(), FloatRegisterSet());
+  masm.PushRegsInMask(save);
+
+  regs.takeUnchecked(regObj);
+  Register runtimeReg = regs.takeAny();
+  Register temp = regs.takeAny();
+
+  using Fn = void (*)(JSRuntime * rt, js::gc::Cell * obj);
+  masm.movePtr(ImmPtr(cx->runtime()), runtimeReg);
+  masm.setupUnalignedABICall(temp);
+  masm.passABIArg(runtimeReg);
+  masm.passABIArg(regObj);
+  masm.callWithABI<Fn, PostWriteBarrier>();
+
+  masm.PopRegsInMask(save);
+
+  masm.ret();
+}
+
+void JitRuntime::generatePostElementBarrierStub(JSContext* cx,
+                                                MacroAssembler& masm) {
+  // These registers must match the ones in
+  // MacroAssembler::callPostElementBarrierStub.
+  const Register regObj = CallTempReg0;
+  const Register regIndex = CallTempReg1;
+
+  postElementBarrierStubOffset_ = startTrampolineCode(masm);
+
+#ifdef JS_USE_LINK_REGISTER
+  masm.pushReturnAddress();
+#endif
+  // Float registers are saved by the callers, which know which ones are live.
+  AllocatableGeneralRegisterSet regs(GeneralRegisterSet::Volatile());
+  LiveRegisterSet save(GeneralRegisterSet::Volatile(), FloatRegisterSet());
+  masm.PushRegsInMask(save);
+
+  regs.takeUnchecked(regObj);
+  regs.takeUnchecked(regIndex);
+  Register runtimeReg = regs.takeAny();
+  Register temp = regs.takeAny();
+
+  using Fn = void (*)(JSRuntime * rt, JSObject * obj, int32_t index);
+  masm.movePtr(ImmPtr(cx->runtime()), runtimeReg);
+  masm.setupUnalignedABICall(temp);
+  masm.passABIArg(runtimeReg);
+  masm.passABIArg(regObj);
+  masm.passABIArg(regIndex);
+  masm.callWithABI<Fn, PostWriteElementBarrier<IndexInBounds::Maybe>>();
+
+  masm.PopRegsInMask(save);
+
+  masm.ret();
+}
+
 void JitRuntime::generateLazyLinkStub(MacroAssembler& masm) {
   lazyLinkStubOffset_ = startTrampolineCode(masm);
 
@@ -10819,6 +11128,7 @@ void CodeGenerator::emitStoreElementTyped(const LAllocation* value,
                                           const LAllocation* index) {
   MOZ_ASSERT(valueType != MIRType::MagicHole);
   ConstantOrRegister v = ToConstantOrRegister(value, valueType);
+  masm.markElementsNonInt32IfNeeded(elements, v);
   if (index->isConstant()) {
     Address dest(elements, ToInt32(index) * sizeof(js::Value));
     masm.storeUnboxedValue(v, valueType, dest, elementType);
@@ -10857,6 +11167,8 @@ void CodeGenerator::visitStoreElementV(LStoreElementV* lir) {
     emitStoreHoleCheck(elements, index, lir->snapshot());
   }
 
+  masm.markElementsNonInt32IfNeeded(elements, value);
+
   if (lir->index()->isConstant()) {
     Address dest(elements, ToInt32(lir->index()) * sizeof(js::Value));
     masm.storeValue(value, dest);
@@ -10871,7 +11183,8 @@ void CodeGenerator::visitStoreHoleValueElement(LStoreHoleValueElement* lir) {
   Register index = ToRegister(lir->index());
 
   Address elementsFlags(elements, ObjectElements::offsetOfFlags());
-  masm.or32(Imm32(ObjectElements::NON_PACKED), elementsFlags);
+  masm.or32(Imm32(ObjectElements::NON_PACKED | ObjectElements::NON_INT32),
+            elementsFlags);
 
   BaseObjectElementIndex element(elements, index);
   masm.storeValue(MagicValue(JS_ELEMENTS_HOLE), element);
@@ -10918,6 +11231,7 @@ void CodeGenerator::visitStoreElementHoleV(LStoreElementHoleV* lir) {
   }
 
   masm.bind(ool->rejoinStore());
+  masm.markElementsNonInt32IfNeeded(elements, value);
   masm.storeValue(value, BaseObjectElementIndex(elements, index));
 
   masm.bind(ool->rejoin());
@@ -11073,6 +11387,7 @@ void CodeGenerator::visitArrayPush(LArrayPush* lir) {
   masm.spectreBoundsCheck32(length, capacity, spectreTemp, ool->entry());
 
   // Do the store.
+  masm.markElementsNonInt32IfNeeded(elementsTemp, value);
   masm.storeValue(value, BaseObjectElementIndex(elementsTemp, length));
 
   masm.add32(Imm32(1), length);
@@ -14932,6 +15247,16 @@ void CodeGenerator::visitGuardArrayIsPacked(LGuardArrayIsPacked* lir) {
   bailoutFrom(&bail, lir->snapshot());
 }
 
+void CodeGenerator::visitGuardElementsAreInt32(LGuardElementsAreInt32* lir) {
+  Register elements = ToRegister(lir->elements());
+
+  Label bail;
+  Address flags(elements, ObjectElements::offsetOfFlags());
+  masm.branchTest32(Assembler::NonZero, flags,
+                    Imm32(ObjectElements::NON_INT32), &bail);
+  bailoutFrom(&bail, lir->snapshot());
+}
+
 void CodeGenerator::visitGetPrototypeOf(LGetPrototypeOf* lir) {
   Register target = ToRegister(lir->target());
   ValueOperand out = ToOutValue(lir);
@@ -159,7 +159,6 @@ class CodeGenerator final : public CodeGeneratorSpecific {
 
  private:
   void emitPostWriteBarrier(const LAllocation* obj);
-  void emitPostWriteBarrier(Register objreg);
   void emitPostWriteBarrierS(Address address, Register prev, Register next);
 
   template <class LPostBarrierType, MIRType nurseryType>
@@ -238,6 +237,7 @@ class CodeGenerator final : public CodeGeneratorSpecific {
   template <class IteratorObject, class OrderedHashTable>
   void emitGetNextEntryForIterator(LGetNextEntryForIterator* lir);
 
+  void callPostBarrierStubForIterator(Register result);
   template <class OrderedHashTable>
   void emitLoadIteratorValues(Register result, Register temp, Register front);
 
@@ -44,6 +44,11 @@ class ICState {
   // Baseline IC.
   bool usedByTranspiler_ : 1;
 
+  // Whether Ion code transpiled from this Baseline IC kept bailing out in a
+  // way that recompiling doesn't fix. WarpOracle won't transpile this IC
+  // again.
+  bool hadUnfixableBailouts_ : 1;
+
   // Number of optimized stubs currently attached to this IC.
   uint8_t numOptimizedStubs_;
 
@@ -123,6 +128,7 @@ class ICState {
 #endif
     trialInliningState_ = uint32_t(TrialInliningState::Initial);
     usedByTranspiler_ = false;
+    hadUnfixableBailouts_ = false;
     numOptimizedStubs_ = 0;
     numFailures_ = 0;
   }
@@ -155,6 +161,9 @@ class ICState {
   void setUsedByTranspiler() { usedByTranspiler_ = true; }
   bool usedByTranspiler() const { return usedByTranspiler_; }
 
+  void setHadUnfixableBailouts() { hadUnfixableBailouts_ = true; }
+  bool hadUnfixableBailouts() const { return hadUnfixableBailouts_; }
+
   TrialInliningState trialInliningState() const {
     return TrialInliningState(trialInliningState_);
   }
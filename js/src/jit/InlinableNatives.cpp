@@ -260,8 +260,15 @@ bool js::jit::CanInlineNativeCrossRealm(InlinableNative native) {
     case InlinableNative::DataViewSetFloat64:
     case InlinableNative::DataViewSetBigInt64:
     case InlinableNative::DataViewSetBigUint64:
+    case InlinableNative::MapGet:
+    case InlinableNative::MapHas:
+    case InlinableNative::MapSet:
+    case InlinableNative::MapDelete:
     case InlinableNative::NumberToString:
     case InlinableNative::ReflectGetPrototypeOf:
+    case InlinableNative::SetHas:
+    case InlinableNative::SetAdd:
+    case InlinableNative::SetDelete:
     case InlinableNative::String:
     case InlinableNative::StringToString:
     case InlinableNative::StringValueOf:
@@ -275,6 +282,7 @@ bool js::jit::CanInlineNativeCrossRealm(InlinableNative native) {
     case InlinableNative::ObjectCreate:
     case InlinableNative::ObjectIs:
     case InlinableNative::ObjectIsPrototypeOf:
+    case InlinableNative::ObjectKeys:
     case InlinableNative::ObjectToString:
     case InlinableNative::TypedArrayConstructor:
       // Default to false for most natives.
@@ -99,10 +99,19 @@
   _(MathTrunc)                                     \
   _(MathCbrt)                                      \
                                                    \
+  _(MapGet)                                        \
+  _(MapHas)                                        \
+  _(MapSet)                                        \
+  _(MapDelete)                                     \
+                                                   \
   _(NumberToString)                                \
                                                    \
   _(ReflectGetPrototypeOf)                         \
                                                    \
+  _(SetHas)                                        \
+  _(SetAdd)                                        \
+  _(SetDelete)                                     \
+                                                   \
   _(RegExpMatcher)                                 \
   _(RegExpSearcher)                                \
   _(RegExpTester)                                  \
@@ -129,6 +138,7 @@
   _(ObjectCreate)                                  \
   _(ObjectIs)                                      \
   _(ObjectIsPrototypeOf)                           \
+  _(ObjectKeys)                                    \
   _(ObjectToString)                                \
                                                    \
   _(TestBailout)                                   \
@@ -208,6 +208,10 @@ bool JitRuntime::generateTrampolines(JSContext* cx) {
   JitSpew(JitSpew_Codegen, "# Emitting free stub");
   generateFreeStub(masm);
 
+  JitSpew(JitSpew_Codegen, "# Emitting post barrier stubs");
+  generatePostBarrierStub(cx, masm);
+  generatePostElementBarrierStub(cx, masm);
+
   JitSpew(JitSpew_Codegen, "# Emitting lazy link stub");
   generateLazyLinkStub(masm);
 
@@ -2047,6 +2051,28 @@ static MethodStatus BaselineCanEnterAtEntry(JSContext* cx, HandleScript script,
   return Method_Compiled;
 }
 
+// Whether a frame that's running the loop at |pc| can still get to the loop
+// head |osrPc| later on: either |osrPc| comes after |pc|, or both are inside
+// the same loop.
+static bool CanReachOsrLoopHead(JSScript* script, jsbytecode* osrPc,
+                                jsbytecode* pc) {
+  MOZ_ASSERT(osrPc != pc);
+  if (osrPc > pc) {
+    return true;
+  }
+
+  for (BytecodeLocation loc : AllBytecodesIterable(script)) {
+    if (!loc.isBackedge()) {
+      continue;
+    }
+    if (loc.getJumpTarget().toRawBytecode() <= osrPc &&
+        loc.toRawBytecode() >= pc) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // Decide if a transition from baseline execution to Ion code should occur.
 // May compile or recompile the target JSScript.
 static MethodStatus BaselineCanEnterAtBranch(JSContext* cx, HandleScript script,
@@ -2085,12 +2111,21 @@ static MethodStatus BaselineCanEnterAtBranch(JSContext* cx, HandleScript script,
   // By default a recompilation doesn't happen on osr mismatch.
   // Decide if we want to force a recompilation if this happens too much.
   if (script->hasIonScript()) {
-    if (pc == script->ionScript()->osrPc()) {
+    IonScript* ion = script->ionScript();
+    if (pc == ion->osrPc()) {
       return Method_Compiled;
     }
 
-    uint32_t count = script->ionScript()->incrOsrPcMismatchCounter();
-    if (count <= JitOptions.osrPcMismatchesBeforeRecompile &&
+    // Usually we wait for a while before recompiling, in case this frame gets
+    // to the loop the IonScript was compiled for. On the first mismatch, check
+    // whether that's possible at all. When a script runs several hot loops one
+    // after another, the loop we compiled for has often finished by the time
+    // the off-thread compilation is done.
+    uint32_t count = ion->incrOsrPcMismatchCounter();
+    bool osrLoopUnreachable = count == 1 && ion->osrPc() &&
+                              !CanReachOsrLoopHead(script, ion->osrPc(), pc);
+    if (!osrLoopUnreachable &&
+        count <= JitOptions.osrPcMismatchesBeforeRecompile &&
         !JitOptions.eagerIonCompilation()) {
       return Method_Skipped;
     }
@@ -603,6 +603,7 @@ class SnapshotIterator {
 
 #ifdef TRACK_SNAPSHOTS
   void spewBailingFrom() const { snapshot_.spewBailingFrom(); }
+  uint32_t mirOpcode() const { return snapshot_.mirOpcode(); }
 #endif
 };
 
@@ -62,6 +62,13 @@ JitContext::JitContext(CompileRuntime* rt, CompileRealm* realm,
   SetJitContext(this);
 }
 
+JitContext::JitContext(CompileRuntime* rt, TempAllocator* temp)
+    : prev_(CurrentJitContext()), temp(temp), runtime(rt) {
+  MOZ_ASSERT(rt);
+  MOZ_ASSERT(temp);
+  SetJitContext(this);
+}
+
 JitContext::JitContext(JSContext* cx, TempAllocator* temp)
     : prev_(CurrentJitContext()),
       realm_(CompileRealm::get(cx->realm())),
@@ -109,6 +109,10 @@ class JitContext {
   // Constructor for off-thread Ion compilations.
   JitContext(CompileRuntime* rt, CompileRealm* realm, TempAllocator* temp);
 
+  // Constructor for off-thread compilations of code which doesn't belong to a
+  // realm, like regexp code, which is shared by all realms in a zone.
+  JitContext(CompileRuntime* rt, TempAllocator* temp);
+
   // Constructors for Wasm compilation.
   explicit JitContext(TempAllocator* temp);
   JitContext();
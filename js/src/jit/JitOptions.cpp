@@ -163,6 +163,11 @@ DefaultJitOptions::DefaultJitOptions() {
   // Duplicated in all.js - ensure both match.
   SET_DEFAULT(baselineJitWarmUpThreshold, 100);
 
+  // Scripts with more bytecode than this need proportionally more warm-up
+  // before they are compiled with the baseline compiler, up to
+  // BaselineMaxWarmUpScale times as much. Zero disables the scaling.
+  SET_DEFAULT(baselineJitLargeScriptSize, 4 * 1000);
+
   // How many invocations or loop iterations are needed before functions
   // are considered for trial inlining.
   SET_DEFAULT(trialInliningWarmUpThreshold, 500);
@@ -183,10 +188,26 @@ DefaultJitOptions::DefaultJitOptions() {
   // Duplicated in all.js - ensure both match.
   SET_DEFAULT(normalIonWarmUpThreshold, 1500);
 
+  // How many invocations or loop iterations are needed after a Baseline IC
+  // stub is attached before the script is compiled with the Ion compiler.
+  // Ion compiles scripts based on their IC stubs, so this avoids compiling
+  // before those have settled.
+  SET_DEFAULT(ionWarmUpAfterStubAttach, 100);
+
   // How many invocations are needed before regexps are compiled to
   // native code.
   SET_DEFAULT(regexpWarmUpThreshold, 10);
 
+  // How many times a regexp may backtrack in a single execution before we
+  // give up and rerun it with the linear-time engine. Only applies to regexps
+  // the linear-time engine supports. Zero disables the fallback.
+  SET_DEFAULT(regexpBacktrackLimit, 50000);
+
+  // Regexps whose source is at least this long are compiled to native code on
+  // a helper thread, and interpreted until the code is ready. Zero disables
+  // off-thread regexp compilation.
+  SET_DEFAULT(regexpOffThreadCompileMinLength, 1000);
+
   // Number of exception bailouts (resuming into catch/finally block) before
   // we invalidate and forbid Ion compilation.
   SET_DEFAULT(exceptionBailoutThreshold, 10);
@@ -83,10 +83,14 @@ struct DefaultJitOptions {
 #endif
   uint32_t baselineInterpreterWarmUpThreshold;
   uint32_t baselineJitWarmUpThreshold;
+  uint32_t baselineJitLargeScriptSize;
   uint32_t trialInliningWarmUpThreshold;
   uint32_t trialInliningInitialWarmUpCount;
   uint32_t normalIonWarmUpThreshold;
+  uint32_t ionWarmUpAfterStubAttach;
   uint32_t regexpWarmUpThreshold;
+  uint32_t regexpBacktrackLimit;
+  uint32_t regexpOffThreadCompileMinLength;
   uint32_t exceptionBailoutThreshold;
   uint32_t frequentBailoutThreshold;
   uint32_t maxStackArgs;
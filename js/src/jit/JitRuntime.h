@@ -18,6 +18,7 @@
 #include "jstypes.h"
 
 #include "jit/ABIFunctions.h"
+#include "jit/BailoutRecords.h"
 #include "jit/BaselineICList.h"
 #include "jit/BaselineJIT.h"
 #include "jit/CalleeToken.h"
@@ -171,6 +172,12 @@ class JitRuntime {
   // Thunk to call malloc/free.
   WriteOnceData<uint32_t> freeStubOffset_{0};
 
+  // Thunks that call the GC post barrier for an object, or for an element of
+  // an object. Ion code calls these from out-of-line paths instead of setting
+  // up the ABI call at every barrier.
+  WriteOnceData<uint32_t> postBarrierStubOffset_{0};
+  WriteOnceData<uint32_t> postElementBarrierStubOffset_{0};
+
   // Thunk called to finish compilation of an IonScript.
   WriteOnceData<uint32_t> lazyLinkStubOffset_{0};
 
@@ -229,6 +236,14 @@ class JitRuntime {
   MainThreadData<IonCompileTaskList> ionLazyLinkList_;
   MainThreadData<size_t> ionLazyLinkListSize_{0};
 
+  // Number of BaselineScripts released since telemetry was last reported, and
+  // how many of them were rarely run. See noteBaselineScriptReleased.
+  MainThreadData<uint32_t> releasedBaselineScripts_{0};
+  MainThreadData<uint32_t> rarelyRunBaselineScripts_{0};
+
+  // Bailouts from Ion code, by bailout site.
+  MainThreadData<BailoutRecords> bailoutRecords_;
+
 #ifdef DEBUG
   // Flag that can be set from JIT code to indicate it's invalid to call
   // arbitrary JS code in a particular region. This is checked in RunScript.
@@ -255,6 +270,8 @@ class JitRuntime {
   uint32_t generatePreBarrier(JSContext* cx, MacroAssembler& masm,
                               MIRType type);
   void generateFreeStub(MacroAssembler& masm);
+  void generatePostBarrierStub(JSContext* cx, MacroAssembler& masm);
+  void generatePostElementBarrierStub(JSContext* cx, MacroAssembler& masm);
   JitCode* generateDebugTrapHandler(JSContext* cx, DebugTrapHandlerKind kind);
 
   bool generateVMWrapper(JSContext* cx, MacroAssembler& masm,
@@ -294,6 +311,28 @@ class JitRuntime {
   [[nodiscard]] static bool MarkJitcodeGlobalTableIteratively(GCMarker* marker);
   static void TraceWeakJitcodeGlobalTable(JSRuntime* rt, JSTracer* trc);
 
+  void noteReleasedBaselineScript(bool rarelyRun) {
+    releasedBaselineScripts_++;
+    if (rarelyRun) {
+      rarelyRunBaselineScripts_++;
+    }
+  }
+
+  // If any BaselineScripts were released since the last call, return the
+  // percentage of them that were rarely run in |percent| and reset the counts.
+  bool takeRarelyRunBaselineScriptsPercent(uint32_t* percent) {
+    if (releasedBaselineScripts_ == 0) {
+      return false;
+    }
+    *percent = uint32_t(100 * uint64_t(rarelyRunBaselineScripts_) /
+                        releasedBaselineScripts_);
+    releasedBaselineScripts_ = 0;
+    rarelyRunBaselineScripts_ = 0;
+    return true;
+  }
+
+  BailoutRecords& bailoutRecords() { return bailoutRecords_.ref(); }
+
   const BaselineICFallbackCode& baselineICFallbackCode() const {
     return baselineICFallbackCode_.ref();
   }
@@ -390,6 +429,13 @@ class JitRuntime {
 
   TrampolinePtr freeStub() const { return trampolineCode(freeStubOffset_); }
 
+  TrampolinePtr postBarrierStub() const {
+    return trampolineCode(postBarrierStubOffset_);
+  }
+  TrampolinePtr postElementBarrierStub() const {
+    return trampolineCode(postElementBarrierStubOffset_);
+  }
+
   TrampolinePtr lazyLinkStub() const {
     return trampolineCode(lazyLinkStubOffset_);
   }
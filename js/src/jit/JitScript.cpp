@@ -11,12 +11,16 @@
 #include "mozilla/IntegerPrintfMacros.h"
 #include "mozilla/ScopeExit.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "jit/BaselineIC.h"
+#include "jit/BaselineJIT.h"
 #include "jit/BytecodeAnalysis.h"
+#include "jit/IonOptimizationLevels.h"
 #include "jit/IonScript.h"
 #include "jit/JitFrames.h"
+#include "jit/JitRuntime.h"
 #include "jit/ScriptFromCalleeToken.h"
 #include "util/Memory.h"
 #include "vm/BytecodeIterator.h"
@@ -42,6 +46,8 @@ JitScript::JitScript(JSScript* script, Offset fallbackStubsOffset,
                      Offset endOffset, const char* profileString)
     : profileString_(profileString),
       endOffset_(endOffset),
+      baselineJitWarmUpThreshold_(ComputeBaselineJitWarmUpThreshold(script)),
+      baselineJitWarmUpThresholdOption_(JitOptions.baselineJitWarmUpThreshold),
       icScript_(script->getWarmUpCount(),
                 fallbackStubsOffset - offsetOfICScript(),
                 endOffset - offsetOfICScript(),
@@ -151,6 +157,7 @@ void JSScript::releaseJitScriptOnFinalize(JSFreeOp* fop) {
   }
 
   if (hasBaselineScript()) {
+    jitScript()->noteBaselineScriptReleased(fop, this);
     BaselineScript* baseline = jitScript()->clearBaselineScript(fop, this);
     jit::BaselineScript::Destroy(fop, baseline);
   }
@@ -249,6 +256,52 @@ void JitScript::resetWarmUpCount(uint32_t count) {
   }
 }
 
+void JitScript::noteStubAttached(JSScript* script) {
+  // Warp compiles the script based on the stubs attached to its ICs. If new
+  // stubs are still being attached, let the script run in Baseline a little
+  // longer so that they can settle first.
+  uint32_t warmUpAfterAttach = JitOptions.ionWarmUpAfterStubAttach;
+  uint32_t count = warmUpCount();
+  if (count + warmUpAfterAttach <= JitOptions.normalIonWarmUpThreshold ||
+      hasIonScript()) {
+    return;
+  }
+
+  const OptimizationInfo* info =
+      IonOptimizations.get(OptimizationLevel::Normal);
+  uint32_t ionThreshold = info->compilerWarmUpThreshold(script);
+  if (ionThreshold <= warmUpAfterAttach) {
+    return;
+  }
+
+  uint32_t newCount = std::max(ionThreshold - warmUpAfterAttach,
+                               baselineJitWarmUpThreshold(script));
+  if (newCount < count) {
+    // Don't use resetWarmUpCount: the warm-up counts of trial-inlined scripts
+    // don't affect when this script is compiled.
+    icScript_.resetWarmUpCount(newCount);
+  }
+}
+
+uint32_t JitScript::baselineJitWarmUpThreshold(JSScript* script) {
+  // The option can be changed at any time, e.g. with setJitCompilerOption.
+  if (baselineJitWarmUpThresholdOption_ !=
+      JitOptions.baselineJitWarmUpThreshold) {
+    baselineJitWarmUpThreshold_ = ComputeBaselineJitWarmUpThreshold(script);
+    baselineJitWarmUpThresholdOption_ = JitOptions.baselineJitWarmUpThreshold;
+  }
+  return baselineJitWarmUpThreshold_;
+}
+
+void JitScript::noteBaselineScriptReleased(JSFreeOp* fop, JSScript* script) {
+  // Count the Baseline code as rarely run if it ran less after compilation
+  // than it did before. Scripts whose warm-up count was reset to delay Ion
+  // compilation were hot enough for Ion.
+  bool rarelyRun = script->getWarmUpResetCount() == 0 &&
+                   warmUpCount() < 2 * baselineJitWarmUpThreshold_;
+  fop->runtime()->jitRuntime()->noteReleasedBaselineScript(rarelyRun);
+}
+
 void JitScript::ensureProfileString(JSContext* cx, JSScript* script) {
   MOZ_ASSERT(cx->runtime()->geckoProfiler().enabled());
 
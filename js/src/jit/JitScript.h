@@ -295,6 +295,13 @@ class alignas(uintptr_t) JitScript final : public TrailingArray {
   // The size of this allocation.
   Offset endOffset_ = 0;
 
+  // Warm-up count needed before this script is compiled with the Baseline JIT,
+  // and the value of JitOptions.baselineJitWarmUpThreshold it was computed
+  // from. The threshold is recomputed when the option has changed since. See
+  // ComputeBaselineJitWarmUpThreshold.
+  uint32_t baselineJitWarmUpThreshold_ = 0;
+  uint32_t baselineJitWarmUpThresholdOption_ = 0;
+
   struct Flags {
     // Flag set when discarding JIT code to indicate this script is on the stack
     // and type information and JIT code should not be discarded.
@@ -388,10 +395,23 @@ class alignas(uintptr_t) JitScript final : public TrailingArray {
     return offsetOfICScript() + ICScript::offsetOfWarmUpCount();
   }
 
+  static constexpr size_t offsetOfBaselineJitWarmUpThreshold() {
+    return offsetof(JitScript, baselineJitWarmUpThreshold_);
+  }
+  static constexpr size_t offsetOfBaselineJitWarmUpThresholdOption() {
+    return offsetof(JitScript, baselineJitWarmUpThresholdOption_);
+  }
+
   uint32_t warmUpCount() const { return icScript_.warmUpCount_; }
   void incWarmUpCount(uint32_t amount) { icScript_.warmUpCount_ += amount; }
   void resetWarmUpCount(uint32_t count);
 
+  uint32_t baselineJitWarmUpThreshold(JSScript* script);
+
+  // Called when a new stub is attached to one of this script's ICs, including
+  // ICs of scripts trial-inlined into it.
+  void noteStubAttached(JSScript* script);
+
   void prepareForDestruction(Zone* zone) {
     // When the script contains pointers to nursery things, the store buffer can
     // contain entries that point into the stub space. Since we can destroy
@@ -483,6 +503,10 @@ class alignas(uintptr_t) JitScript final : public TrailingArray {
     return baseline;
   }
 
+  // Report whether the BaselineScript the GC is about to release was rarely
+  // run. Not called when the script is only recompiled, e.g. for debugging.
+  void noteBaselineScriptReleased(JSFreeOp* fop, JSScript* script);
+
  private:
   // Methods to set ionScript_ to an IonScript*, nullptr, or one of the special
   // Ion{Disabled,Compiling}ScriptPtr values.
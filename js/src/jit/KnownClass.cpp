@@ -22,6 +22,7 @@ KnownClass jit::GetObjectKnownClass(const MDefinition* def) {
   switch (def->op()) {
     case MDefinition::Opcode::NewArray:
     case MDefinition::Opcode::NewArrayDynamicLength:
+    case MDefinition::Opcode::ObjectKeys:
       return KnownClass::Array;
 
     case MDefinition::Opcode::NewObject:
@@ -3112,6 +3112,154 @@ void LIRGenerator::visitFunctionName(MFunctionName* ins) {
   define(lir, ins);
 }
 
+void LIRGenerator::visitNewArrayCopy(MNewArrayCopy* ins) {
+  auto* lir = new (alloc()) LNewArrayCopy();
+  defineReturn(lir, ins);
+  assignSafepoint(lir, ins);
+}
+
+void LIRGenerator::visitObjectKeys(MObjectKeys* ins) {
+  MOZ_ASSERT(ins->object()->type() == MIRType::Object);
+  auto* lir = new (alloc()) LObjectKeys(useRegisterAtStart(ins->object()));
+  defineReturn(lir, ins);
+  assignSafepoint(lir, ins);
+}
+
+void LIRGenerator::visitObjectKeysLength(MObjectKeysLength* ins) {
+  MOZ_ASSERT(ins->object()->type() == MIRType::Object);
+  auto* lir =
+      new (alloc()) LObjectKeysLength(useRegisterAtStart(ins->object()));
+  defineReturn(lir, ins);
+  assignSafepoint(lir, ins);
+}
+
+void LIRGenerator::visitMapObjectGet(MMapObjectGet* ins) {
+  MOZ_ASSERT(ins->map()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->key()->type() == MIRType::Value);
+  auto* lir = new (alloc()) LMapObjectGet(useRegisterAtStart(ins->map()),
+                                          useBoxAtStart(ins->key()));
+  defineReturn(lir, ins);
+  assignSafepoint(lir, ins);
+}
+
+void LIRGenerator::visitMapObjectHas(MMapObjectHas* ins) {
+  MOZ_ASSERT(ins->map()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->key()->type() == MIRType::Value);
+  auto* lir = new (alloc()) LMapObjectHas(useRegisterAtStart(ins->map()),
+                                          useBoxAtStart(ins->key()));
+  defineReturn(lir, ins);
+  assignSafepoint(lir, ins);
+}
+
+void LIRGenerator::visitMapObjectSet(MMapObjectSet* ins) {
+  MOZ_ASSERT(ins->map()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->key()->type() == MIRType::Value);
+  MOZ_ASSERT(ins->value()->type() == MIRType::Value);
+  auto* lir = new (alloc())
+      LMapObjectSet(useRegisterAtStart(ins->map()), useBoxAtStart(ins->key()),
+                    useBoxAtStart(ins->value()));
+  defineReturn(lir, ins);
+  assignSafepoint(lir, ins);
+}
+
+void LIRGenerator::visitMapObjectDelete(MMapObjectDelete* ins) {
+  MOZ_ASSERT(ins->map()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->key()->type() == MIRType::Value);
+  auto* lir = new (alloc()) LMapObjectDelete(useRegisterAtStart(ins->map()),
+                                             useBoxAtStart(ins->key()));
+  defineReturn(lir, ins);
+  assignSafepoint(lir, ins);
+}
+
+void LIRGenerator::visitSetObjectHas(MSetObjectHas* ins) {
+  MOZ_ASSERT(ins->set()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->value()->type() == MIRType::Value);
+  auto* lir = new (alloc()) LSetObjectHas(useRegisterAtStart(ins->set()),
+                                          useBoxAtStart(ins->value()));
+  defineReturn(lir, ins);
+  assignSafepoint(lir, ins);
+}
+
+void LIRGenerator::visitSetObjectAdd(MSetObjectAdd* ins) {
+  MOZ_ASSERT(ins->set()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->value()->type() == MIRType::Value);
+  auto* lir = new (alloc()) LSetObjectAdd(useRegisterAtStart(ins->set()),
+                                          useBoxAtStart(ins->value()));
+  defineReturn(lir, ins);
+  assignSafepoint(lir, ins);
+}
+
+void LIRGenerator::visitSetObjectDelete(MSetObjectDelete* ins) {
+  MOZ_ASSERT(ins->set()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->value()->type() == MIRType::Value);
+  auto* lir = new (alloc()) LSetObjectDelete(useRegisterAtStart(ins->set()),
+                                             useBoxAtStart(ins->value()));
+  defineReturn(lir, ins);
+  assignSafepoint(lir, ins);
+}
+
+void LIRGenerator::visitHashNonGCThing(MHashNonGCThing* ins) {
+  MOZ_ASSERT(ins->input()->type() == MIRType::Value);
+  auto* lir = new (alloc()) LHashNonGCThing(useBox(ins->input()), temp());
+  define(lir, ins);
+}
+
+void LIRGenerator::visitHashString(MHashString* ins) {
+  MOZ_ASSERT(ins->input()->type() == MIRType::String);
+  auto* lir = new (alloc()) LHashString(useRegister(ins->input()), temp());
+  assignSnapshot(lir, ins->bailoutKind());
+  define(lir, ins);
+}
+
+void LIRGenerator::visitHashSymbol(MHashSymbol* ins) {
+  MOZ_ASSERT(ins->input()->type() == MIRType::Symbol);
+  auto* lir = new (alloc()) LHashSymbol(useRegister(ins->input()), temp());
+  define(lir, ins);
+}
+
+void LIRGenerator::visitHashObject(MHashObject* ins) {
+  MOZ_ASSERT(ins->setOrMap()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->input()->type() == MIRType::Object);
+#ifdef JS_PUNBOX64
+  auto* lir = new (alloc())
+      LHashObject(useRegister(ins->setOrMap()), useRegister(ins->input()),
+                  temp(), temp(), temp(), temp());
+  define(lir, ins);
+#else
+  MOZ_CRASH("Inline object hashing requires 64-bit registers");
+#endif
+}
+
+void LIRGenerator::visitSetObjectHasNonBigInt(MSetObjectHasNonBigInt* ins) {
+  MOZ_ASSERT(ins->set()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->value()->type() == MIRType::Value);
+  MOZ_ASSERT(ins->hash()->type() == MIRType::Int32);
+  auto* lir = new (alloc()) LSetObjectHasNonBigInt(
+      useRegister(ins->set()), useBox(ins->value()), useRegister(ins->hash()),
+      temp(), temp(), temp());
+  define(lir, ins);
+}
+
+void LIRGenerator::visitMapObjectHasNonBigInt(MMapObjectHasNonBigInt* ins) {
+  MOZ_ASSERT(ins->map()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->key()->type() == MIRType::Value);
+  MOZ_ASSERT(ins->hash()->type() == MIRType::Int32);
+  auto* lir = new (alloc()) LMapObjectHasNonBigInt(
+      useRegister(ins->map()), useBox(ins->key()), useRegister(ins->hash()),
+      temp(), temp(), temp());
+  define(lir, ins);
+}
+
+void LIRGenerator::visitMapObjectGetNonBigInt(MMapObjectGetNonBigInt* ins) {
+  MOZ_ASSERT(ins->map()->type() == MIRType::Object);
+  MOZ_ASSERT(ins->key()->type() == MIRType::Value);
+  MOZ_ASSERT(ins->hash()->type() == MIRType::Int32);
+  auto* lir = new (alloc()) LMapObjectGetNonBigInt(
+      useRegister(ins->map()), useBox(ins->key()), useRegister(ins->hash()),
+      temp(), temp(), temp());
+  defineBox(lir, ins);
+}
+
 void LIRGenerator::visitGetNextEntryForIterator(MGetNextEntryForIterator* ins) {
   MOZ_ASSERT(ins->iter()->type() == MIRType::Object);
   MOZ_ASSERT(ins->result()->type() == MIRType::Object);
@@ -5335,6 +5483,16 @@ void LIRGenerator::visitGuardArrayIsPacked(MGuardArrayIsPacked* ins) {
   redefine(ins, ins->array());
 }
 
+void LIRGenerator::visitGuardElementsAreInt32(MGuardElementsAreInt32* ins) {
+  MOZ_ASSERT(ins->elements()->type() == MIRType::Elements);
+
+  auto* lir =
+      new (alloc()) LGuardElementsAreInt32(useRegister(ins->elements()));
+  assignSnapshot(lir, ins->bailoutKind());
+  add(lir, ins);
+  redefine(ins, ins->elements());
+}
+
 void LIRGenerator::visitGetPrototypeOf(MGetPrototypeOf* ins) {
   MOZ_ASSERT(ins->target()->type() == MIRType::Object);
   MOZ_ASSERT(ins->type() == MIRType::Value);
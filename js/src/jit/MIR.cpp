@@ -5163,6 +5163,22 @@ AliasSet MArrayLength::getAliasSet() const {
   return AliasSet::Load(AliasSet::ObjectFields);
 }
 
+MDefinition* MArrayLength::foldsTo(TempAllocator& alloc) {
+  // Object.keys(obj).length doesn't need to allocate the keys array when the
+  // array isn't used for anything else.
+  MDefinition* elems = elements();
+  if (!elems->isElements() || !elems->hasOneUse()) {
+    return this;
+  }
+
+  MDefinition* keys = elems->toElements()->object();
+  if (!keys->isObjectKeys() || !keys->hasOneUse()) {
+    return this;
+  }
+
+  return MObjectKeysLength::New(alloc, keys->toObjectKeys()->object());
+}
+
 AliasSet MSetArrayLength::getAliasSet() const {
   return AliasSet::Store(AliasSet::ObjectFields);
 }
@@ -5177,6 +5193,43 @@ AliasSet MFunctionName::getAliasSet() const {
                         AliasSet::DynamicSlot);
 }
 
+// Object.keys reads properties and elements of any kind. It's only used for
+// classes without resolve or enumerate hooks, so it doesn't change the object.
+AliasSet MObjectKeys::getAliasSet() const {
+  return AliasSet::Load(AliasSet::Any);
+}
+
+AliasSet MObjectKeysLength::getAliasSet() const {
+  return AliasSet::Load(AliasSet::Any);
+}
+
+// The contents of Map and Set objects aren't tracked by alias analysis, so
+// lookups have to be ordered with respect to all stores. All operations which
+// can modify a Map or Set are effectful.
+AliasSet MMapObjectGet::getAliasSet() const {
+  return AliasSet::Load(AliasSet::Any);
+}
+
+AliasSet MMapObjectHas::getAliasSet() const {
+  return AliasSet::Load(AliasSet::Any);
+}
+
+AliasSet MSetObjectHas::getAliasSet() const {
+  return AliasSet::Load(AliasSet::Any);
+}
+
+AliasSet MSetObjectHasNonBigInt::getAliasSet() const {
+  return AliasSet::Load(AliasSet::Any);
+}
+
+AliasSet MMapObjectHasNonBigInt::getAliasSet() const {
+  return AliasSet::Load(AliasSet::Any);
+}
+
+AliasSet MMapObjectGetNonBigInt::getAliasSet() const {
+  return AliasSet::Load(AliasSet::Any);
+}
+
 AliasSet MArrayBufferByteLength::getAliasSet() const {
   return AliasSet::Load(AliasSet::FixedSlot);
 }
@@ -5808,6 +5861,11 @@ AliasSet MGuardArrayIsPacked::getAliasSet() const {
   return AliasSet::Load(AliasSet::ObjectFields);
 }
 
+AliasSet MGuardElementsAreInt32::getAliasSet() const {
+  // The NON_INT32 flag is updated by element stores.
+  return AliasSet::Load(AliasSet::Element);
+}
+
 AliasSet MSuperFunction::getAliasSet() const {
   return AliasSet::Load(AliasSet::ObjectFields);
 }
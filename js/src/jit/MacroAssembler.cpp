@@ -14,6 +14,7 @@
 
 #include "jsfriendapi.h"
 
+#include "builtin/MapObject.h"
 #include "gc/GCProbes.h"
 #include "jit/ABIFunctions.h"
 #include "jit/AtomicOp.h"
@@ -38,6 +39,7 @@
 #include "vm/ArrayBufferViewObject.h"
 #include "vm/FunctionFlags.h"  // js::FunctionFlags
 #include "vm/JSContext.h"
+#include "vm/SymbolType.h"
 #include "vm/TraceLogging.h"
 #include "vm/TypedArrayObject.h"
 #include "wasm/WasmTypes.h"
@@ -402,6 +404,40 @@ void MacroAssembler::callFreeStub(Register slots) {
   pop(regSlots);
 }
 
+void MacroAssembler::callPostBarrierStub(Register obj) {
+  // This register must match the one in JitRuntime::generatePostBarrierStub.
+  const Register regObj = CallTempReg0;
+
+  push(regObj);
+  movePtr(obj, regObj);
+  call(GetJitContext()->runtime->jitRuntime()->postBarrierStub());
+  pop(regObj);
+}
+
+void MacroAssembler::callPostElementBarrierStub(Register obj, Register index) {
+  // These registers must match the ones in
+  // JitRuntime::generatePostElementBarrierStub.
+  const Register regObj = CallTempReg0;
+  const Register regIndex = CallTempReg1;
+
+  push(regObj);
+  push(regIndex);
+  if (obj == regIndex && index == regObj) {
+    push(obj);
+    movePtr(index, regIndex);
+    pop(regObj);
+  } else if (index == regObj) {
+    movePtr(index, regIndex);
+    movePtr(obj, regObj);
+  } else {
+    movePtr(obj, regObj);
+    movePtr(index, regIndex);
+  }
+  call(GetJitContext()->runtime->jitRuntime()->postElementBarrierStub());
+  pop(regIndex);
+  pop(regObj);
+}
+
 // Inlined equivalent of gc::AllocateObject, without failure case handling.
 void MacroAssembler::allocateObject(Register result, Register temp,
                                     gc::AllocKind allocKind,
@@ -4203,6 +4239,37 @@ void MacroAssembler::setIsPackedArray(Register obj, Register output,
   bind(&done);
 }
 
+void MacroAssembler::markElementsNonInt32IfNeeded(Register elements,
+                                                  const ValueOperand& value) {
+  Label done;
+  branchTestInt32(Assembler::Equal, value, &done);
+  or32(Imm32(ObjectElements::NON_INT32),
+       Address(elements, ObjectElements::offsetOfFlags()));
+  bind(&done);
+}
+
+void MacroAssembler::markElementsNonInt32IfNeeded(
+    Register elements, const ConstantOrRegister& value) {
+  if (value.constant()) {
+    if (!value.value().isInt32()) {
+      or32(Imm32(ObjectElements::NON_INT32),
+           Address(elements, ObjectElements::offsetOfFlags()));
+    }
+    return;
+  }
+
+  TypedOrValueRegister reg = value.reg();
+  if (reg.hasValue()) {
+    markElementsNonInt32IfNeeded(elements, reg.valueReg());
+    return;
+  }
+
+  if (reg.type() != MIRType::Int32) {
+    or32(Imm32(ObjectElements::NON_INT32),
+         Address(elements, ObjectElements::offsetOfFlags()));
+  }
+}
+
 void MacroAssembler::packedArrayPop(Register array, ValueOperand output,
                                     Register temp1, Register temp2,
                                     Label* fail) {
@@ -4574,6 +4641,312 @@ void MacroAssembler::iteratorClose(Register obj, Register temp1, Register temp2,
 #endif
 }
 
+void MacroAssembler::prepareHashNonGCThing(ValueOperand value, Register result,
+                                           Register temp) {
+  // Inline implementation of |OrderedHashTable::prepareHash()| and
+  // |mozilla::HashGeneric(v.asRawBits())|.
+
+#ifdef DEBUG
+  Label ok;
+  branchTestGCThing(Assembler::NotEqual, value, &ok);
+  assumeUnreachable("Unexpected GC thing");
+  bind(&ok);
+  Label notDouble;
+  branchTestDouble(Assembler::NotEqual, value, &notDouble);
+  assumeUnreachable("Unexpected double");
+  bind(&notDouble);
+#endif
+
+  // uint32_t v1 = static_cast<uint32_t>(aValue);
+#ifdef JS_PUNBOX64
+  move64To32(value.toRegister64(), result);
+#else
+  move32(value.payloadReg(), result);
+#endif
+
+  // mozilla::AddU32ToHash(0, v1) is |kGoldenRatioU32 * v1|, because
+  // |RotateLeft5(0) ^ v1| is just |v1|.
+  move32(Imm32(mozilla::kGoldenRatioU32), temp);
+  mul32(temp, result);
+
+  // uint32_t v2 = static_cast<uint32_t>(static_cast<uint64_t>(aValue) >> 32);
+  //
+  // |AddUintptrToHash<8>| takes an |uintptr_t|, so the upper double-word is
+  // truncated away on 32-bit platforms and |v2| is always zero there.
+
+  // mozilla::AddU32ToHash(hash, v2)
+  rotateLeft(Imm32(5), result, result);
+#ifdef JS_PUNBOX64
+  movePtr(value.valueReg(), temp);
+  rshiftPtr(Imm32(32), temp);
+  xor32(temp, result);
+#endif
+  move32(Imm32(mozilla::kGoldenRatioU32), temp);
+  mul32(temp, result);
+
+  // mozilla::ScrambleHashCode(hash)
+  mul32(temp, result);
+}
+
+void MacroAssembler::prepareHashString(Register str, Register result,
+                                       Register temp) {
+  // Inline implementation of |OrderedHashTable::prepareHash()| and
+  // |JSAtom::hash()|.
+
+#ifdef DEBUG
+  Label ok;
+  branchTest32(Assembler::NonZero, Address(str, JSString::offsetOfFlags()),
+               Imm32(JSString::ATOM_BIT), &ok);
+  assumeUnreachable("Unexpected non-atom string");
+  bind(&ok);
+#endif
+
+  Label fatInline, done;
+  load32(Address(str, JSString::offsetOfFlags()), temp);
+  and32(Imm32(JSString::FAT_INLINE_MASK), temp);
+  branch32(Assembler::Equal, temp, Imm32(JSString::FAT_INLINE_MASK),
+           &fatInline);
+  load32(Address(str, NormalAtom::offsetOfHash()), result);
+  jump(&done);
+  bind(&fatInline);
+  load32(Address(str, FatInlineAtom::offsetOfHash()), result);
+  bind(&done);
+
+  // mozilla::ScrambleHashCode(hash)
+  move32(Imm32(mozilla::kGoldenRatioU32), temp);
+  mul32(temp, result);
+}
+
+void MacroAssembler::prepareHashSymbol(Register sym, Register result,
+                                       Register temp) {
+  // Inline implementation of |OrderedHashTable::prepareHash()| and
+  // |JS::Symbol::hash()|.
+
+  load32(Address(sym, JS::Symbol::offsetOfHash()), result);
+
+  // mozilla::ScrambleHashCode(hash)
+  move32(Imm32(mozilla::kGoldenRatioU32), temp);
+  mul32(temp, result);
+}
+
+#ifdef JS_PUNBOX64
+void MacroAssembler::prepareHashObject(Register setOrMapObj, Register obj,
+                                       Register result, Register temp1,
+                                       Register temp2, Register temp3,
+                                       Register temp4) {
+  // Inline implementation of |OrderedHashTable::prepareHash()| and
+  // |HashCodeScrambler::scramble(v.asRawBits())|.
+
+  static_assert(MapObject::NUM_FIXED_SLOTS == SetObject::NUM_FIXED_SLOTS);
+  MOZ_ASSERT(ValueMap::offsetOfImplHcsK0() == ValueSet::offsetOfImplHcsK0());
+  MOZ_ASSERT(ValueMap::offsetOfImplHcsK1() == ValueSet::offsetOfImplHcsK1());
+
+  // Load the |ValueSet| or |ValueMap|.
+  loadObjPrivate(setOrMapObj, SetObject::NUM_FIXED_SLOTS, temp1);
+
+  // Load |HashCodeScrambler::mK0| and |HashCodeScrambler::mK1|.
+  auto k0 = Register64(temp1);
+  auto k1 = Register64(temp2);
+  load64(Address(temp1, ValueSet::offsetOfImplHcsK1()), k1);
+  load64(Address(temp1, ValueSet::offsetOfImplHcsK0()), k0);
+
+  // Hash numbers are 32-bit values, so only hash the lower double-word. The
+  // object tag is stored in the upper bits of the boxed value, so this is the
+  // same as the lower double-word of the object pointer.
+  static_assert(sizeof(mozilla::HashNumber) == 4);
+  move32To64ZeroExtend(obj, Register64(result));
+
+  // Inline implementation of |SipHasher::sipHash()|.
+  auto m = Register64(result);
+  auto v0 = Register64(temp3);
+  auto v1 = Register64(temp4);
+  auto v2 = k0;
+  auto v3 = k1;
+
+  auto sipRound = [&]() {
+    // mV0 = WrappingAdd(mV0, mV1);
+    add64(v1, v0);
+
+    // mV1 = RotateLeft(mV1, 13);
+    rotateLeft64(Imm32(13), v1, v1, InvalidReg);
+
+    // mV1 ^= mV0;
+    xor64(v0, v1);
+
+    // mV0 = RotateLeft(mV0, 32);
+    rotateLeft64(Imm32(32), v0, v0, InvalidReg);
+
+    // mV2 = WrappingAdd(mV2, mV3);
+    add64(v3, v2);
+
+    // mV3 = RotateLeft(mV3, 16);
+    rotateLeft64(Imm32(16), v3, v3, InvalidReg);
+
+    // mV3 ^= mV2;
+    xor64(v2, v3);
+
+    // mV0 = WrappingAdd(mV0, mV3);
+    add64(v3, v0);
+
+    // mV3 = RotateLeft(mV3, 21);
+    rotateLeft64(Imm32(21), v3, v3, InvalidReg);
+
+    // mV3 ^= mV0;
+    xor64(v0, v3);
+
+    // mV2 = WrappingAdd(mV2, mV1);
+    add64(v1, v2);
+
+    // mV1 = RotateLeft(mV1, 17);
+    rotateLeft64(Imm32(17), v1, v1, InvalidReg);
+
+    // mV1 ^= mV2;
+    xor64(v2, v1);
+
+    // mV2 = RotateLeft(mV2, 32);
+    rotateLeft64(Imm32(32), v2, v2, InvalidReg);
+  };
+
+  // 1. Initialization.
+  // mV0 = aK0 ^ UINT64_C(0x736f6d6570736575);
+  move64(k0, v0);
+  xor64(Imm64(0x736f6d6570736575), v0);
+
+  // mV1 = aK1 ^ UINT64_C(0x646f72616e646f6d);
+  move64(k1, v1);
+  xor64(Imm64(0x646f72616e646f6d), v1);
+
+  // mV2 = aK0 ^ UINT64_C(0x6c7967656e657261);
+  MOZ_ASSERT(v2 == k0);
+  xor64(Imm64(0x6c7967656e657261), v2);
+
+  // mV3 = aK1 ^ UINT64_C(0x7465646279746573);
+  MOZ_ASSERT(v3 == k1);
+  xor64(Imm64(0x7465646279746573), v3);
+
+  // 2. Compression.
+  // mV3 ^= aM;
+  xor64(m, v3);
+
+  // sipRound();
+  sipRound();
+
+  // mV0 ^= aM;
+  xor64(m, v0);
+
+  // 3. Finalization.
+  // mV2 ^= 0xff;
+  xor64(Imm64(0xff), v2);
+
+  // for (int i = 0; i < 3; i++) sipRound();
+  for (int i = 0; i < 3; i++) {
+    sipRound();
+  }
+
+  // return mV0 ^ mV1 ^ mV2 ^ mV3;
+  move64(v0, m);
+  xor64(v1, m);
+  xor64(v2, m);
+  xor64(v3, m);
+
+  // mozilla::ScrambleHashCode(hash), which also truncates to 32 bits.
+  move32(Imm32(mozilla::kGoldenRatioU32), temp1);
+  mul32(temp1, result);
+}
+#endif
+
+template <typename OrderedHashTable>
+void MacroAssembler::orderedHashTableLookup(Register setOrMapObj,
+                                            ValueOperand value, Register hash,
+                                            Register entryTemp,
+                                            Register temp) {
+  // Inline implementation of |OrderedHashTable::lookup()|. Leaves the
+  // matching |Data*| in |entryTemp|, or nullptr if there's no match.
+
+  // Load the |ValueSet| or |ValueMap|.
+  static_assert(MapObject::NUM_FIXED_SLOTS == SetObject::NUM_FIXED_SLOTS);
+  loadObjPrivate(setOrMapObj, SetObject::NUM_FIXED_SLOTS, temp);
+
+  // Load the bucket: |hashTable[hash >> hashShift]|.
+  load32(Address(temp, OrderedHashTable::offsetOfImplHashShift()), entryTemp);
+  flexibleRshift32(entryTemp, hash);
+
+  loadPtr(Address(temp, OrderedHashTable::offsetOfImplHashTable()), temp);
+  loadPtr(BaseIndex(temp, hash, ScalePointer), entryTemp);
+
+  // Search for a match in this bucket.
+  Label start, loop, done;
+  jump(&start);
+  bind(&loop);
+  {
+    // Inline implementation of |HashableValue::operator==|, which compares
+    // the raw bits for all values except BigInts.
+    Address keyAddr(entryTemp, OrderedHashTable::offsetOfImplDataElement() +
+                                   OrderedHashTable::offsetOfEntryKey());
+#ifdef JS_PUNBOX64
+    branchPtr(Assembler::Equal, keyAddr, value.valueReg(), &done);
+#else
+    Label next;
+    branch32(Assembler::NotEqual, ToPayload(keyAddr), value.payloadReg(),
+             &next);
+    branch32(Assembler::Equal, ToType(keyAddr), value.typeReg(), &done);
+    bind(&next);
+#endif
+
+    loadPtr(Address(entryTemp, OrderedHashTable::offsetOfImplDataChain()),
+            entryTemp);
+  }
+  bind(&start);
+  branchTestPtr(Assembler::NonZero, entryTemp, entryTemp, &loop);
+
+  bind(&done);
+}
+
+void MacroAssembler::setObjectHas(Register setObj, ValueOperand value,
+                                  Register hash, Register result,
+                                  Register temp1, Register temp2) {
+  Register entry = temp1;
+  orderedHashTableLookup<ValueSet>(setObj, value, hash, entry, temp2);
+
+  Label done;
+  move32(Imm32(0), result);
+  branchTestPtr(Assembler::Zero, entry, entry, &done);
+  move32(Imm32(1), result);
+  bind(&done);
+}
+
+void MacroAssembler::mapObjectHas(Register mapObj, ValueOperand value,
+                                  Register hash, Register result,
+                                  Register temp1, Register temp2) {
+  Register entry = temp1;
+  orderedHashTableLookup<ValueMap>(mapObj, value, hash, entry, temp2);
+
+  Label done;
+  move32(Imm32(0), result);
+  branchTestPtr(Assembler::Zero, entry, entry, &done);
+  move32(Imm32(1), result);
+  bind(&done);
+}
+
+void MacroAssembler::mapObjectGet(Register mapObj, ValueOperand value,
+                                  Register hash, ValueOperand result,
+                                  Register temp1, Register temp2) {
+  Register entry = temp1;
+  orderedHashTableLookup<ValueMap>(mapObj, value, hash, entry, temp2);
+
+  Label found, done;
+  branchTestPtr(Assembler::NonZero, entry, entry, &found);
+  moveValue(UndefinedValue(), result);
+  jump(&done);
+
+  bind(&found);
+  loadValue(Address(entry, ValueMap::offsetOfImplDataElement() +
+                               ValueMap::offsetOfEntryValue()),
+            result);
+
+  bind(&done);
+}
+
 // Can't push large frames blindly on windows, so we must touch frame memory
 // incrementally, with no more than 4096 - 1 bytes between touches.
 //
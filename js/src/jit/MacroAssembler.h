@@ -4628,6 +4628,13 @@ class MacroAssembler : public MacroAssemblerSpecific {
 
   void setIsPackedArray(Register obj, Register output, Register temp);
 
+  // Set the NON_INT32 flag on |elements| unless |value| is an Int32 value.
+  // Must be called for every store into dense elements.
+  void markElementsNonInt32IfNeeded(Register elements,
+                                    const ValueOperand& value);
+  void markElementsNonInt32IfNeeded(Register elements,
+                                    const ConstantOrRegister& value);
+
   void packedArrayPop(Register array, ValueOperand output, Register temp1,
                       Register temp2, Label* fail);
   void packedArrayShift(Register array, ValueOperand output, Register temp1,
@@ -4656,6 +4663,39 @@ class MacroAssembler : public MacroAssemblerSpecific {
   void iteratorClose(Register obj, Register temp1, Register temp2,
                      Register temp3);
 
+  // Inline versions of |OrderedHashTable::prepareHash()| for Map and Set
+  // keys. HashableValue normalizes doubles and atomizes strings, so
+  // prepareHashNonGCThing doesn't accept doubles and prepareHashString only
+  // accepts atoms.
+  void prepareHashNonGCThing(ValueOperand value, Register result,
+                             Register temp);
+  void prepareHashString(Register str, Register result, Register temp);
+  void prepareHashSymbol(Register sym, Register result, Register temp);
+#ifdef JS_PUNBOX64
+  void prepareHashObject(Register setOrMapObj, Register obj, Register result,
+                         Register temp1, Register temp2, Register temp3,
+                         Register temp4);
+#endif
+
+ private:
+  template <typename OrderedHashTable>
+  void orderedHashTableLookup(Register setOrMapObj, ValueOperand value,
+                              Register hash, Register entryTemp,
+                              Register temp);
+
+ public:
+  // Inline versions of |SetObject::has()|, |MapObject::has()| and
+  // |MapObject::get()| for keys whose equality is equality of their raw bits,
+  // i.e. everything except BigInts and doubles. |hash| must be the result of
+  // one of the prepareHash methods above and is clobbered. |result| may be
+  // the same register as |hash|.
+  void setObjectHas(Register setObj, ValueOperand value, Register hash,
+                    Register result, Register temp1, Register temp2);
+  void mapObjectHas(Register mapObj, ValueOperand value, Register hash,
+                    Register result, Register temp1, Register temp2);
+  void mapObjectGet(Register mapObj, ValueOperand value, Register hash,
+                    ValueOperand result, Register temp1, Register temp2);
+
   // Inline version of js_TypedArray_uint8_clamp_double.
   // This function clobbers the input register.
   void clampDoubleToUint8(FloatRegister input, Register output) PER_ARCH;
@@ -4720,6 +4760,13 @@ class MacroAssembler : public MacroAssemblerSpecific {
 
  public:
   void callFreeStub(Register slots);
+
+  // Call the GC post barrier for |obj|, or for element |index| of |obj|, using
+  // the JitRuntime's shared stubs. All general purpose registers are preserved;
+  // callers must save any live volatile float registers.
+  void callPostBarrierStub(Register obj);
+  void callPostElementBarrierStub(Register obj, Register index);
+
   void createGCObject(Register result, Register temp,
                       const TemplateObject& templateObj,
                       gc::InitialHeap initialHeap, Label* fail,
@@ -5101,6 +5148,13 @@ class IonHeapMacroAssembler : public MacroAssembler {
   }
 };
 
+// Heap-allocated MacroAssembler used for off-thread regexp code generation.
+// Regexp code doesn't contain GC pointers, so the assembler needn't be traced.
+class RegExpHeapMacroAssembler : public MacroAssembler {
+ public:
+  RegExpHeapMacroAssembler() : MacroAssembler() {}
+};
+
 //{{{ check_macroassembler_style
 inline uint32_t MacroAssembler::framePushed() const { return framePushed_; }
 
@@ -443,6 +443,7 @@ class SnapshotReader {
  public:
   void readTrackSnapshot();
   void spewBailingFrom() const;
+  uint32_t mirOpcode() const { return mirOpcode_; }
 #endif
 
  private:
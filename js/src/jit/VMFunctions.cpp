@@ -8,6 +8,7 @@
 
 #include "mozilla/FloatingPoint.h"
 
+#include "builtin/MapObject.h"
 #include "builtin/String.h"
 #include "frontend/BytecodeCompiler.h"
 #include "gc/Cell.h"
@@ -1550,6 +1551,56 @@ JSString* StringReplace(JSContext* cx, HandleString string,
   return str_replace_string_raw(cx, string, pattern, repl);
 }
 
+bool MapObjectGet(JSContext* cx, HandleObject obj, HandleValue key,
+                  MutableHandleValue rval) {
+  MOZ_ASSERT(obj->is<MapObject>());
+  return MapObject::get(cx, obj, key, rval);
+}
+
+bool MapObjectHas(JSContext* cx, HandleObject obj, HandleValue key, bool* res) {
+  MOZ_ASSERT(obj->is<MapObject>());
+  return MapObject::has(cx, obj, key, res);
+}
+
+JSObject* MapObjectSet(JSContext* cx, HandleObject obj, HandleValue key,
+                       HandleValue value) {
+  MOZ_ASSERT(obj->is<MapObject>());
+  if (!MapObject::set(cx, obj, key, value)) {
+    return nullptr;
+  }
+
+  // Map.prototype.set returns the Map itself.
+  return obj;
+}
+
+bool MapObjectDelete(JSContext* cx, HandleObject obj, HandleValue key,
+                     bool* res) {
+  MOZ_ASSERT(obj->is<MapObject>());
+  return MapObject::delete_(cx, obj, key, res);
+}
+
+bool SetObjectHas(JSContext* cx, HandleObject obj, HandleValue value,
+                  bool* res) {
+  MOZ_ASSERT(obj->is<SetObject>());
+  return SetObject::has(cx, obj, value, res);
+}
+
+JSObject* SetObjectAdd(JSContext* cx, HandleObject obj, HandleValue value) {
+  MOZ_ASSERT(obj->is<SetObject>());
+  if (!SetObject::add(cx, obj, value)) {
+    return nullptr;
+  }
+
+  // Set.prototype.add returns the Set itself.
+  return obj;
+}
+
+bool SetObjectDelete(JSContext* cx, HandleObject obj, HandleValue value,
+                     bool* res) {
+  MOZ_ASSERT(obj->is<SetObject>());
+  return SetObject::delete_(cx, obj, value, res);
+}
+
 bool SetDenseElement(JSContext* cx, HandleNativeObject obj, int32_t index,
                      HandleValue value, bool strict) {
   // This function is called from Ion code for StoreElementHole's OOL path.
@@ -502,6 +502,21 @@ JSObject* InitRestParameter(JSContext* cx, uint32_t length, Value* rest,
 JSString* StringReplace(JSContext* cx, HandleString string,
                         HandleString pattern, HandleString repl);
 
+[[nodiscard]] bool MapObjectGet(JSContext* cx, HandleObject obj,
+                                HandleValue key, MutableHandleValue rval);
+[[nodiscard]] bool MapObjectHas(JSContext* cx, HandleObject obj,
+                                HandleValue key, bool* res);
+JSObject* MapObjectSet(JSContext* cx, HandleObject obj, HandleValue key,
+                       HandleValue value);
+[[nodiscard]] bool MapObjectDelete(JSContext* cx, HandleObject obj,
+                                   HandleValue key, bool* res);
+
+[[nodiscard]] bool SetObjectHas(JSContext* cx, HandleObject obj,
+                                HandleValue value, bool* res);
+JSObject* SetObjectAdd(JSContext* cx, HandleObject obj, HandleValue value);
+[[nodiscard]] bool SetObjectDelete(JSContext* cx, HandleObject obj,
+                                   HandleValue value, bool* res);
+
 [[nodiscard]] bool SetDenseElement(JSContext* cx, HandleNativeObject obj,
                                    int32_t index, HandleValue value,
                                    bool strict);
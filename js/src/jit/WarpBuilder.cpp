@@ -18,6 +18,7 @@
 #include "jit/WarpCacheIRTranspiler.h"
 #include "jit/WarpSnapshot.h"
 #include "js/friend/ErrorMessages.h"  // JSMSG_BAD_CONST_ASSIGN
+#include "vm/ArrayObject.h"
 #include "vm/GeneratorObject.h"
 #include "vm/Opcodes.h"
 
@@ -2545,6 +2546,56 @@ bool WarpBuilder::build_Object(BytecodeLocation loc) {
   return true;
 }
 
+bool WarpBuilder::build_NewArrayCopy(BytecodeLocation loc) {
+  ArrayObject* templateObject = &loc.getObject(script_)->as<ArrayObject>();
+  uint32_t length = templateObject->getDenseInitializedLength();
+
+  // Arrays which don't fit in fixed elements call into the VM to copy the
+  // template's elements in bulk.
+  if (!gc::CanUseFixedElementsForArray(length)) {
+    auto* ins = MNewArrayCopy::New(alloc(), templateObject);
+    current->add(ins);
+    current->push(ins);
+    return true;
+  }
+
+  // Otherwise allocate the array inline and store each element, as for
+  // JSOp::NewArray followed by JSOp::InitElemArray, so that scalar replacement
+  // can still remove arrays which don't escape. The template is never exposed
+  // to script, so its elements can't change.
+
+  // TODO: support pre-tenuring.
+  gc::InitialHeap heap = gc::DefaultHeap;
+
+  auto* shapeConstant = MConstant::NewShape(alloc(), templateObject->shape());
+  current->add(shapeConstant);
+
+  auto* newArray = MNewArrayObject::New(alloc(), shapeConstant, length, heap);
+  current->add(newArray);
+  current->push(newArray);
+
+  MElements* elements = MElements::New(alloc(), newArray);
+  current->add(elements);
+
+  // The elements are primitives or atoms, so no post barriers are needed.
+  MConstant* index = nullptr;
+  for (uint32_t i = 0; i < length; i++) {
+    if (!alloc().ensureBallast()) {
+      return false;
+    }
+
+    index = constant(Int32Value(i));
+    MConstant* value = constant(templateObject->getDenseElement(i));
+    MStoreElement* store = MStoreElement::New(alloc(), elements, index, value,
+                                              /* needsHoleCheck = */ false);
+    current->add(store);
+  }
+
+  auto* initLength = MSetInitializedLength::New(alloc(), elements, index);
+  current->add(initLength);
+  return true;
+}
+
 bool WarpBuilder::buildInitPropGetterSetterOp(BytecodeLocation loc) {
   PropertyName* name = loc.getPropertyName(script_);
   MDefinition* value = current->pop();
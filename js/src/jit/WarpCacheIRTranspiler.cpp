@@ -1694,6 +1694,32 @@ bool WarpCacheIRTranspiler::emitLoadDenseElementResult(ObjOperandId objId,
   return true;
 }
 
+bool WarpCacheIRTranspiler::emitLoadDenseElementInt32Result(
+    ObjOperandId objId, Int32OperandId indexId) {
+  MDefinition* obj = getOperand(objId);
+  MDefinition* index = getOperand(indexId);
+
+  auto* elements = MElements::New(alloc(), obj);
+  add(elements);
+
+  auto* guard = MGuardElementsAreInt32::New(alloc(), elements);
+  add(guard);
+
+  auto* length = MInitializedLength::New(alloc(), guard);
+  add(length);
+
+  index = addBoundsCheck(index, length);
+
+  // The guard ensures there are no holes and no non-Int32 values, so we can
+  // load the element as an unboxed Int32 without any checks.
+  auto* load = MLoadElementAndUnbox::New(alloc(), guard, index,
+                                         MUnbox::Infallible, MIRType::Int32);
+  add(load);
+
+  pushResult(load);
+  return true;
+}
+
 bool WarpCacheIRTranspiler::emitLoadDenseElementHoleResult(
     ObjOperandId objId, Int32OperandId indexId) {
   MDefinition* obj = getOperand(objId);
@@ -3474,6 +3500,186 @@ bool WarpCacheIRTranspiler::emitGetNextMapSetEntryForIteratorResult(
   return resumeAfter(ins);
 }
 
+bool WarpCacheIRTranspiler::emitMapGetResult(ObjOperandId mapId,
+                                             ValOperandId keyId) {
+  MDefinition* map = getOperand(mapId);
+  MDefinition* key = getOperand(keyId);
+
+  auto* ins = MMapObjectGet::New(alloc(), map, key);
+  add(ins);
+
+  pushResult(ins);
+  return true;
+}
+
+bool WarpCacheIRTranspiler::emitObjectKeysResult(ObjOperandId objId) {
+  MDefinition* obj = getOperand(objId);
+
+  auto* ins = MObjectKeys::New(alloc(), obj);
+  add(ins);
+
+  pushResult(ins);
+  return true;
+}
+
+bool WarpCacheIRTranspiler::emitMapHasResult(ObjOperandId mapId,
+                                             ValOperandId keyId) {
+  MDefinition* map = getOperand(mapId);
+  MDefinition* key = getOperand(keyId);
+
+  auto* ins = MMapObjectHas::New(alloc(), map, key);
+  add(ins);
+
+  pushResult(ins);
+  return true;
+}
+
+bool WarpCacheIRTranspiler::emitMapSetResult(ObjOperandId mapId,
+                                             ValOperandId keyId,
+                                             ValOperandId valueId) {
+  MDefinition* map = getOperand(mapId);
+  MDefinition* key = getOperand(keyId);
+  MDefinition* value = getOperand(valueId);
+
+  auto* ins = MMapObjectSet::New(alloc(), map, key, value);
+  addEffectful(ins);
+
+  pushResult(ins);
+  return resumeAfter(ins);
+}
+
+bool WarpCacheIRTranspiler::emitMapDeleteResult(ObjOperandId mapId,
+                                                ValOperandId keyId) {
+  MDefinition* map = getOperand(mapId);
+  MDefinition* key = getOperand(keyId);
+
+  auto* ins = MMapObjectDelete::New(alloc(), map, key);
+  addEffectful(ins);
+
+  pushResult(ins);
+  return resumeAfter(ins);
+}
+
+bool WarpCacheIRTranspiler::emitSetHasResult(ObjOperandId setId,
+                                             ValOperandId valueId) {
+  MDefinition* set = getOperand(setId);
+  MDefinition* value = getOperand(valueId);
+
+  auto* ins = MSetObjectHas::New(alloc(), set, value);
+  add(ins);
+
+  pushResult(ins);
+  return true;
+}
+
+bool WarpCacheIRTranspiler::emitSetAddResult(ObjOperandId setId,
+                                             ValOperandId valueId) {
+  MDefinition* set = getOperand(setId);
+  MDefinition* value = getOperand(valueId);
+
+  auto* ins = MSetObjectAdd::New(alloc(), set, value);
+  addEffectful(ins);
+
+  pushResult(ins);
+  return resumeAfter(ins);
+}
+
+bool WarpCacheIRTranspiler::emitSetDeleteResult(ObjOperandId setId,
+                                                ValOperandId valueId) {
+  MDefinition* set = getOperand(setId);
+  MDefinition* value = getOperand(valueId);
+
+  auto* ins = MSetObjectDelete::New(alloc(), set, value);
+  addEffectful(ins);
+
+  pushResult(ins);
+  return resumeAfter(ins);
+}
+
+bool WarpCacheIRTranspiler::emitHashNonGCThing(ValOperandId inputId,
+                                               Int32OperandId resultId) {
+  MDefinition* input = getOperand(inputId);
+
+  auto* ins = MHashNonGCThing::New(alloc(), input);
+  add(ins);
+
+  return defineOperand(resultId, ins);
+}
+
+bool WarpCacheIRTranspiler::emitHashString(StringOperandId strId,
+                                           Int32OperandId resultId) {
+  MDefinition* str = getOperand(strId);
+
+  auto* ins = MHashString::New(alloc(), str);
+  add(ins);
+
+  return defineOperand(resultId, ins);
+}
+
+bool WarpCacheIRTranspiler::emitHashSymbol(SymbolOperandId symId,
+                                           Int32OperandId resultId) {
+  MDefinition* sym = getOperand(symId);
+
+  auto* ins = MHashSymbol::New(alloc(), sym);
+  add(ins);
+
+  return defineOperand(resultId, ins);
+}
+
+bool WarpCacheIRTranspiler::emitHashObject(ObjOperandId setOrMapId,
+                                           ObjOperandId objId,
+                                           Int32OperandId resultId) {
+  MDefinition* setOrMap = getOperand(setOrMapId);
+  MDefinition* obj = getOperand(objId);
+
+  auto* ins = MHashObject::New(alloc(), setOrMap, obj);
+  add(ins);
+
+  return defineOperand(resultId, ins);
+}
+
+bool WarpCacheIRTranspiler::emitSetHasNonBigIntResult(ObjOperandId setId,
+                                                      ValOperandId valueId,
+                                                      Int32OperandId hashId) {
+  MDefinition* set = getOperand(setId);
+  MDefinition* value = getOperand(valueId);
+  MDefinition* hash = getOperand(hashId);
+
+  auto* ins = MSetObjectHasNonBigInt::New(alloc(), set, value, hash);
+  add(ins);
+
+  pushResult(ins);
+  return true;
+}
+
+bool WarpCacheIRTranspiler::emitMapHasNonBigIntResult(ObjOperandId mapId,
+                                                      ValOperandId keyId,
+                                                      Int32OperandId hashId) {
+  MDefinition* map = getOperand(mapId);
+  MDefinition* key = getOperand(keyId);
+  MDefinition* hash = getOperand(hashId);
+
+  auto* ins = MMapObjectHasNonBigInt::New(alloc(), map, key, hash);
+  add(ins);
+
+  pushResult(ins);
+  return true;
+}
+
+bool WarpCacheIRTranspiler::emitMapGetNonBigIntResult(ObjOperandId mapId,
+                                                      ValOperandId keyId,
+                                                      Int32OperandId hashId) {
+  MDefinition* map = getOperand(mapId);
+  MDefinition* key = getOperand(keyId);
+  MDefinition* hash = getOperand(hashId);
+
+  auto* ins = MMapObjectGetNonBigInt::New(alloc(), map, key, hash);
+  add(ins);
+
+  pushResult(ins);
+  return true;
+}
+
 bool WarpCacheIRTranspiler::emitFrameIsConstructingResult() {
   if (const CallInfo* callInfo = builder_->inlineCallInfo()) {
     auto* ins = constant(BooleanValue(callInfo->constructing()));
@@ -4243,6 +4449,10 @@ bool WarpCacheIRTranspiler::emitCallFunction(
       if (!call) {
         return false;
       }
+      // The Baseline stub fails for too many arguments without attaching a new
+      // stub, so recompiling doesn't help. Use the same bailout kind as
+      // WarpBuilder::build_SpreadCall.
+      call->setBailoutKind(BailoutKind::TooManyArguments);
       addEffectful(call);
       pushResult(call);
 
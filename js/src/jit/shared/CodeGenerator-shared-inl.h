@@ -324,6 +324,11 @@ LiveRegisterSet CodeGeneratorShared::liveVolatileRegs(LInstruction* ins) {
   return regs;
 }
 
+LiveRegisterSet CodeGeneratorShared::liveVolatileFloatRegs(LInstruction* ins) {
+  LiveRegisterSet regs = liveVolatileRegs(ins);
+  return LiveRegisterSet(GeneralRegisterSet(), regs.set().fpus());
+}
+
 void CodeGeneratorShared::saveLiveVolatile(LInstruction* ins) {
   LiveRegisterSet regs = liveVolatileRegs(ins);
   masm.PushRegsInMask(regs);
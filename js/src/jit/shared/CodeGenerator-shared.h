@@ -364,6 +364,9 @@ class CodeGeneratorShared : public LElementVisitor {
   inline void saveLiveVolatile(LInstruction* ins);
   inline void restoreLiveVolatile(LInstruction* ins);
 
+  // Float registers that are both live and volatile.
+  inline LiveRegisterSet liveVolatileFloatRegs(LInstruction* ins);
+
  public:
   template <typename T>
   void pushArg(const T& t) {
@@ -4128,6 +4128,296 @@ class LFunctionName : public LInstructionHelper<1, 1, 0> {
   const LAllocation* function() { return getOperand(0); }
 };
 
+class LNewArrayCopy : public LCallInstructionHelper<1, 0, 0> {
+ public:
+  LIR_HEADER(NewArrayCopy)
+
+  LNewArrayCopy() : LCallInstructionHelper(classOpcode) {}
+
+  MNewArrayCopy* mir() const { return mir_->toNewArrayCopy(); }
+};
+
+class LObjectKeys : public LCallInstructionHelper<1, 1, 0> {
+ public:
+  LIR_HEADER(ObjectKeys)
+
+  explicit LObjectKeys(const LAllocation& object)
+      : LCallInstructionHelper(classOpcode) {
+    setOperand(0, object);
+  }
+
+  const LAllocation* object() { return getOperand(0); }
+};
+
+class LObjectKeysLength : public LCallInstructionHelper<1, 1, 0> {
+ public:
+  LIR_HEADER(ObjectKeysLength)
+
+  explicit LObjectKeysLength(const LAllocation& object)
+      : LCallInstructionHelper(classOpcode) {
+    setOperand(0, object);
+  }
+
+  const LAllocation* object() { return getOperand(0); }
+};
+
+class LMapObjectGet
+    : public LCallInstructionHelper<BOX_PIECES, 1 + BOX_PIECES, 0> {
+ public:
+  LIR_HEADER(MapObjectGet)
+
+  LMapObjectGet(const LAllocation& map, const LBoxAllocation& key)
+      : LCallInstructionHelper(classOpcode) {
+    setOperand(0, map);
+    setBoxOperand(KeyIndex, key);
+  }
+
+  static const size_t KeyIndex = 1;
+
+  const LAllocation* map() { return getOperand(0); }
+};
+
+class LMapObjectHas : public LCallInstructionHelper<1, 1 + BOX_PIECES, 0> {
+ public:
+  LIR_HEADER(MapObjectHas)
+
+  LMapObjectHas(const LAllocation& map, const LBoxAllocation& key)
+      : LCallInstructionHelper(classOpcode) {
+    setOperand(0, map);
+    setBoxOperand(KeyIndex, key);
+  }
+
+  static const size_t KeyIndex = 1;
+
+  const LAllocation* map() { return getOperand(0); }
+};
+
+class LMapObjectSet : public LCallInstructionHelper<1, 1 + 2 * BOX_PIECES, 0> {
+ public:
+  LIR_HEADER(MapObjectSet)
+
+  LMapObjectSet(const LAllocation& map, const LBoxAllocation& key,
+                const LBoxAllocation& value)
+      : LCallInstructionHelper(classOpcode) {
+    setOperand(0, map);
+    setBoxOperand(KeyIndex, key);
+    setBoxOperand(ValueIndex, value);
+  }
+
+  static const size_t KeyIndex = 1;
+  static const size_t ValueIndex = 1 + BOX_PIECES;
+
+  const LAllocation* map() { return getOperand(0); }
+};
+
+class LMapObjectDelete : public LCallInstructionHelper<1, 1 + BOX_PIECES, 0> {
+ public:
+  LIR_HEADER(MapObjectDelete)
+
+  LMapObjectDelete(const LAllocation& map, const LBoxAllocation& key)
+      : LCallInstructionHelper(classOpcode) {
+    setOperand(0, map);
+    setBoxOperand(KeyIndex, key);
+  }
+
+  static const size_t KeyIndex = 1;
+
+  const LAllocation* map() { return getOperand(0); }
+};
+
+class LSetObjectHas : public LCallInstructionHelper<1, 1 + BOX_PIECES, 0> {
+ public:
+  LIR_HEADER(SetObjectHas)
+
+  LSetObjectHas(const LAllocation& set, const LBoxAllocation& value)
+      : LCallInstructionHelper(classOpcode) {
+    setOperand(0, set);
+    setBoxOperand(ValueIndex, value);
+  }
+
+  static const size_t ValueIndex = 1;
+
+  const LAllocation* set() { return getOperand(0); }
+};
+
+class LSetObjectAdd : public LCallInstructionHelper<1, 1 + BOX_PIECES, 0> {
+ public:
+  LIR_HEADER(SetObjectAdd)
+
+  LSetObjectAdd(const LAllocation& set, const LBoxAllocation& value)
+      : LCallInstructionHelper(classOpcode) {
+    setOperand(0, set);
+    setBoxOperand(ValueIndex, value);
+  }
+
+  static const size_t ValueIndex = 1;
+
+  const LAllocation* set() { return getOperand(0); }
+};
+
+class LSetObjectDelete : public LCallInstructionHelper<1, 1 + BOX_PIECES, 0> {
+ public:
+  LIR_HEADER(SetObjectDelete)
+
+  LSetObjectDelete(const LAllocation& set, const LBoxAllocation& value)
+      : LCallInstructionHelper(classOpcode) {
+    setOperand(0, set);
+    setBoxOperand(ValueIndex, value);
+  }
+
+  static const size_t ValueIndex = 1;
+
+  const LAllocation* set() { return getOperand(0); }
+};
+
+class LHashNonGCThing : public LInstructionHelper<1, BOX_PIECES, 1> {
+ public:
+  LIR_HEADER(HashNonGCThing)
+
+  LHashNonGCThing(const LBoxAllocation& input, const LDefinition& temp)
+      : LInstructionHelper(classOpcode) {
+    setBoxOperand(Input, input);
+    setTemp(0, temp);
+  }
+
+  static const size_t Input = 0;
+
+  const LDefinition* temp() { return getTemp(0); }
+};
+
+class LHashString : public LInstructionHelper<1, 1, 1> {
+ public:
+  LIR_HEADER(HashString)
+
+  LHashString(const LAllocation& input, const LDefinition& temp)
+      : LInstructionHelper(classOpcode) {
+    setOperand(0, input);
+    setTemp(0, temp);
+  }
+
+  const LAllocation* input() { return getOperand(0); }
+  const LDefinition* temp() { return getTemp(0); }
+};
+
+class LHashSymbol : public LInstructionHelper<1, 1, 1> {
+ public:
+  LIR_HEADER(HashSymbol)
+
+  LHashSymbol(const LAllocation& input, const LDefinition& temp)
+      : LInstructionHelper(classOpcode) {
+    setOperand(0, input);
+    setTemp(0, temp);
+  }
+
+  const LAllocation* input() { return getOperand(0); }
+  const LDefinition* temp() { return getTemp(0); }
+};
+
+class LHashObject : public LInstructionHelper<1, 2, 4> {
+ public:
+  LIR_HEADER(HashObject)
+
+  LHashObject(const LAllocation& setOrMap, const LAllocation& input,
+              const LDefinition& temp1, const LDefinition& temp2,
+              const LDefinition& temp3, const LDefinition& temp4)
+      : LInstructionHelper(classOpcode) {
+    setOperand(0, setOrMap);
+    setOperand(1, input);
+    setTemp(0, temp1);
+    setTemp(1, temp2);
+    setTemp(2, temp3);
+    setTemp(3, temp4);
+  }
+
+  const LAllocation* setOrMap() { return getOperand(0); }
+  const LAllocation* input() { return getOperand(1); }
+  const LDefinition* temp1() { return getTemp(0); }
+  const LDefinition* temp2() { return getTemp(1); }
+  const LDefinition* temp3() { return getTemp(2); }
+  const LDefinition* temp4() { return getTemp(3); }
+};
+
+class LSetObjectHasNonBigInt
+    : public LInstructionHelper<1, 2 + BOX_PIECES, 3> {
+ public:
+  LIR_HEADER(SetObjectHasNonBigInt)
+
+  LSetObjectHasNonBigInt(const LAllocation& set, const LBoxAllocation& value,
+                         const LAllocation& hash, const LDefinition& temp1,
+                         const LDefinition& temp2, const LDefinition& temp3)
+      : LInstructionHelper(classOpcode) {
+    setOperand(0, set);
+    setBoxOperand(ValueIndex, value);
+    setOperand(HashIndex, hash);
+    setTemp(0, temp1);
+    setTemp(1, temp2);
+    setTemp(2, temp3);
+  }
+
+  static const size_t ValueIndex = 1;
+  static const size_t HashIndex = 1 + BOX_PIECES;
+
+  const LAllocation* set() { return getOperand(0); }
+  const LAllocation* hash() { return getOperand(HashIndex); }
+  const LDefinition* temp1() { return getTemp(0); }
+  const LDefinition* temp2() { return getTemp(1); }
+  const LDefinition* temp3() { return getTemp(2); }
+};
+
+class LMapObjectHasNonBigInt
+    : public LInstructionHelper<1, 2 + BOX_PIECES, 3> {
+ public:
+  LIR_HEADER(MapObjectHasNonBigInt)
+
+  LMapObjectHasNonBigInt(const LAllocation& map, const LBoxAllocation& key,
+                         const LAllocation& hash, const LDefinition& temp1,
+                         const LDefinition& temp2, const LDefinition& temp3)
+      : LInstructionHelper(classOpcode) {
+    setOperand(0, map);
+    setBoxOperand(KeyIndex, key);
+    setOperand(HashIndex, hash);
+    setTemp(0, temp1);
+    setTemp(1, temp2);
+    setTemp(2, temp3);
+  }
+
+  static const size_t KeyIndex = 1;
+  static const size_t HashIndex = 1 + BOX_PIECES;
+
+  const LAllocation* map() { return getOperand(0); }
+  const LAllocation* hash() { return getOperand(HashIndex); }
+  const LDefinition* temp1() { return getTemp(0); }
+  const LDefinition* temp2() { return getTemp(1); }
+  const LDefinition* temp3() { return getTemp(2); }
+};
+
+class LMapObjectGetNonBigInt
+    : public LInstructionHelper<BOX_PIECES, 2 + BOX_PIECES, 3> {
+ public:
+  LIR_HEADER(MapObjectGetNonBigInt)
+
+  LMapObjectGetNonBigInt(const LAllocation& map, const LBoxAllocation& key,
+                         const LAllocation& hash, const LDefinition& temp1,
+                         const LDefinition& temp2, const LDefinition& temp3)
+      : LInstructionHelper(classOpcode) {
+    setOperand(0, map);
+    setBoxOperand(KeyIndex, key);
+    setOperand(HashIndex, hash);
+    setTemp(0, temp1);
+    setTemp(1, temp2);
+    setTemp(2, temp3);
+  }
+
+  static const size_t KeyIndex = 1;
+  static const size_t HashIndex = 1 + BOX_PIECES;
+
+  const LAllocation* map() { return getOperand(0); }
+  const LAllocation* hash() { return getOperand(HashIndex); }
+  const LDefinition* temp1() { return getTemp(0); }
+  const LDefinition* temp2() { return getTemp(1); }
+  const LDefinition* temp3() { return getTemp(2); }
+};
+
 class LGetNextEntryForIterator : public LInstructionHelper<1, 2, 3> {
  public:
   LIR_HEADER(GetNextEntryForIterator)
@@ -8576,6 +8866,18 @@ class LGuardArrayIsPacked : public LInstructionHelper<0, 1, 2> {
   MGuardArrayIsPacked* mir() { return mir_->toGuardArrayIsPacked(); }
 };
 
+class LGuardElementsAreInt32 : public LInstructionHelper<0, 1, 0> {
+ public:
+  LIR_HEADER(GuardElementsAreInt32)
+
+  explicit LGuardElementsAreInt32(const LAllocation& elements)
+      : LInstructionHelper(classOpcode) {
+    setOperand(0, elements);
+  }
+
+  const LAllocation* elements() { return getOperand(0); }
+};
+
 class LGetPrototypeOf : public LInstructionHelper<BOX_PIECES, 1, 0> {
  public:
   LIR_HEADER(GetPrototypeOf)
@@ -7,6 +7,7 @@
 #include "mozilla/Span.h"           // mozilla::MakeStringSpan
 
 #include <stdint.h>
+#include <stdio.h>
 
 #include "jsapi.h"  // JS_IsExceptionPending, JS_StringEqualsLiteral
 
@@ -21,6 +22,7 @@
 
 #include "jsapi-tests/tests.h"
 #include "util/Text.h"  // js::InflateString
+#include "vm/BigIntType.h"  // js::BigInt::{DigitBits,KaratsubaThreshold}
 
 struct JS_PUBLIC_API JSContext;
 class JS_PUBLIC_API JSString;
@@ -767,3 +769,84 @@ inline bool RadixOutOfRange(uint8_t radix) {
   return true;
 }
 END_TEST(testBigIntToString_RadixOutOfRange)
+
+// Multiply operands with digit lengths around BigInt::KaratsubaThreshold and
+// compare the products with the sum of the products of the first operand and
+// each 16-bit chunk of the second. Those only have one-digit operands, so they
+// use the schoolbook method.
+BEGIN_TEST(testBigIntMultiplyKaratsuba) {
+  JS::Rooted<JS::Value> v(cx, JS::NumberValue(js::BigInt::DigitBits));
+  CHECK(JS_SetProperty(cx, global, "digitBits", v));
+
+  EXEC(
+      "function randomOperand(digits, seed) {"
+      "  var x = 1n;"
+      "  for (var i = 1; i < digits * digitBits / 16; i++) {"
+      "    seed = (Math.imul(seed, 1103515245) + 12345) >>> 0;"
+      "    x = (x << 16n) | BigInt(seed >>> 16);"
+      "  }"
+      "  return x;"
+      "}"
+      "function allOnes(digits) {"
+      "  return (1n << BigInt(digits * digitBits)) - 1n;"
+      "}"
+      "function reference(x, y) {"
+      "  var negative = (x < 0n) !== (y < 0n);"
+      "  if (x < 0n) { x = -x; }"
+      "  if (y < 0n) { y = -y; }"
+      "  var result = 0n;"
+      "  for (var shift = 0n; y; shift += 16n, y >>= 16n) {"
+      "    result += (x * (y & 0xffffn)) << shift;"
+      "  }"
+      "  return negative ? -result : result;"
+      "}"
+      "function checkProducts(xDigits, yDigits) {"
+      "  var xs = [randomOperand(xDigits, 1), allOnes(xDigits)];"
+      "  var ys = [randomOperand(yDigits, 2), allOnes(yDigits)];"
+      "  for (var x of xs) {"
+      "    for (var y of ys) {"
+      "      for (var [a, b] of [[x, y], [-x, y], [x, -y], [-x, -y]]) {"
+      "        var expected = reference(a, b);"
+      "        if (a * b !== expected || b * a !== expected) {"
+      "          return false;"
+      "        }"
+      "      }"
+      "    }"
+      "  }"
+      "  return true;"
+      "}");
+
+  const size_t T = js::BigInt::KaratsubaThreshold;
+
+  // Equal lengths just below, at and just above the threshold, and around
+  // the lengths where the halves reach the threshold.
+  CHECK(checkProducts(T - 1, T - 1));
+  CHECK(checkProducts(T, T));
+  CHECK(checkProducts(T + 1, T + 1));
+  CHECK(checkProducts(2 * T - 1, 2 * T - 1));
+  CHECK(checkProducts(2 * T, 2 * T));
+  CHECK(checkProducts(2 * T + 1, 2 * T + 1));
+
+  // Unequal lengths: one operand below the threshold, chunks of the longer
+  // operand shorter than the threshold, longer than half of the shorter
+  // operand, and shorter than half of it.
+  CHECK(checkProducts(T - 1, 3 * T));
+  CHECK(checkProducts(T, T + 1));
+  CHECK(checkProducts(T, 2 * T + 5));
+  CHECK(checkProducts(T + 1, 3 * T + 2));
+  CHECK(checkProducts(2 * T + 3, 5 * T + 2 * T / 3));
+  CHECK(checkProducts(3 * T, 7 * T + 1));
+
+  return true;
+}
+
+bool checkProducts(size_t xDigits, size_t yDigits) {
+  char code[64];
+  snprintf(code, sizeof(code), "checkProducts(%zu, %zu)", xDigits, yDigits);
+
+  JS::Rooted<JS::Value> v(cx);
+  EVAL(code, &v);
+  CHECK(v.isTrue());
+  return true;
+}
+END_TEST(testBigIntMultiplyKaratsuba)
@@ -0,0 +1,132 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jsapi-tests/tests.h"
+#include "vm/NativeObject.h"
+#include "vm/PropMap.h"
+#include "vm/Shape.h"
+
+using namespace js;
+
+// Deleting properties from a dictionary object removes them from its
+// PropMapTable and from the table's lookup cache. Shrinking GCs only throw the
+// table away for objects with fewer than MinEntriesToKeepTable properties.
+BEGIN_TEST(testDictionaryPropMapTable_deleteAndShrinkingGC) {
+  AutoLeaveZeal nozeal(cx);
+
+  CHECK(JS_DefineProperty(cx, global, "threshold",
+                          DictionaryPropMap::MinEntriesToKeepTable,
+                          JSPROP_ENUMERATE));
+
+  // makeDict(n) returns a dictionary object with the n - 1 properties k1 to
+  // k(n-1). churn looks up every odd key before and after deleting it and
+  // re-adding it, so that stale cache entries would be observed.
+  EXEC(
+      "function makeDict(n) {"
+      "  var o = {};"
+      "  for (var i = 0; i < n; i++) o['k' + i] = i;"
+      "  delete o.k0;"
+      "  return o;"
+      "}"
+      "function churn(o, n) {"
+      "  for (var i = 1; i < n; i += 2) {"
+      "    var k = 'k' + i;"
+      "    if (!(k in o) || o[k] !== i) return false;"
+      "    delete o[k];"
+      "    if (k in o || o[k] !== undefined || o.hasOwnProperty(k)) {"
+      "      return false;"
+      "    }"
+      "    o[k] = -i;"
+      "    if (!(k in o) || o[k] !== -i) return false;"
+      "    delete o[k];"
+      "    if (k in o) return false;"
+      "  }"
+      "  return true;"
+      "}"
+      "function checkDict(o, n) {"
+      "  for (var i = 0; i < n; i++) {"
+      "    var k = 'k' + i;"
+      "    var present = i > 0 && i % 2 === 0;"
+      "    if ((k in o) !== present || o[k] !== (present ? i : undefined)) {"
+      "      return false;"
+      "    }"
+      "  }"
+      "  return Object.keys(o).length === Math.floor((n - 1) / 2);"
+      "}"
+      "var small = makeDict(20), large = makeDict(400);"
+      "var below = makeDict(threshold), at = makeDict(threshold + 1);");
+
+  JS::RootedObject small(cx, globalObject("small"));
+  JS::RootedObject large(cx, globalObject("large"));
+  JS::RootedObject below(cx, globalObject("below"));
+  JS::RootedObject at(cx, globalObject("at"));
+  CHECK(small && large && below && at);
+  CHECK(isDictionary(small) && isDictionary(large) && isDictionary(below) &&
+        isDictionary(at));
+
+  CHECK(evalBool("churn(small, 20) && churn(large, 400)"));
+  CHECK(evalBool("checkDict(small, 20) && checkDict(large, 400)"));
+  CHECK(evalBool("'k1' in below && 'k1' in at"));
+
+  CHECK(hasTable(small) && hasTable(large) && hasTable(below) && hasTable(at));
+  CHECK(tableEntryCount(below) == DictionaryPropMap::MinEntriesToKeepTable - 1);
+  CHECK(tableEntryCount(at) == DictionaryPropMap::MinEntriesToKeepTable);
+
+  shrinkingGC();
+
+  CHECK(!hasTable(small));
+  CHECK(hasTable(large));
+  CHECK(!hasTable(below));
+  CHECK(hasTable(at));
+
+  // Lookups still see the deletions, whether they rebuild the table or use
+  // the one that was kept.
+  CHECK(evalBool("checkDict(small, 20) && checkDict(large, 400)"));
+  CHECK(evalBool("churn(small, 20) && churn(large, 400)"));
+  CHECK(evalBool("checkDict(small, 20) && checkDict(large, 400)"));
+  CHECK(hasTable(small));
+
+  // The large object keeps its table across repeated shrinking GCs.
+  shrinkingGC();
+  CHECK(!hasTable(small));
+  CHECK(hasTable(large));
+  CHECK(evalBool("checkDict(small, 20) && checkDict(large, 400)"));
+
+  return true;
+}
+
+JSObject* globalObject(const char* name) {
+  JS::RootedValue v(cx);
+  if (!JS_GetProperty(cx, global, name, &v) || !v.isObject()) {
+    return nullptr;
+  }
+  return &v.toObject();
+}
+
+static bool isDictionary(JSObject* obj) {
+  return obj->as<NativeObject>().inDictionaryMode();
+}
+
+static bool hasTable(JSObject* obj) {
+  PropMap* map = obj->as<NativeObject>().shape()->propMap();
+  return map->canHaveTable() && map->asLinked()->hasTable();
+}
+
+static uint32_t tableEntryCount(JSObject* obj) {
+  JS::AutoCheckCannotGC nogc;
+  PropMap* map = obj->as<NativeObject>().shape()->propMap();
+  return map->asLinked()->maybeTable(nogc)->entryCount();
+}
+
+void shrinkingGC() {
+  JS::PrepareForFullGC(cx);
+  JS::NonIncrementalGC(cx, JS::GCOptions::Shrink, JS::GCReason::API);
+}
+
+bool evalBool(const char* code) {
+  JS::RootedValue v(cx);
+  EVAL(code, &v);
+  return v.isBoolean() && v.toBoolean();
+}
+END_TEST(testDictionaryPropMapTable_deleteAndShrinkingGC)
@@ -0,0 +1,80 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include <string.h>
+
+#include "gc/GC.h"  // js::gc::FinishGC
+#include "js/OffThreadScriptCompilation.h"
+#include "jsapi-tests/tests.h"
+#include "vm/HelperThreads.h"  // js::SetHelperThreadTaskPriorities
+#include "vm/Monitor.h"        // js::Monitor, js::AutoLockMonitor
+
+BEGIN_TEST(testHelperThreadScheduling) {
+  // Only helper task types can be given a priority, and only once.
+  js::ThreadType mainThread[] = {js::THREAD_TYPE_MAIN};
+  CHECK(!js::SetHelperThreadTaskPriorities(mainThread, 1));
+
+  js::ThreadType duplicate[] = {js::THREAD_TYPE_PARSE, js::THREAD_TYPE_ION,
+                                js::THREAD_TYPE_PARSE};
+  CHECK(!js::SetHelperThreadTaskPriorities(duplicate, 3));
+
+  js::ThreadType parseFirst[] = {js::THREAD_TYPE_PARSE,
+                                 js::THREAD_TYPE_COMPRESS};
+  CHECK(js::SetHelperThreadTaskPriorities(parseFirst, 2));
+
+  bool ok = compileOffThread();
+
+  // Restore the default order.
+  CHECK(js::SetHelperThreadTaskPriorities(nullptr, 0));
+  return ok;
+}
+
+bool compileOffThread() {
+  js::ResetHelperThreadTaskStats();
+
+  const char* chars = "function f() { return 42; }";
+  JS::SourceText<mozilla::Utf8Unit> srcBuf;
+  CHECK(srcBuf.init(cx, chars, strlen(chars), JS::SourceOwnership::Borrowed));
+
+  js::Monitor monitor(js::mutexid::ShellOffThreadState);
+  JS::CompileOptions options(cx);
+  options.forceAsync = true;
+
+  JS::OffThreadToken* token;
+  CHECK(token = JS::CompileOffThread(cx, options, srcBuf, callback, &monitor));
+
+  {
+    // Finish any active GC in case it is blocking off-thread work.
+    js::gc::FinishGC(cx);
+
+    js::AutoLockMonitor lock(monitor);
+    lock.wait();
+  }
+
+  JS::RootedScript script(cx, JS::FinishOffThreadScript(cx, token));
+  CHECK(script);
+
+  js::HelperThreadTaskStats stats;
+  js::GetHelperThreadTaskStats(js::THREAD_TYPE_PARSE, &stats);
+  CHECK(stats.count == 1);
+  CHECK(stats.maxDispatchLatency <= stats.dispatchLatency);
+
+  js::ResetHelperThreadTaskStats();
+  js::GetHelperThreadTaskStats(js::THREAD_TYPE_PARSE, &stats);
+  CHECK(stats.count == 0);
+  CHECK(stats.dispatchLatency == mozilla::TimeDuration());
+
+  return true;
+}
+
+static void callback(JS::OffThreadToken* token, void* context) {
+  js::Monitor& monitor = *static_cast<js::Monitor*>(context);
+
+  js::AutoLockMonitor lock(monitor);
+  lock.notify();
+}
+END_TEST(testHelperThreadScheduling)
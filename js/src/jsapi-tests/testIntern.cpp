@@ -6,6 +6,7 @@
 #include "gc/Marking.h"
 #include "jsapi-tests/tests.h"
 #include "util/Text.h"
+#include "vm/AtomsTable.h"
 #include "vm/JSAtom.h"
 #include "vm/StringType.h"
 
@@ -45,3 +46,40 @@ static void FinalizeCallback(JSFreeOp* fop, JSFinalizeStatus status,
   }
 }
 END_TEST(testPinAcrossGC)
+
+BEGIN_TEST(testAtomizeCacheAcrossSweeping) {
+  static const char someChars[] = "atomize cache chars no other test uses";
+  size_t length = js_strlen(someChars);
+
+  // Put an atom that nothing keeps alive in this context's atomize cache.
+  JSAtom* atom = js::Atomize(cx, someChars, length);
+  CHECK(atom);
+  CHECK(js::Atomize(cx, someChars, length) == atom);
+
+  // Run a full incremental GC until the atoms table starts sweeping. The atom
+  // is unmarked now, so atomizing the same chars mustn't return it from the
+  // cache.
+  JSRuntime* rt = cx->runtime();
+  uint32_t epoch = rt->atoms().sweepEpoch();
+  JS::PrepareForFullGC(cx);
+  js::SliceBudget budget(js::WorkBudget(1));
+  rt->gc.startDebugGC(JS::GCOptions::Normal, budget);
+  while (rt->atoms().sweepEpoch() == epoch &&
+         JS::IsIncrementalGCInProgress(cx)) {
+    rt->gc.debugGCSlice(budget);
+  }
+
+  JS::Rooted<JSAtom*> newAtom(cx, js::Atomize(cx, someChars, length));
+  CHECK(newAtom);
+  if (JS::IsIncrementalGCInProgress(cx)) {
+    JSAtom* unbarriered = newAtom;
+    CHECK(!js::gc::IsAboutToBeFinalizedUnbarriered(&unbarriered));
+  }
+
+  JS::FinishIncrementalGC(cx, JS::GCReason::API);
+
+  CHECK(js::StringEqualsAscii(newAtom, someChars));
+  CHECK(js::Atomize(cx, someChars, length) == newAtom);
+  return true;
+}
+END_TEST(testAtomizeCacheAcrossSweeping)
@@ -0,0 +1,54 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jsapi-tests/testJitWarmUpFixture.h"
+
+// Property accesses in the C++ interpreter use a cache keyed by shape. Check
+// that shape changes between executions of the same op are observed.
+BEGIN_FIXTURE_TEST(JitOptionsFixture, testInterpreterPropertyCache) {
+  CHECK(setJitOption(JSJITCOMPILER_BASELINE_INTERPRETER_ENABLE, 0));
+
+  EXEC(
+      "var results = [];"
+      "function get(o) { return o.x; }"
+      "function set(o, v) { o.x = v; }"
+      "var a = {x: 1}, b = {y: 0, x: 2};"
+      "results.push(get(a), get(a), get(b), get(a));"
+      "Object.defineProperty(a, 'x', {get() { return 'getter'; }});"
+      "results.push(get(a));"
+      "var c = {x: 3};"
+      "set(c, 4); set(c, 5); results.push(c.x);"
+      "Object.freeze(c);"
+      "set(c, 6); results.push(c.x);"
+      "var d = {x: 7}; get(d); delete d.x; results.push(get(d));"
+      "var proto = {x: 'p1'}, e = Object.create(proto);"
+      "results.push(get(e)); proto.x = 'p2'; results.push(get(e));");
+
+  JS_GC(cx);
+
+  EXEC(
+      "results.push(get(a), get(b));"
+      "globalThis.h = 1;"
+      "function readH() { return h; }"
+      "function typeofH() { return typeof h; }"
+      "results.push(readH(), readH(), typeofH());");
+  EXEC("let h = 10; results.push(readH(), typeofH());");
+
+  EXEC(
+      "globalThis.k = 1;"
+      "function typeofK() { return typeof k; }"
+      "results.push(typeofK(), typeofK());"
+      "delete globalThis.k;"
+      "results.push(typeofK());");
+
+  JS::RootedValue v(cx);
+  EVAL("results.join()", &v);
+  CHECK(v.isString());
+  CHECK(JS_LinearStringEqualsLiteral(
+      JS_ASSERT_STRING_IS_LINEAR(v.toString()),
+      "1,1,2,1,getter,5,5,,p1,p2,getter,2,1,1,number,10,number,"
+      "number,number,undefined"));
+  return true;
+}
+END_FIXTURE_TEST(JitOptionsFixture, testInterpreterPropertyCache)
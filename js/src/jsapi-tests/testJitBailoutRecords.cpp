@@ -0,0 +1,112 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jit/JitOptions.h"
+#include "js/experimental/JitBailouts.h"  // js::GetJitBailoutRecords
+#include "jsapi-tests/testJitWarmUpFixture.h"
+#include "vm/JSScript.h"
+
+#include "vm/JSScript-inl.h"
+
+BEGIN_FIXTURE_TEST(JitWarmUpFixture, testJitBailoutRecords) {
+  js::ClearJitBailoutRecords(cx);
+  CHECK(getRecords());
+  EXEC("var records = JSON.parse(json);");
+  CHECK(evalBool("records.sites.length === 0"));
+  CHECK(evalBool("records.droppedBailouts === 0"));
+
+  // Compile |add| for int32 operands, then make it bail out.
+  EXEC(
+      "function add(a, b) { return a + b; }"
+      "for (var i = 0; i < 200; i++) { add(i, 1); }"
+      "add('a', 'b');");
+
+  CHECK(getRecords());
+  EXEC(
+      "var site = JSON.parse(json).sites.find(s => s.op === 'Add');"
+      "var ic = site && site.ic;");
+  CHECK(evalBool("site !== undefined"));
+  CHECK(evalBool("site.kind === 'TranspiledCacheIR'"));
+  CHECK(evalBool("site.bailouts >= 1"));
+  CHECK(evalBool("typeof site.filename === 'string'"));
+  CHECK(evalBool("ic !== null && ic.transpiled"));
+
+  js::ClearJitBailoutRecords(cx);
+  CHECK(getRecords());
+  CHECK(evalBool("JSON.parse(json).sites.length === 0"));
+
+  CHECK(checkUnfixableBailouts());
+
+  return true;
+}
+
+// Spread calls with too many arguments bail out of Ion in a way recompiling
+// doesn't fix. When that becomes frequent, the call IC is no longer transpiled.
+// Ion is only disabled if the same call keeps bailing out after that.
+bool checkUnfixableBailouts() {
+  EXEC(
+      "function count() { return arguments.length; }"
+      "function spread(a) { return count(...a); }"
+      "var few = [1, 2, 3];"
+      "var many = new Array(1000).fill(0);");
+
+  // |spread| is called from C++ so that no caller inlines it.
+  CHECK(callSpread("few", 200));
+  JSScript* script = scriptFor("spread");
+  CHECK(script);
+  CHECK(script->hasIonScript());
+  js::ClearJitBailoutRecords(cx);
+
+  // Every call bails out once. The last one disables the transpiler at the
+  // call and invalidates the script.
+  uint32_t threshold = js::jit::JitOptions.frequentBailoutThreshold * 5;
+  CHECK(callSpread("many", threshold));
+  CHECK(getRecords());
+  EXEC("var site = JSON.parse(json).sites.find(s => s.op === 'SpreadCall');");
+  CHECK(evalBool("site !== undefined && site.kind === 'TooManyArguments'"));
+  CHECK(evalBool("site.ic !== null && site.transpilerDisabled"));
+  script = scriptFor("spread");
+  CHECK(!script->hasIonScript());
+  CHECK(script->canIonCompile());
+
+  // The script is compiled again without transpiling the call.
+  CHECK(callSpread("few", 200));
+  script = scriptFor("spread");
+  CHECK(script->hasIonScript());
+
+  // If the same call keeps bailing out, Ion is disabled for the script.
+  CHECK(callSpread("many", 2 * threshold));
+  script = scriptFor("spread");
+  CHECK(!script->hasIonScript());
+  CHECK(!script->canIonCompile());
+
+  js::ClearJitBailoutRecords(cx);
+  return true;
+}
+
+bool callSpread(const char* argName, uint32_t times) {
+  JS::RootedValue arg(cx);
+  CHECK(JS_GetProperty(cx, global, argName, &arg));
+
+  JS::RootedValue rval(cx);
+  for (uint32_t i = 0; i < times; i++) {
+    CHECK(JS_CallFunctionName(cx, global, "spread", JS::HandleValueArray(arg),
+                              &rval));
+  }
+  return true;
+}
+
+// Store the bailout records in the global |json|.
+bool getRecords() {
+  size_t length;
+  JS::UniqueChars chars = js::GetJitBailoutRecords(cx, &length);
+  CHECK(chars);
+
+  JS::RootedString str(cx, JS_NewStringCopyN(cx, chars.get(), length));
+  CHECK(str);
+  JS::RootedValue v(cx, JS::StringValue(str));
+  CHECK(JS_SetProperty(cx, global, "json", v));
+  return true;
+}
+END_FIXTURE_TEST(JitWarmUpFixture, testJitBailoutRecords)
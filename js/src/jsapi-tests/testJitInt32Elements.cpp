@@ -0,0 +1,138 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jsapi-tests/testJitWarmUpFixture.h"
+#include "vm/NativeObject.h"
+
+// Warp loads elements of arrays that only contain Int32 values unboxed,
+// guarded by the NON_INT32 flag. Store non-Int32 values into such arrays in
+// every way we know of and check the flag is set and the loads see the new
+// values.
+BEGIN_FIXTURE_TEST(JitWarmUpFixture, testJitInt32Elements) {
+  // Compile |load| in Warp with the Int32 element stub, and |store| and
+  // |pushValue| with stubs for Int32 values only.
+  EXEC(
+      "function load(a, i) { return a[i]; }"
+      "function store(a, i, v) { a[i] = v; }"
+      "function pushValue(a, v) { a.push(v); }"
+      "function checkLoads(a, expected) {"
+      "  if (a.length !== expected.length) { return false; }"
+      "  for (var n = 0; n < 100; n++) {"
+      "    for (var i = 0; i < expected.length; i++) {"
+      "      if (!Object.is(load(a, i), expected[i])) { return false; }"
+      "    }"
+      "  }"
+      "  return true;"
+      "}"
+      "for (var i = 0; i < 300; i++) {"
+      "  var warm = [1, 2, 3];"
+      "  load(warm, i % 3);"
+      "  store(warm, i % 3, i);"
+      "  pushValue(warm, i);"
+      "}");
+
+  // Int32-only arrays keep the flag clear.
+  CHECK(checkInt32("var a = [1, 2, 3]; a[1] = 5; a.push(7);"
+                   "var expected = [1, 5, 3, 7];"));
+
+  // Element stores, from the VM and from JIT code.
+  CHECK(checkNonInt32("var a = [1, 2, 3]; a[1] = 1.5;"
+                      "var expected = [1, 1.5, 3];"));
+  CHECK(checkNonInt32("var a = [1, 2, 3]; store(a, 2, 'x');"
+                      "var expected = [1, 2, 'x'];"));
+  CHECK(checkNonInt32("var a = [1, 2, 3]; store(a, 3, null);"
+                      "var expected = [1, 2, 3, null];"));
+  CHECK(checkNonInt32("var a = [1, 2, 3]; a[4] = 5;"
+                      "var expected = [1, 2, 3, undefined, 5];"));
+  CHECK(checkNonInt32("var a = [1, 2, 3]; delete a[1];"
+                      "var expected = [1, undefined, 3];"));
+
+  // push and unshift.
+  CHECK(checkNonInt32("var a = [1, 2]; a.push(0.5);"
+                      "var expected = [1, 2, 0.5];"));
+  CHECK(checkNonInt32("var a = [1, 2]; pushValue(a, {});"
+                      "var expected = [1, 2, a[2]];"));
+  CHECK(checkNonInt32("var a = [1, 2]; a.unshift(true);"
+                      "var expected = [true, 1, 2];"));
+
+  // splice.
+  CHECK(checkNonInt32("var a = [1, 2, 3]; a.splice(1, 0, 'x');"
+                      "var expected = [1, 'x', 2, 3];"));
+  CHECK(checkNonInt32("var a = [1, 2, 3]; a.splice(1, 1, -0);"
+                      "var expected = [1, -0, 3];"));
+
+  // copyWithin and fill.
+  CHECK(checkNonInt32("var a = [1, 2, 3, 4]; a[3] = 0.5; a.copyWithin(0, 2);"
+                      "var expected = [3, 0.5, 3, 0.5];"));
+  CHECK(checkNonInt32("var a = [1, 2, 3]; a.fill(0.5, 1);"
+                      "var expected = [1, 0.5, 0.5];"));
+
+  // sort and reverse move values that are already there, so the flag must
+  // stay set.
+  CHECK(checkNonInt32("var a = [3, 1, 2]; a[0] = 2.5; a.sort();"
+                      "var expected = [1, 2, 2.5];"));
+  CHECK(checkNonInt32("var a = [3, 1, 2]; a.push(undefined); a.sort();"
+                      "var expected = [1, 2, 3, undefined];"));
+  CHECK(checkNonInt32("var a = [3, 1, 2]; a.sort((x, y) => y - x);"
+                      "a[1] = 'x'; var expected = [3, 'x', 1];"));
+  CHECK(checkNonInt32("var a = [1, 2, 3]; a[0] = 'x'; a.reverse();"
+                      "var expected = [3, 2, 'x'];"));
+
+  // defineProperty.
+  CHECK(checkNonInt32(
+      "var a = [1, 2, 3];"
+      "Object.defineProperty(a, 1, {value: 1.5, writable: true,"
+      "                             enumerable: true, configurable: true});"
+      "var expected = [1, 1.5, 3];"));
+  CHECK(checkNonInt32("var a = [1, 2, 3];"
+                      "Object.defineProperty(a, 3, {value: 'x', writable: true,"
+                      "  enumerable: true, configurable: true});"
+                      "var expected = [1, 2, 3, 'x'];"));
+
+  // The Array constructor.
+  CHECK(checkNonInt32("var a = Array(1, 2.5, 3);"
+                      "var expected = [1, 2.5, 3];"));
+  CHECK(checkNonInt32("var a = new Array(3); a[0] = 1; a[2] = 3;"
+                      "var expected = [1, undefined, 3];"));
+
+  // concat.
+  CHECK(checkNonInt32("var a = [1, 2].concat([0.5]);"
+                      "var expected = [1, 2, 0.5];"));
+  CHECK(checkNonInt32("var b = [1, 2]; b[0] = 'x'; var a = b.concat([3]);"
+                      "var expected = ['x', 2, 3];"));
+  CHECK(checkNonInt32("var a = [1, 2].concat(3.5);"
+                      "var expected = [1, 2, 3.5];"));
+
+  return true;
+}
+
+bool denseElementsAreInt32(bool* result) {
+  JS::RootedValue v(cx);
+  EVAL("a", &v);
+  CHECK(v.isObject() && v.toObject().is<js::NativeObject>());
+  *result = v.toObject().as<js::NativeObject>().denseElementsAreInt32();
+  return true;
+}
+
+// |setup| defines the array |a| and the values |expected| it should contain.
+bool checkInt32(const char* setup) {
+  EXEC(setup);
+
+  bool int32;
+  CHECK(denseElementsAreInt32(&int32));
+  CHECK(int32);
+  CHECK(evalBool("checkLoads(a, expected)"));
+  return true;
+}
+
+bool checkNonInt32(const char* setup) {
+  EXEC(setup);
+
+  bool int32;
+  CHECK(denseElementsAreInt32(&int32));
+  CHECK(!int32);
+  CHECK(evalBool("checkLoads(a, expected)"));
+  return true;
+}
+END_FIXTURE_TEST(JitWarmUpFixture, testJitInt32Elements)
@@ -0,0 +1,157 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jsapi-tests/testJitWarmUpFixture.h"
+
+// Map and Set methods called from Baseline and Ion code use dedicated CacheIR
+// ops, which probe the hash table inline for most key types. Run them hot with
+// every kind of key and check the results match the generic natives.
+BEGIN_FIXTURE_TEST(JitWarmUpFixture, testJitMapSet) {
+  EXEC(
+      "var sym = Symbol('k');"
+      "var obj = {};"
+      "var keys = [1, -1, 0x7fffffff, 1.5, NaN, -0, 'str', 'st' + 'r' + 1,"
+      "            sym, obj, 10n, 2n ** 70n, true, null, undefined];"
+      "function mapOps(m, k, v) {"
+      "  m.set(k, v);"
+      "  return [m.has(k), m.get(k), m.delete(k), m.has(k), m.get(k)];"
+      "}"
+      "function setOps(s, k) {"
+      "  s.add(k);"
+      "  return [s.has(k), s.delete(k), s.has(k), s.delete(k)];"
+      "}");
+
+  // Every op has to agree with the result expected from the spec.
+  CHECK(evalBool(
+      "var mapOk = true, setOk = true;"
+      "for (var i = 0; i < 500; i++) {"
+      "  var k = keys[i % keys.length];"
+      "  var r = mapOps(new Map(), k, i);"
+      "  mapOk = mapOk && r[0] && r[1] === i && r[2] && !r[3] &&"
+      "          r[4] === undefined;"
+      "  var s = setOps(new Set(), k);"
+      "  setOk = setOk && s[0] && s[1] && !s[2] && !s[3];"
+      "}"
+      "mapOk && setOk"));
+
+  // Keys are compared with SameValueZero: -0 and +0 are the same key, NaN
+  // matches NaN, BigInts compare by value and strings by contents.
+  CHECK(evalBool(
+      "function lookup(m, k) { return m.get(k); }"
+      "var m = new Map([[-0, 'zero'], [NaN, 'nan'], [2n ** 70n, 'big'],"
+      "                 ['ab', 'str']]);"
+      "var ok = true;"
+      "for (var i = 0; i < 500; i++) {"
+      "  ok = ok && lookup(m, 0) === 'zero' && lookup(m, 0 / -1) === 'zero' &&"
+      "       lookup(m, NaN) === 'nan' && lookup(m, 2n ** 70n) === 'big' &&"
+      "       lookup(m, 'a' + 'b') === 'str' && lookup(m, {}) === undefined;"
+      "}"
+      "ok && [...m.keys()][0] === 0 && Object.is([...m.keys()][0], 0)"));
+
+  // Map.prototype.set and Set.prototype.add return the receiver.
+  CHECK(evalBool(
+      "function chain(m, s, i) { return [m.set(i, i), s.add(i)]; }"
+      "var m = new Map(), s = new Set(), ok = true;"
+      "for (var i = 0; i < 500; i++) {"
+      "  var r = chain(m, s, i);"
+      "  ok = ok && r[0] === m && r[1] === s;"
+      "}"
+      "ok && m.size === 500 && s.size === 500"));
+
+  // Subclass instances use the same paths; other receivers must throw.
+  CHECK(evalBool(
+      "class MyMap extends Map {}"
+      "function has(m, k) { return m.has(k); }"
+      "var mm = new MyMap([[1, 2]]), ok = true;"
+      "for (var i = 0; i < 500; i++) { ok = ok && has(mm, 1) && !has(mm, 2); }"
+      "var threw = false;"
+      "try { has({has: Map.prototype.has}, 1); } catch (e) {"
+      "  threw = e instanceof TypeError;"
+      "}"
+      "ok && threw"));
+
+  // Give every key type its own call sites so that the lookups stay
+  // monomorphic and use the inline hash table probe in Baseline and Warp.
+  // The tables are large enough to have collision chains.
+  EXEC(
+      "function makeLookups() {"
+      "  return {"
+      "    mapGet: new Function('m', 'k', 'return m.get(k);'),"
+      "    mapHas: new Function('m', 'k', 'return m.has(k);'),"
+      "    setHas: new Function('s', 'k', 'return s.has(k);'),"
+      "  };"
+      "}"
+      "function makeTables(present) {"
+      "  var m = new Map(), s = new Set();"
+      "  present.forEach((k, i) => { m.set(k, i); s.add(k); });"
+      "  return {m, s};"
+      "}"
+      "function checkKeys(f, t, present, absent) {"
+      "  for (var iter = 0; iter < 100; iter++) {"
+      "    for (var i = 0; i < present.length; i++) {"
+      "      var k = present[i];"
+      "      if (f.mapGet(t.m, k) !== i || !f.mapHas(t.m, k) ||"
+      "          !f.setHas(t.s, k)) {"
+      "        return false;"
+      "      }"
+      "    }"
+      "    for (var k of absent) {"
+      "      if (f.mapGet(t.m, k) !== undefined || f.mapHas(t.m, k) ||"
+      "          f.setHas(t.s, k)) {"
+      "        return false;"
+      "      }"
+      "    }"
+      "  }"
+      "  return true;"
+      "}"
+      "function range(n, f) {"
+      "  return Array.from({length: n}, (_, i) => f(i));"
+      "}"
+      "function atoms(prefix, n) {"
+      "  var o = {};"
+      "  for (var i = 0; i < n; i++) o[prefix + i] = i;"
+      "  return Object.keys(o);"
+      "}");
+
+  CHECK(evalBool(
+      "var ints = range(100, i => i - 50);"
+      "checkKeys(makeLookups(), makeTables(ints), ints,"
+      "          [100, -51, 0x7fffffff, -0x80000000])"));
+  CHECK(evalBool(
+      "checkKeys(makeLookups(), makeTables([true]), [true], [false]) &&"
+      "checkKeys(makeLookups(), makeTables([null]), [null], []) &&"
+      "checkKeys(makeLookups(), makeTables([undefined]), [undefined], [])"));
+  CHECK(evalBool(
+      "checkKeys(makeLookups(), makeTables(atoms('k', 100)), atoms('k', 100),"
+      "          atoms('x', 20).concat(['', 'k100']))"));
+  CHECK(evalBool(
+      "var syms = range(100, i => Symbol(i));"
+      "checkKeys(makeLookups(), makeTables(syms), syms,"
+      "          range(20, i => Symbol(i)).concat([Symbol.iterator]))"));
+
+  // Object keys are hashed by address. Check them again after a GC has moved
+  // the keys out of the nursery and the tables have been rehashed.
+  EXEC(
+      "var objs = range(100, i => ({i}));"
+      "var objLookups = makeLookups(), objTables = makeTables(objs);"
+      "var objAbsent = range(20, i => ({i})).concat([objTables.m]);");
+  CHECK(evalBool("checkKeys(objLookups, objTables, objs, objAbsent)"));
+  JS_GC(cx);
+  CHECK(evalBool("checkKeys(objLookups, objTables, objs, objAbsent)"));
+
+  // A call site which has only seen atoms must still find a key when it's
+  // passed a non-atom string with the same contents.
+  CHECK(evalBool(
+      "var f = makeLookups(), keys = atoms('k', 10), t = makeTables(keys);"
+      "var ok = checkKeys(f, t, keys, ['x']);"
+      "for (var i = 0; i < 100; i++) {"
+      "  var k = ['k', String(i % 10)].join('');"
+      "  ok = ok && f.mapGet(t.m, k) === i % 10 && f.mapHas(t.m, k) &&"
+      "       f.setHas(t.s, k);"
+      "}"
+      "ok"));
+
+  return true;
+}
+END_FIXTURE_TEST(JitWarmUpFixture, testJitMapSet)
@@ -0,0 +1,69 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jsapi-tests/testJitWarmUpFixture.h"
+
+// Constant array literals of eight or more elements are copied from a template
+// array with JSOp::NewArrayCopy. Warp allocates short ones inline and stores
+// each element, and calls into the VM for longer ones. Every evaluation must
+// produce a new array which is independent of the template and of the arrays
+// produced by earlier evaluations.
+BEGIN_FIXTURE_TEST(JitWarmUpFixture, testJitNewArrayCopy) {
+  // Literals which fit in fixed elements and literals which don't, with Int32
+  // and mixed elements.
+  EXEC(
+      "function short() { return [1, 2, 3, 4, 5, 6, 7, 8]; }"
+      "function mixed() { return [1, 'a', 2.5, true, null, undefined, -0,"
+      "                           'b' + '', 0x7fffffff, -1]; }"
+      "function long() { return [0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,"
+      "                          13, 14, 15, 16, 17, 18, 19]; }"
+      "function same(a, b) {"
+      "  if (a.length !== b.length) { return false; }"
+      "  for (var i = 0; i < a.length; i++) {"
+      "    if (!Object.is(a[i], b[i])) { return false; }"
+      "  }"
+      "  return true;"
+      "}");
+
+  CHECK(checkCopies("short"));
+  CHECK(checkCopies("mixed"));
+  CHECK(checkCopies("long"));
+
+  // Arrays which don't escape can be scalar replaced.
+  CHECK(evalBool(
+      "function sum(i) {"
+      "  var a = [1, 2, 3, 4, 5, 6, 7, 8];"
+      "  return a[i & 7] + a.length;"
+      "}"
+      "var ok = true;"
+      "for (var i = 0; i < 500; i++) { ok = ok && sum(i) === (i & 7) + 9; }"
+      "ok"));
+
+  return true;
+}
+
+// Each call of |fun| in the interpreter, Baseline and Warp must return a new
+// array with the literal's elements, even after earlier results and the
+// first result were written to.
+bool checkCopies(const char* fun) {
+  JS::RootedValue v(cx);
+  EVAL(fun, &v);
+  CHECK(JS_SetProperty(cx, global, "fun", v));
+
+  CHECK(evalBool(
+      "var first = fun(), expected = first.slice(), ok = true;"
+      "var prev = fun();"
+      "first[0] = 'changed';"
+      "first.push(1.5);"
+      "for (var i = 0; i < 500; i++) {"
+      "  var a = fun();"
+      "  ok = ok && a !== prev && a !== first && same(a, expected);"
+      "  a[i % a.length] = {};"
+      "  a.length = i % a.length;"
+      "  prev = a;"
+      "}"
+      "ok && same(fun(), expected) && first[0] === 'changed'"));
+  return true;
+}
+END_FIXTURE_TEST(JitWarmUpFixture, testJitNewArrayCopy)
@@ -0,0 +1,77 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jsapi-tests/testJitWarmUpFixture.h"
+
+// Object.keys is compiled to a non-effectful MObjectKeys for native objects.
+// Objects whose resolve or enumerate hooks define properties when their keys
+// are listed must not use it: reads of other properties after the call would
+// use the shape from before it.
+BEGIN_FIXTURE_TEST(JitWarmUpFixture, testJitObjectKeys) {
+  // Listing the keys of a new function resolves its lazy properties, which
+  // changes its shape between the two reads of |x|.
+  CHECK(evalBool(
+      "function readAround(o) {"
+      "  var a = o.x;"
+      "  var keys = Object.keys(o);"
+      "  var b = o.x;"
+      "  return [a, keys.join(), b, o.y];"
+      "}"
+      "var ok = true;"
+      "for (var i = 0; i < 500; i++) {"
+      "  var f = function() {};"
+      "  f.x = i;"
+      "  f.y = -i;"
+      "  var r = readAround(f);"
+      "  ok = ok && r[0] === i && r[1] === 'x,y' && r[2] === i &&"
+      "       r[3] === -i;"
+      "}"
+      "ok"));
+
+  // The same with plain objects and functions going through one call site.
+  CHECK(evalBool(
+      "var ok = true;"
+      "for (var i = 0; i < 500; i++) {"
+      "  var o = (i % 2) ? function() {} : {};"
+      "  o.x = i;"
+      "  o.y = -i;"
+      "  var r = readAround(o);"
+      "  ok = ok && r[0] === i && r[1] === 'x,y' && r[2] === i &&"
+      "       r[3] === -i;"
+      "}"
+      "ok"));
+
+  // The global resolves standard classes lazily.
+  CHECK(evalBool(
+      "var globalX = 1;"
+      "function readGlobal(g, i) {"
+      "  var a = g.globalX;"
+      "  var n = Object.keys(g).length;"
+      "  g.globalX = i;"
+      "  return a + n - g.globalX;"
+      "}"
+      "var ok = true, count = Object.keys(globalThis).length;"
+      "for (var i = 0; i < 500; i++) {"
+      "  ok = ok && readGlobal(globalThis, i) === (i ? i - 1 : 1) + count - i;"
+      "}"
+      "ok && globalX === 499"));
+
+  // Arguments objects resolve their elements, length and callee lazily.
+  CHECK(evalBool(
+      "function argKeys() {"
+      "  var a = arguments[0];"
+      "  var keys = Object.keys(arguments).join();"
+      "  return [a, keys, arguments[1], arguments.length];"
+      "}"
+      "var ok = true;"
+      "for (var i = 0; i < 500; i++) {"
+      "  var r = argKeys(i, -i);"
+      "  ok = ok && r[0] === i && r[1] === '0,1' && r[2] === -i &&"
+      "       r[3] === 2;"
+      "}"
+      "ok"));
+
+  return true;
+}
+END_FIXTURE_TEST(JitWarmUpFixture, testJitObjectKeys)
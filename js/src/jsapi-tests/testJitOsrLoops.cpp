@@ -0,0 +1,102 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jit/IonScript.h"
+#include "jit/JitOptions.h"
+#include "jsapi-tests/testJitWarmUpFixture.h"
+#include "vm/BytecodeUtil.h"
+#include "vm/JSScript.h"
+
+#include "vm/JSScript-inl.h"
+
+// When a Baseline frame wants to OSR at a loop head other than the one the
+// IonScript was compiled for, Ion waits for osrPcMismatchesBeforeRecompile
+// mismatches before recompiling, unless the frame can't get to the IonScript's
+// loop any more. Each function below is compiled for OSR at one loop, bails
+// out once without invalidating, and then reaches another loop in Baseline.
+BEGIN_FIXTURE_TEST(JitWarmUpFixture, testJitOsrLoops) {
+  // Every loop below is shorter than the number of mismatches we'd wait for.
+  CHECK(Iterations < js::jit::JitOptions.osrPcMismatchesBeforeRecompile);
+
+  // The additions of 0.5 haven't run when the functions are compiled, so they
+  // bail out of Ion the first time they run. A single bailout of this kind
+  // doesn't invalidate the IonScript.
+  EXEC(
+      "function sequential(n) {"
+      "  var a = 0;"
+      "  for (var i = 0; i < n; i++) { a += i; }"
+      "  a += 0.5;"
+      "  var b = 0;"
+      "  for (var j = 0; j < n; j++) { b += j; }"
+      "  return a + b;"
+      "}"
+      "function nested(n) {"
+      "  var a = 0;"
+      "  for (var i = 0; i < n / 100; i++) {"
+      "    for (var j = 0; j < 100; j++) { a += j; }"
+      "    if (i === 1) { a += 0.5; }"
+      "  }"
+      "  return a;"
+      "}"
+      "function enclosing(n) {"
+      "  var a = 0;"
+      "  for (var i = 0; i < n; i++) {"
+      "    a += i;"
+      "    if (i === n - 10) {"
+      "      a += 0.5;"
+      "      for (var j = 0; j < 50; j++) { a += j; }"
+      "    }"
+      "  }"
+      "  return a;"
+      "}");
+
+  // The first loop has finished when the frame gets to the second one, so
+  // the script is recompiled for the second loop on the first mismatch.
+  CHECK(checkOsrLoop("sequential", 1));
+
+  // The frame bails out of the inner loop's IonScript and gets to the outer
+  // loop head. It will get to the inner loop again, so there's no
+  // recompilation.
+  CHECK(checkOsrLoop("nested", 1));
+
+  // The frame bails out of the outer loop's IonScript inside the outer loop
+  // and gets to the inner loop head. It will get back to the outer loop, so
+  // there's no recompilation.
+  CHECK(checkOsrLoop("enclosing", 0));
+
+  return true;
+}
+
+static constexpr uint32_t Iterations = 1000;
+
+// Call |name| once and check that its IonScript was compiled for OSR at the
+// loop head with index |loopIndex|, counting in bytecode order.
+bool checkOsrLoop(const char* name, size_t loopIndex) {
+  JS::RootedValue arg(cx, JS::Int32Value(Iterations));
+  JS::RootedValue rval(cx);
+  CHECK(JS_CallFunctionName(cx, global, name, JS::HandleValueArray(arg),
+                            &rval));
+
+  JS::RootedValue v(cx);
+  CHECK(JS_GetProperty(cx, global, name, &v));
+  JS::RootedFunction fun(cx, JS_GetObjectFunction(&v.toObject()));
+  CHECK(fun);
+  JSScript* script = JS_GetFunctionScript(cx, fun);
+  CHECK(script);
+  CHECK(script->hasIonScript());
+
+  jsbytecode* loopHead = nullptr;
+  size_t index = 0;
+  for (jsbytecode* pc = script->code(); pc < script->codeEnd();
+       pc += js::GetBytecodeLength(pc)) {
+    if (JSOp(*pc) == JSOp::LoopHead && index++ == loopIndex) {
+      loopHead = pc;
+      break;
+    }
+  }
+  CHECK(loopHead);
+  CHECK(script->ionScript()->osrPc() == loopHead);
+  return true;
+}
+END_FIXTURE_TEST(JitWarmUpFixture, testJitOsrLoops)
@@ -0,0 +1,65 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jsapi-tests/testJitWarmUpFixture.h"
+#include "vm/JSContext.h"
+
+// Ion code calls shared stubs for post barriers. Store nursery objects into
+// tenured objects from Ion code and check they're still reachable after a
+// minor GC.
+BEGIN_FIXTURE_TEST(JitWarmUpFixture, testJitPostBarrierStubs) {
+  EXEC(
+      "var holder = {x: null};"
+      "var elems = [null, null, null, null];"
+      "var map = new Map();"
+      "function storeProp(o, v) { o.x = v; }"
+      "function storeElem(a, i, v) { a[i] = v; }"
+      "function sumMap(m) {"
+      "  var sum = 0;"
+      "  for (var [k, v] of m) { sum += k.n + v.n; }"
+      "  return sum;"
+      "}");
+
+  // Tenure the holders.
+  JS_GC(cx);
+
+  EXEC(
+      "var mapSum = 0;"
+      "for (var i = 0; i < 500; i++) {"
+      "  storeProp(holder, {n: i});"
+      "  storeElem(elems, i % 4, {n: i});"
+      "  if (i % 100 === 0) { map.set({n: i}, {n: 1}); }"
+      "  mapSum = sumMap(map);"
+      "}");
+
+  cx->minorGC(JS::GCReason::API);
+
+  JS::RootedValue v(cx);
+  EVAL(
+      "[holder.x.n, elems.map(e => e.n).join(), mapSum, sumMap(map)].join()",
+      &v);
+  CHECK(v.isString());
+  CHECK(JS_LinearStringEqualsLiteral(JS_ASSERT_STRING_IS_LINEAR(v.toString()),
+                                     "499,496,497,498,499,1005,1005"));
+
+  // The stubs only save general purpose registers, so the call sites must
+  // keep doubles that are live across the barrier.
+  CHECK(evalBool(
+      "function storeAroundDouble(o, a, i, d) {"
+      "  var x = d * 1.5;"
+      "  var y = d + 0.25;"
+      "  o.x = {n: i};"
+      "  a[i % 4] = {n: x};"
+      "  return x * 2 + y;"
+      "}"
+      "var ok = true;"
+      "for (var i = 0; i < 500; i++) {"
+      "  var d = i + 0.5;"
+      "  ok = ok && storeAroundDouble(holder, elems, i, d) === d * 4 + 0.25 &&"
+      "       holder.x.n === i && elems[i % 4].n === d * 1.5;"
+      "}"
+      "ok"));
+  return true;
+}
+END_FIXTURE_TEST(JitWarmUpFixture, testJitPostBarrierStubs)
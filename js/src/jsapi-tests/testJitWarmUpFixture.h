@@ -0,0 +1,80 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#ifndef jsapi_tests_testJitWarmUpFixture_h
+#define jsapi_tests_testJitWarmUpFixture_h
+
+#include "js/Vector.h"
+#include "jsapi-tests/tests.h"
+
+// Fixture for tests which change global JIT compiler options. Options set with
+// setJitOption are restored when the test finishes, whether or not it passed.
+struct JitOptionsFixture : public JSAPITest {
+  struct SavedOption {
+    JSJitCompilerOption opt;
+    uint32_t value;
+  };
+  js::Vector<SavedOption, 4, js::SystemAllocPolicy> savedOptions;
+
+  virtual ~JitOptionsFixture() {}
+
+  bool setJitOption(JSJitCompilerOption opt, uint32_t value) {
+    uint32_t old;
+    CHECK(JS_GetGlobalJitCompilerOption(cx, opt, &old));
+    CHECK(savedOptions.append(SavedOption{opt, old}));
+    JS_SetGlobalJitCompilerOption(cx, opt, value);
+    return true;
+  }
+
+  virtual void uninit() override {
+    // Restore in reverse order, so that an option which was set more than
+    // once gets its original value back.
+    while (!savedOptions.empty()) {
+      SavedOption saved = savedOptions.popCopy();
+      JS_SetGlobalJitCompilerOption(cx, saved.opt, saved.value);
+    }
+    JSAPITest::uninit();
+  }
+
+  bool evalBool(const char* code) {
+    JS::RootedValue v(cx);
+    EVAL(code, &v);
+    return v.isBoolean() && v.toBoolean();
+  }
+
+  // The script of the function stored in the global property |name|.
+  JSScript* scriptFor(const char* name) {
+    JS::RootedValue v(cx);
+    if (!JS_GetProperty(cx, global, name, &v) || !v.isObject()) {
+      return nullptr;
+    }
+    JS::RootedFunction fun(cx, JS_GetObjectFunction(&v.toObject()));
+    return fun ? JS_GetFunctionScript(cx, fun) : nullptr;
+  }
+};
+
+// Compile hot code quickly and on the main thread, so that a few hundred
+// iterations are enough to run it in Baseline and then in Warp.
+struct JitWarmUpFixture : public JitOptionsFixture {
+  static constexpr uint32_t BaselineWarmUpThreshold = 10;
+  static constexpr uint32_t IonWarmUpThreshold = 30;
+
+  virtual ~JitWarmUpFixture() {}
+
+  virtual bool init() override {
+    if (!JitOptionsFixture::init()) {
+      return false;
+    }
+
+    return setJitOption(JSJITCOMPILER_BASELINE_WARMUP_TRIGGER,
+                        BaselineWarmUpThreshold) &&
+           setJitOption(JSJITCOMPILER_ION_NORMAL_WARMUP_TRIGGER,
+                        IonWarmUpThreshold) &&
+           setJitOption(JSJITCOMPILER_OFFTHREAD_COMPILATION_ENABLE, 0);
+  }
+};
+
+#endif /* !jsapi_tests_testJitWarmUpFixture_h */
@@ -0,0 +1,128 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jit/BaselineJIT.h"
+#include "jit/JitOptions.h"
+#include "jsapi-tests/testJitWarmUpFixture.h"
+#include "vm/JSScript.h"
+
+#include "vm/JSScript-inl.h"
+
+BEGIN_FIXTURE_TEST(JitOptionsFixture, testJitWarmUpThresholds_largeScripts) {
+  EXEC(
+      "function small(x) { return x + 1; }"
+      "function makeBig(n) {"
+      "  return new Function('x', 'var y = 0;' + 'y += x;'.repeat(n) +"
+      "                           'return y;');"
+      "}"
+      "var medium = makeBig(1000);"
+      "var huge = makeBig(100000);");
+
+  uint32_t base = js::jit::JitOptions.baselineJitWarmUpThreshold;
+
+  JSScript* script = scriptFor("small");
+  CHECK(script);
+  CHECK(script->length() <= js::jit::JitOptions.baselineJitLargeScriptSize);
+  CHECK_EQUAL(js::jit::ComputeBaselineJitWarmUpThreshold(script), base);
+
+  script = scriptFor("medium");
+  CHECK(script);
+  CHECK(script->length() > js::jit::JitOptions.baselineJitLargeScriptSize);
+  uint32_t threshold = js::jit::ComputeBaselineJitWarmUpThreshold(script);
+  CHECK(threshold > base);
+  CHECK(threshold < base * js::jit::BaselineMaxWarmUpScale);
+
+  script = scriptFor("huge");
+  CHECK(script);
+  CHECK_EQUAL(js::jit::ComputeBaselineJitWarmUpThreshold(script),
+              base * js::jit::BaselineMaxWarmUpScale);
+
+  // Scaling can be disabled.
+  uint32_t savedSize = js::jit::JitOptions.baselineJitLargeScriptSize;
+  js::jit::JitOptions.baselineJitLargeScriptSize = 0;
+  threshold = js::jit::ComputeBaselineJitWarmUpThreshold(script);
+  js::jit::JitOptions.baselineJitLargeScriptSize = savedSize;
+  CHECK_EQUAL(threshold, base);
+
+  return true;
+}
+END_FIXTURE_TEST(JitOptionsFixture, testJitWarmUpThresholds_largeScripts)
+
+// Scripts which already have a threshold pick up later changes to the option.
+BEGIN_FIXTURE_TEST(JitOptionsFixture, testJitWarmUpThresholds_optionChange) {
+  CHECK(setJitOption(JSJITCOMPILER_BASELINE_WARMUP_TRIGGER, 1000));
+  EXEC(
+      "function f(x) { return x + 1; }"
+      "for (var i = 0; i < 100; i++) f(i);");
+  JSScript* script = scriptFor("f");
+  CHECK(script);
+  CHECK(!script->hasBaselineScript());
+
+  CHECK(setJitOption(JSJITCOMPILER_BASELINE_WARMUP_TRIGGER, 20));
+  EXEC("f(0);");
+  script = scriptFor("f");
+  CHECK(script->hasBaselineScript());
+  CHECK_EQUAL(script->jitScript()->baselineJitWarmUpThreshold(script), 20u);
+
+  return true;
+}
+END_FIXTURE_TEST(JitOptionsFixture, testJitWarmUpThresholds_optionChange)
+
+// Attaching a Baseline IC stub when a script is about to be compiled with Warp
+// lowers its warm-up count, so that Warp compiles it once the stubs settle.
+BEGIN_FIXTURE_TEST(JitWarmUpFixture,
+                   testJitWarmUpThresholds_stubAttachDelaysIon) {
+  CHECK(setJitOption(JSJITCOMPILER_ION_NORMAL_WARMUP_TRIGGER, IonThreshold));
+
+  EXEC(
+      "function getA(o) { return o.a; }"
+      "var first = {a: 1};"
+      "var second = {b: 2, a: 3};");
+
+  uint32_t delay = js::jit::JitOptions.ionWarmUpAfterStubAttach;
+  CHECK(delay > 0 && delay < IonThreshold / 2);
+
+  // Warm up to just below the Ion threshold with a single shape. The function
+  // is called from C++ so that no caller inlines it.
+  CHECK(callGetA("first", IonThreshold - delay / 2));
+  JSScript* script = scriptFor("getA");
+  CHECK(script);
+  CHECK(script->hasBaselineScript());
+  CHECK(!script->hasIonScript());
+  CHECK(script->getWarmUpCount() >= IonThreshold - delay / 2);
+
+  // A second shape attaches a new stub, which takes the warm-up count back to
+  // |delay| calls below the threshold.
+  CHECK(callGetA("second", 1));
+  script = scriptFor("getA");
+  CHECK(!script->hasIonScript());
+  CHECK(script->getWarmUpCount() <= IonThreshold - delay);
+
+  CHECK(callGetA("first", delay / 2));
+  script = scriptFor("getA");
+  CHECK(!script->hasIonScript());
+
+  // Without further stubs, the script is compiled after |delay| calls.
+  CHECK(callGetA("second", delay));
+  script = scriptFor("getA");
+  CHECK(script->hasIonScript());
+
+  return true;
+}
+
+static constexpr uint32_t IonThreshold = 1000;
+
+bool callGetA(const char* argName, uint32_t times) {
+  JS::RootedValue arg(cx);
+  CHECK(JS_GetProperty(cx, global, argName, &arg));
+
+  JS::RootedValue rval(cx);
+  for (uint32_t i = 0; i < times; i++) {
+    CHECK(JS_CallFunctionName(cx, global, "getA", JS::HandleValueArray(arg),
+                              &rval));
+  }
+  return true;
+}
+END_FIXTURE_TEST(JitWarmUpFixture,
+                 testJitWarmUpThresholds_stubAttachDelaysIon)
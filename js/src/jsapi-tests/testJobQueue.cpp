@@ -0,0 +1,49 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/TimeStamp.h"
+
+#include "jsfriendapi.h"
+
+#include "jsapi-tests/tests.h"
+
+using namespace JS;
+
+BEGIN_TEST(testJobQueue_RunJobsWithBudget) {
+  EXEC("var count = 0; function job() { count++; }");
+
+  RootedValue v(cx);
+  EVAL("job", &v);
+  RootedObject job(cx, &v.toObject());
+
+  constexpr size_t NumJobs = 20;
+  for (size_t i = 0; i < NumJobs; i++) {
+    CHECK(js::EnqueueJob(cx, job));
+  }
+
+  js::JobQueueMetrics metrics;
+  js::GetJobQueueMetrics(cx, &metrics);
+  CHECK(metrics.queueLength == NumJobs);
+  CHECK(metrics.maxQueueLength >= NumJobs);
+
+  // A zero budget still runs one batch of jobs.
+  CHECK(!js::RunJobsWithBudget(cx, mozilla::TimeDuration()));
+  js::GetJobQueueMetrics(cx, &metrics);
+  CHECK(metrics.lastDrainJobsRun > 0);
+  CHECK(metrics.lastDrainJobsRun < NumJobs);
+  CHECK(metrics.queueLength == NumJobs - metrics.lastDrainJobsRun);
+
+  CHECK(js::RunJobsWithBudget(cx, mozilla::TimeDuration::FromSeconds(3600)));
+  js::GetJobQueueMetrics(cx, &metrics);
+  CHECK(metrics.queueLength == 0);
+
+  EVAL("count", &v);
+  CHECK(v.isInt32(NumJobs));
+
+  return true;
+}
+END_TEST(testJobQueue_RunJobsWithBudget)
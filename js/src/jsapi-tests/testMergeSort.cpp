@@ -0,0 +1,174 @@
+/* -*- Mode: C++; tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+ * vim: set ts=8 sts=2 et sw=2 tw=80:
+ */
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "ds/Sort.h"
+
+#include "jsapi-tests/tests.h"
+
+using namespace js;
+
+namespace {
+
+// Elements are ordered by key only; the id records the original position so
+// the tests can check the sort is stable.
+struct SortElement {
+  int key;
+  size_t id;
+};
+
+// Compare keys, counting the comparisons. Fail the comparison with index
+// |failAt| to simulate a comparator that throws.
+struct CountingComparator {
+  size_t* count;
+  size_t failAt;
+
+  bool operator()(const SortElement& a, const SortElement& b,
+                  bool* lessOrEqualp) {
+    if ((*count)++ == failAt) {
+      return false;
+    }
+    *lessOrEqualp = a.key <= b.key;
+    return true;
+  }
+};
+
+const size_t NoFailure = SIZE_MAX;
+const size_t MaxElements = 64;
+
+}  // namespace
+
+BEGIN_TEST(testMergeSort) {
+  // Already sorted, with runs of equal keys: one linear pass, order kept.
+  int sorted[] = {1, 1, 2, 3, 3, 3, 4, 7, 7, 9};
+  CHECK(checkSort(sorted, std::size(sorted)));
+  CHECK(comparisons == std::size(sorted) - 1);
+
+  // Strictly descending: reversed in one linear pass.
+  int descending[] = {9, 8, 7, 6, 5, 4, 3, 2, 1, 0};
+  CHECK(checkSort(descending, std::size(descending)));
+  CHECK(comparisons == std::size(descending) - 1);
+
+  // Descending but with equal neighbours. Reversing this would swap equal
+  // keys, so it must be sorted normally and stay stable.
+  int nonAscending[] = {9, 9, 8, 7, 7, 7, 5, 3, 3, 1};
+  CHECK(checkSort(nonAscending, std::size(nonAscending)));
+
+  int descendingThenEqual[] = {5, 4, 3, 2, 1, 1};
+  CHECK(checkSort(descendingThenEqual, std::size(descendingThenEqual)));
+
+  // Sorted prefixes followed by unsorted elements.
+  int partial1[] = {1, 2, 3, 4, 5, 6, 7, 8, 0, 4, 2, 4, 9, 1};
+  CHECK(checkSort(partial1, std::size(partial1)));
+
+  int partial2[] = {8, 6, 4, 2, 3, 5, 7, 9, 1, 1, 6};
+  CHECK(checkSort(partial2, std::size(partial2)));
+
+  int partial3[] = {2, 2, 2, 2, 1, 2, 2, 1, 1, 2, 1, 2, 2, 2, 1};
+  CHECK(checkSort(partial3, std::size(partial3)));
+
+  // A longer mixed input that takes several merge passes.
+  int mixed[MaxElements];
+  for (size_t i = 0; i < MaxElements; i++) {
+    mixed[i] = int((i * 37) % 11);
+  }
+  CHECK(checkSort(mixed, MaxElements));
+
+  // A run which breaks late is kept as the first run: only the remaining
+  // elements are sorted and then merged with it. Sorting the whole array
+  // instead takes more than 190 comparisons for these inputs.
+  const size_t runLength = 48;
+  int lateAscending[MaxElements];
+  int lateDescending[MaxElements];
+  for (size_t i = 0; i < runLength; i++) {
+    lateAscending[i] = int(2 * i);
+    lateDescending[i] = int(2 * (runLength - 1 - i));
+  }
+  for (size_t i = runLength; i < MaxElements; i++) {
+    lateAscending[i] = lateDescending[i] = int(((i - runLength) * 37) % 50);
+  }
+  CHECK(checkSort(lateAscending, MaxElements));
+  CHECK(comparisons < 160);
+  CHECK(checkSort(lateDescending, MaxElements));
+  CHECK(comparisons < 160);
+
+  // Two elements, in and out of order.
+  int two[] = {2, 1};
+  CHECK(checkSort(two, 2));
+  int twoEqual[] = {1, 1};
+  CHECK(checkSort(twoEqual, 2));
+
+  // A failing comparator stops the sort. While scanning a descending run
+  // nothing has been moved yet, so the input must be left as it was.
+  for (size_t failAt = 0; failAt < std::size(descending) - 1; failAt++) {
+    CHECK(checkFailure(descending, std::size(descending), failAt,
+                       /* unchanged = */ true));
+  }
+
+  // Failures later on, while sorting or merging, leave the array in an
+  // unspecified order, but the sort must still report the failure.
+  size_t total = 0;
+  CHECK(sortElements(mixed, MaxElements, NoFailure, &total));
+  for (size_t failAt = 0; failAt < total; failAt += 7) {
+    CHECK(checkFailure(mixed, MaxElements, failAt, /* unchanged = */ false));
+  }
+
+  return true;
+}
+
+size_t comparisons = 0;
+SortElement elements[MaxElements];
+SortElement scratch[MaxElements];
+
+bool sortElements(const int* keys, size_t length, size_t failAt,
+                  size_t* countp) {
+  MOZ_RELEASE_ASSERT(length <= MaxElements);
+  for (size_t i = 0; i < length; i++) {
+    elements[i] = {keys[i], i};
+  }
+
+  *countp = 0;
+  return MergeSort(elements, length, scratch,
+                   CountingComparator{countp, failAt});
+}
+
+// Sort |keys| and compare the result with a simple stable insertion sort.
+bool checkSort(const int* keys, size_t length) {
+  CHECK(sortElements(keys, length, NoFailure, &comparisons));
+
+  SortElement expected[MaxElements];
+  for (size_t i = 0; i < length; i++) {
+    SortElement e = {keys[i], i};
+    size_t j = i;
+    while (j > 0 && expected[j - 1].key > e.key) {
+      expected[j] = expected[j - 1];
+      j--;
+    }
+    expected[j] = e;
+  }
+
+  for (size_t i = 0; i < length; i++) {
+    CHECK_EQUAL(elements[i].key, expected[i].key);
+    CHECK_EQUAL(elements[i].id, expected[i].id);
+  }
+  return true;
+}
+
+bool checkFailure(const int* keys, size_t length, size_t failAt,
+                  bool unchanged) {
+  size_t count;
+  CHECK(!sortElements(keys, length, failAt, &count));
+  CHECK(count == failAt + 1);
+
+  if (unchanged) {
+    for (size_t i = 0; i < length; i++) {
+      CHECK_EQUAL(elements[i].key, keys[i]);
+      CHECK_EQUAL(elements[i].id, i);
+    }
+  }
+  return true;
+}
+END_TEST(testMergeSort)
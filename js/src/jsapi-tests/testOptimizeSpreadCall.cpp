@@ -0,0 +1,142 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "jsapi-tests/tests.h"
+
+// f(...operand) skips the iteration protocol (JSOp::OptimizeSpreadCall) when
+// the operand is a name or a property access on a name or |this|. The operand
+// must still be evaluated once, and anything other than a packed array with
+// the original iteration behaviour must still go through the iterator.
+BEGIN_TEST(testOptimizeSpreadCall_propertyOperand) {
+  EXEC(
+      "function args() { return Array.prototype.slice.call(arguments); }"
+      "function same(a, b) {"
+      "  if (a.length !== b.length) return false;"
+      "  for (var i = 0; i < a.length; i++) {"
+      "    if (!Object.is(a[i], b[i])) return false;"
+      "  }"
+      "  return true;"
+      "}"
+      "function viaIterator(v) {"
+      "  var r = [];"
+      "  for (var x of v) r.push(x);"
+      "  return r;"
+      "}");
+
+  // A getter operand runs exactly once per call, on every path.
+  CHECK(evalBool(
+      "var count = 0;"
+      "var obj = { get items() { count++; return [1, 2, 3]; } };"
+      "var holder = { obj };"
+      "var ok = true;"
+      "for (var i = 0; i < 200; i++) {"
+      "  ok = ok && same(args(...obj.items), [1, 2, 3]) &&"
+      "       same(args(...holder.obj['items']), [1, 2, 3]);"
+      "}"
+      "ok && count === 400"));
+
+  CHECK(evalBool(
+      "var count = 0;"
+      "var o = {"
+      "  get items() { count++; return [4, 5]; },"
+      "  run() { return args(...this.items); },"
+      "};"
+      "var ok = true;"
+      "for (var i = 0; i < 200; i++) ok = ok && same(o.run(), [4, 5]);"
+      "ok && count === 200"));
+
+  // The same holds for |new| and for operands whose getter throws.
+  CHECK(evalBool(
+      "var count = 0;"
+      "function C(a, b) { this.sum = a + b; }"
+      "var obj = { get items() { count++; return [1, 2]; } };"
+      "var ok = true;"
+      "for (var i = 0; i < 200; i++) ok = ok && new C(...obj.items).sum === 3;"
+      "var thrower = { get items() { count++; throw 'getter'; } };"
+      "var caught = false;"
+      "try { args(...thrower.items); } catch (e) { caught = e === 'getter'; }"
+      "ok && caught && count === 201"));
+
+  // Holey arrays and arrays with elements beyond their dense part read holes
+  // from the prototype chain, like the iterator does.
+  CHECK(evalBool(
+      "var obj = { holey: [1, , 3], sparse: [] };"
+      "obj.sparse[4] = 'x';"
+      "Array.prototype[1] = 'proto';"
+      "var ok = true;"
+      "for (var i = 0; i < 200; i++) {"
+      "  ok = ok && same(args(...obj.holey), [1, 'proto', 3]) &&"
+      "       same(args(...obj.sparse), viaIterator(obj.sparse)) &&"
+      "       same(args(...obj.sparse), [undefined, 'proto', undefined,"
+      "                                  undefined, 'x']);"
+      "}"
+      "delete Array.prototype[1];"
+      "ok"));
+
+  // Non-array operands, subclasses and arrays with their own iterator aren't
+  // packed arrays with the default iteration behaviour.
+  CHECK(evalBool(
+      "class MyArray extends Array {"
+      "  *[Symbol.iterator]() { yield 'sub'; }"
+      "}"
+      "var own = [1, 2];"
+      "own[Symbol.iterator] = function*() { yield 'own'; };"
+      "var obj = {"
+      "  str: 'ab', set: new Set([7, 8]), typed: new Int8Array([5, 6]),"
+      "  sub: MyArray.from([1, 2]), own,"
+      "};"
+      "var ok = true;"
+      "for (var i = 0; i < 200; i++) {"
+      "  ok = ok && same(args(...obj.str), ['a', 'b']) &&"
+      "       same(args(...obj.set), [7, 8]) &&"
+      "       same(args(...obj.typed), [5, 6]) &&"
+      "       same(args(...obj.sub), ['sub']) &&"
+      "       same(args(...obj.own), ['own']);"
+      "}"
+      "ok"));
+
+  // A patched Array.prototype[Symbol.iterator] is called for packed arrays.
+  CHECK(evalBool(
+      "var obj = { items: [1, 2, 3] };"
+      "function spread() { return args(...obj.items); }"
+      "var ok = true;"
+      "for (var i = 0; i < 200; i++) ok = ok && same(spread(), [1, 2, 3]);"
+      "var original = Array.prototype[Symbol.iterator];"
+      "var calls = 0;"
+      "Array.prototype[Symbol.iterator] = function() {"
+      "  calls++;"
+      "  return original.call(this.map(x => x * 10));"
+      "};"
+      "for (var i = 0; i < 200; i++) ok = ok && same(spread(), [10, 20, 30]);"
+      "Array.prototype[Symbol.iterator] = original;"
+      "ok && calls === 200 && same(spread(), [1, 2, 3])"));
+
+  // So is a patched %ArrayIteratorPrototype%.next.
+  CHECK(evalBool(
+      "var obj = { items: [1, 2, 3] };"
+      "function spread() { return args(...obj.items); }"
+      "var ok = true;"
+      "for (var i = 0; i < 200; i++) ok = ok && same(spread(), [1, 2, 3]);"
+      "var ArrayIteratorPrototype ="
+      "    Object.getPrototypeOf([][Symbol.iterator]());"
+      "var originalNext = ArrayIteratorPrototype.next;"
+      "var calls = 0;"
+      "ArrayIteratorPrototype.next = function() {"
+      "  calls++;"
+      "  var r = originalNext.call(this);"
+      "  return r.done ? r : { value: -r.value, done: false };"
+      "};"
+      "for (var i = 0; i < 200; i++) ok = ok && same(spread(), [-1, -2, -3]);"
+      "ArrayIteratorPrototype.next = originalNext;"
+      "ok && calls === 800 && same(spread(), [1, 2, 3])"));
+
+  return true;
+}
+
+bool evalBool(const char* code) {
+  JS::RootedValue v(cx);
+  EVAL(code, &v);
+  return v.isBoolean() && v.toBoolean();
+}
+END_TEST(testOptimizeSpreadCall_propertyOperand)
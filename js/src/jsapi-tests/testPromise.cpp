@@ -168,3 +168,66 @@ BEGIN_TEST(testPromise_PromiseCatch) {
   return true;
 }
 END_TEST(testPromise_PromiseCatch)
+
+// Awaiting a primitive in an async function doesn't allocate a promise unless
+// async stack capture is enabled. Either way, awaits of primitives, thenables
+// and promises in async functions and async generators have to resume in the
+// order the spec gives, interleaved with other promise jobs.
+BEGIN_TEST(testPromise_AwaitOrdering) {
+  EXEC(
+      "var log = [];"
+      "async function f(name, v) {"
+      "  log.push(name + 1);"
+      "  await v;"
+      "  log.push(name + 2);"
+      "  await v;"
+      "  log.push(name + 3);"
+      "}"
+      "async function* g(name, v) {"
+      "  log.push(name + 1);"
+      "  await v;"
+      "  log.push(name + 2);"
+      "  await v;"
+      "  log.push(name + 3);"
+      "}"
+      "var thenable = { then(r) { log.push('then'); r(); } };"
+      "function start() {"
+      "  log = [];"
+      "  Promise.resolve().then(() => log.push('m1'))"
+      "                   .then(() => log.push('m2'))"
+      "                   .then(() => log.push('m3'))"
+      "                   .then(() => log.push('m4'));"
+      "  f('p', 1);"
+      "  g('g', 2).next();"
+      "  f('t', thenable);"
+      "  f('q', Promise.resolve());"
+      "  log.push('sync');"
+      "}");
+
+  bool oldAsyncStack = JS::ContextOptionsRef(cx).asyncStack();
+
+  JS::ContextOptionsRef(cx).setAsyncStack(false);
+  CHECK(!JS::IsAsyncStackCaptureEnabledForRealm(cx));
+  bool ok = checkOrder();
+
+  JS::ContextOptionsRef(cx).setAsyncStack(true);
+  CHECK(JS::IsAsyncStackCaptureEnabledForRealm(cx));
+  ok = ok && checkOrder();
+
+  JS::ContextOptionsRef(cx).setAsyncStack(oldAsyncStack);
+  return ok;
+}
+
+bool checkOrder() {
+  EXEC("start();");
+  js::RunJobs(cx);
+
+  JS::RootedValue v(cx);
+  EVAL(
+      "log.join() === 'p1,g1,t1,q1,sync,m1,p2,g2,then,q2,m2,p3,g3,t2,q3,m3,"
+      "then,m4,t3'",
+      &v);
+  CHECK(v.isTrue());
+  return true;
+}
+END_TEST(testPromise_AwaitOrdering)
@@ -2,9 +2,15 @@
  * License, v. 2.0. If a copy of the MPL was not distributed with this
  * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include "gc/Zone.h"
+#include "jit/Ion.h"
+#include "jit/JitOptions.h"
 #include "js/RegExp.h"
 #include "js/RegExpFlags.h"
 #include "jsapi-tests/tests.h"
+#include "vm/HelperThreads.h"
+#include "vm/RegExpObject.h"
+#include "vm/RegExpShared.h"
 
 BEGIN_TEST(testObjectIsRegExp) {
   JS::RootedValue val(cx);
@@ -63,3 +69,192 @@ BEGIN_TEST(testGetRegExpSource) {
   return true;
 }
 END_TEST(testGetRegExpSource)
+
+BEGIN_TEST(testRegExpRequiredLiteral) {
+  // These patterns have a literal that every match starts with or contains,
+  // which is searched for before running the matcher.
+  JS::RootedValue val(cx);
+  EVAL(
+      "var log = 'ok\\nERROR: 12 x\\nok\\nERROR: 345\\n';"
+      "[log.replace(/ERROR: (\\d+)/g, '<$1>'),"
+      " log.split(/\\nERROR: /).length,"
+      " /(?:foo|fob)ar/.exec('fooxfobar').index,"
+      " /\\bba(r|z)/.exec('foobar baz')[1],"
+      " /a?b[0-9]+cdef/.test('ab1cde b2cdef'),"
+      " /x+yz/.test('xxy xyz'.slice(0, 6))].join('|')",
+      &val);
+  CHECK(val.isString());
+  CHECK(JS_LinearStringEqualsLiteral(
+      JS_ASSERT_STRING_IS_LINEAR(val.toString()),
+      "ok\n<12> x\nok\n<345>\n|3|4|z|true|false"));
+  return true;
+}
+END_TEST(testRegExpRequiredLiteral)
+
+BEGIN_TEST(testRegExpFirstChars) {
+  // These patterns have no literal in common, but every match starts with
+  // one of a few characters, so other positions are skipped.
+  JS::RootedValue val(cx);
+  EVAL(
+      "var words = ['apple', 'banana', 'cherry', 'date', 'elder', 'fig',"
+      "             'grape', 'kiwi', 'lemon', 'mango'];"
+      "var re = new RegExp('\\\\b(?:' + words.join('|') + ')\\\\b', 'g');"
+      "var text = 'I ate a kiwi, then 2 mangos and a fig. Grape? grape!';"
+      "[text.replace(re, '<$&>'),"
+      " /[xyz]\\d+/.exec('abc x y9 z12')[0],"
+      " /(?:\\u00e9t\\u00e9|hiver)s?/"
+      "   .exec('\\u0160 l\\u2019\\u00e9t\\u00e9').index,"
+      " /(?:foo|bar)+baz/.test('foobarfoo baz'),"
+      " 'a-b_c'.split(/[-_]/).length,"
+      " /(?=\\d)\\w+/.exec('xx 42abc')[0]].join('|')",
+      &val);
+  CHECK(val.isString());
+  CHECK(JS_LinearStringEqualsLiteral(
+      JS_ASSERT_STRING_IS_LINEAR(val.toString()),
+      "I ate a <kiwi>, then 2 mangos and a <fig>. Grape? <grape>!|y9|4|false|3|"
+      "42abc"));
+  return true;
+}
+END_TEST(testRegExpFirstChars)
+
+BEGIN_TEST(testRegExpCodeSurvivesShrinkingGC) {
+  if (!js::IsNativeRegExpEnabled()) {
+    return true;
+  }
+
+  // Long inputs are matched with native code straight away.
+  EXEC("var re = /(a+)b/; re.test('a'.repeat(2000) + 'b');");
+
+  js::RegExpZone& regExps = cx->zone()->regExps();
+  uint64_t kept = regExps.codeKeptCount();
+  uint64_t discarded = regExps.codeDiscardedCount();
+
+  JS::PrepareForFullGC(cx);
+  JS::NonIncrementalGC(cx, JS::GCOptions::Shrink, JS::GCReason::API);
+  CHECK(regExps.codeKeptCount() > kept);
+  CHECK(regExps.codeDiscardedCount() == discarded);
+
+  // Once the regexp hasn't run for a while, its code is discarded.
+  for (int i = 0; i < 10; i++) {
+    JS_GC(cx);
+  }
+  JS::PrepareForFullGC(cx);
+  JS::NonIncrementalGC(cx, JS::GCOptions::Shrink, JS::GCReason::API);
+  CHECK(regExps.codeDiscardedCount() > discarded);
+
+  return true;
+}
+END_TEST(testRegExpCodeSurvivesShrinkingGC)
+
+// Lowers the minimum source length for compiling regexps off thread, and
+// restores it when the test finishes, whether or not it passed.
+struct RegExpOffThreadCompileFixture : public JSAPITest {
+  uint32_t savedMinLength = 0;
+
+  virtual ~RegExpOffThreadCompileFixture() {}
+
+  virtual bool init() override {
+    if (!JSAPITest::init()) {
+      return false;
+    }
+
+    savedMinLength = js::jit::JitOptions.regexpOffThreadCompileMinLength;
+    js::jit::JitOptions.regexpOffThreadCompileMinLength = 100;
+    return true;
+  }
+
+  virtual void uninit() override {
+    js::jit::JitOptions.regexpOffThreadCompileMinLength = savedMinLength;
+    JSAPITest::uninit();
+  }
+
+  bool canCompileOffThread() {
+    return js::IsNativeRegExpEnabled() &&
+           js::jit::OffThreadCompilationAvailable(cx);
+  }
+};
+
+BEGIN_FIXTURE_TEST(RegExpOffThreadCompileFixture, testRegExpOffThreadCompile) {
+  if (!canCompileOffThread()) {
+    return true;
+  }
+
+  JS::RootedValue v(cx);
+  EVAL(
+      "var re = new RegExp('(?:' + 'abcdefghij|'.repeat(20) + 'x)+y');"
+      "var input = 'x'.repeat(2000) + 'y';"
+      "re",
+      &v);
+  JS::Rooted<js::RegExpObject*> reobj(cx, &v.toObject().as<js::RegExpObject>());
+
+  // The first match is interpreted while the code is compiled.
+  EVAL("re.exec(input)[0].length", &v);
+  CHECK(v.isInt32(2001));
+  js::RootedRegExpShared shared(cx, js::RegExpObject::getShared(cx, reobj));
+  CHECK(shared);
+  CHECK(shared->offThreadCompileTask());
+  CHECK(!shared->getJitCode(/* latin1 = */ true));
+
+  // Once the compilation has finished, the code is linked by the next match.
+  js::WaitForAllHelperThreads();
+  EVAL("re.exec(input)[0].length", &v);
+  CHECK(v.isInt32(2001));
+  CHECK(!shared->offThreadCompileTask());
+  CHECK(shared->getJitCode(/* latin1 = */ true));
+
+  return true;
+}
+END_FIXTURE_TEST(RegExpOffThreadCompileFixture, testRegExpOffThreadCompile)
+
+// RegExpShareds are shared by all realms in a zone. A compilation started
+// from a realm which is then destroyed is linked by another realm.
+BEGIN_FIXTURE_TEST(RegExpOffThreadCompileFixture,
+                   testRegExpOffThreadCompile_realmDestroyed) {
+  if (!canCompileOffThread()) {
+    return true;
+  }
+
+  const char* setup =
+      "var source = '(?:' + 'klmnopqrst|'.repeat(20) + 'x)+y';"
+      "var input = 'x'.repeat(2000) + 'y';";
+  EXEC(setup);
+
+  size_t compartments = cx->zone()->compartments().length();
+
+  JS::RootedValue v(cx);
+  {
+    JS::RealmOptions options;
+    options.creationOptions().setNewCompartmentInExistingZone(global);
+    JS::RootedObject otherGlobal(
+        cx, JS_NewGlobalObject(cx, getGlobalClass(), nullptr,
+                               JS::DontFireOnNewGlobalHook, options));
+    CHECK(otherGlobal);
+    CHECK(otherGlobal->zone() == global->zone());
+
+    JSAutoRealm ar(cx, otherGlobal);
+    EXEC(setup);
+    EVAL("new RegExp(source).exec(input)[0].length", &v);
+    CHECK(v.isInt32(2001));
+  }
+  CHECK(cx->zone()->compartments().length() == compartments + 1);
+
+  EVAL("var re = new RegExp(source); re", &v);
+  JS::Rooted<js::RegExpObject*> reobj(cx, &v.toObject().as<js::RegExpObject>());
+  js::RootedRegExpShared shared(cx, js::RegExpObject::getShared(cx, reobj));
+  CHECK(shared);
+  CHECK(shared->offThreadCompileTask());
+
+  // Collect the other realm, possibly while the task is still running.
+  JS_GC(cx);
+  CHECK(cx->zone()->compartments().length() == compartments);
+
+  js::WaitForAllHelperThreads();
+  EVAL("re.exec(input)[0].length", &v);
+  CHECK(v.isInt32(2001));
+  CHECK(!shared->offThreadCompileTask());
+  CHECK(shared->getJitCode(/* latin1 = */ true));
+
+  return true;
+}
+END_FIXTURE_TEST(RegExpOffThreadCompileFixture,
+                 testRegExpOffThreadCompile_realmDestroyed)
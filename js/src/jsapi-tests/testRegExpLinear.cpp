@@ -0,0 +1,179 @@
+/* This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "mozilla/TimeStamp.h"
+
+#include "irregexp/RegExpLinear.h"
+#include "jit/JitOptions.h"
+#include "jsapi-tests/tests.h"
+#include "vm/RegExpObject.h"
+#include "vm/RegExpShared.h"
+
+// Patterns that can be run by the linear-time engine, and inputs to run them
+// on. Inputs longer than 1000 characters are matched with native code.
+static const char RunCasesSource[] = R"js(
+var cases = [
+  ["(a+)+b", "", "aaaaaaaaaaaab"],
+  ["(a+)+b", "", "aaaaaaaaaaaa"],
+  ["(a|ab)(c|bcd)(d*)", "", "abcd"],
+  ["((a)|b)+", "", "ab"],
+  ["(z)((a+)?(b+)?(c))*", "", "zaacbbbcac"],
+  ["(?:a|b)*?c", "g", "xabacbc"],
+  ["^(\\w+\\s?)*$", "", "hello world foo"],
+  ["\\bfoo\\B", "gi", "FOOx foo fooz"],
+  ["^ab|cd$", "gm", "ab\ncd\nab"],
+  ["[^a-c]+", "i", "ABCDEFabc"],
+  ["x{2,4}?y", "", "xxxxxy"],
+  ["(x{2,4})(x*)", "", "xxxxxxx"],
+  ["a.c", "", "a\nc abc"],
+  ["a.c", "s", "a\nc"],
+  ["\u00DF|k", "gi", "\u1E9E\u00DF\u212AKk"],
+  ["a+", "y", "baaa"],
+  ["a+", "gy", "aaba"],
+  ["(?:ab)+c", "", "ab".repeat(600) + "c"],
+  ["(\\d+)-(\\d+)", "g", "12-34 5-6 ".repeat(200)],
+  // Back references aren't supported, so this never falls back.
+  ["(a+)+\\1b", "", "aaaaaaaaaaaa"],
+];
+
+function runCases(wrap) {
+  var results = [];
+  for (var [source, flags, input] of cases) {
+    // Regexps with the same source and flags share their compiled code, so
+    // use an equivalent source to get a separate compilation.
+    var re = new RegExp(wrap ? "(?:" + source + ")" : source, flags);
+    var match;
+    while ((match = re.exec(input))) {
+      results.push([match.index, ...match]);
+      if (!re.global) {
+        break;
+      }
+      if (match[0] === "") {
+        re.lastIndex++;
+      }
+    }
+    results.push(re.lastIndex);
+  }
+  return JSON.stringify(results);
+}
+)js";
+
+BEGIN_TEST(testRegExpLinear_sameResults) {
+  EXEC(RunCasesSource);
+
+  uint32_t savedLimit = js::jit::JitOptions.regexpBacktrackLimit;
+
+  JS::RootedValue expected(cx);
+  js::jit::JitOptions.regexpBacktrackLimit = 0;
+  EVAL("runCases(true)", &expected);
+
+  // Fall back to the linear-time engine on the first backtrack.
+  JS::RootedValue actual(cx);
+  js::jit::JitOptions.regexpBacktrackLimit = 1;
+  EVAL("runCases(false)", &actual);
+
+  js::jit::JitOptions.regexpBacktrackLimit = savedLimit;
+
+  CHECK_SAME(actual, expected);
+  return true;
+}
+END_TEST(testRegExpLinear_sameResults)
+
+// Fall back to the linear-time engine after 1000 backtracks, and restore the
+// limit when the test finishes, whether or not it passed.
+struct RegExpBacktrackLimitFixture : public JSAPITest {
+  uint32_t savedLimit = 0;
+
+  virtual ~RegExpBacktrackLimitFixture() {}
+
+  virtual bool init() override {
+    if (!JSAPITest::init()) {
+      return false;
+    }
+
+    savedLimit = js::jit::JitOptions.regexpBacktrackLimit;
+    js::jit::JitOptions.regexpBacktrackLimit = 1000;
+    return true;
+  }
+
+  virtual void uninit() override {
+    js::jit::JitOptions.regexpBacktrackLimit = savedLimit;
+    JSAPITest::uninit();
+  }
+};
+
+BEGIN_FIXTURE_TEST(RegExpBacktrackLimitFixture,
+                   testRegExpLinear_catastrophicBacktracking) {
+  // Each of these takes exponential time in a backtracking engine. Running
+  // them all 50 times on 5000 characters takes well under a second with the
+  // linear-time engine, so a generous bound still catches a regression.
+  EXEC(
+      "var a = 'a'.repeat(5000);"
+      "var cases = ["
+      "  [/(a+)+b/, a],"
+      "  [/(x+x+)+y/, 'x'.repeat(5000)],"
+      "  [/(a|aa)+$/, a + 'b'],"
+      "  [/^(\\w+\\s?)*$/, a + '!'],"
+      "];"
+      "function runCases(iterations) {"
+      "  for (var i = 0; i < iterations; i++) {"
+      "    for (var [re, input] of cases) {"
+      "      if (re.test(input)) return false;"
+      "    }"
+      "  }"
+      "  return true;"
+      "}");
+
+  // The first run falls back and compiles the linear programs.
+  CHECK(evalBool("runCases(1)"));
+
+  js::irregexp::LinearProgram* programs[4];
+  size_t programSizes[4];
+  for (size_t i = 0; i < 4; i++) {
+    programs[i] = linearProgram(i);
+    CHECK(programs[i]);
+    programSizes[i] = programs[i]->allocatedBytes();
+  }
+
+  mozilla::TimeStamp start = mozilla::TimeStamp::Now();
+  CHECK(evalBool("runCases(50)"));
+  mozilla::TimeDuration elapsed = mozilla::TimeStamp::Now() - start;
+  CHECK(elapsed < mozilla::TimeDuration::FromSeconds(30));
+
+  // The programs' match state was allocated when they were compiled, and is
+  // reused by every match.
+  for (size_t i = 0; i < 4; i++) {
+    CHECK(linearProgram(i) == programs[i]);
+    CHECK_EQUAL(programs[i]->allocatedBytes(), programSizes[i]);
+  }
+
+  return true;
+}
+
+js::irregexp::LinearProgram* linearProgram(size_t index) {
+  JS::RootedValue v(cx);
+  JS::RootedObject cases(cx);
+  if (!JS_GetProperty(cx, global, "cases", &v) || !v.isObject()) {
+    return nullptr;
+  }
+  cases = &v.toObject();
+  if (!JS_GetElement(cx, cases, index, &v) || !v.isObject()) {
+    return nullptr;
+  }
+  JS::RootedObject pair(cx, &v.toObject());
+  if (!JS_GetElement(cx, pair, 0, &v) || !v.isObject()) {
+    return nullptr;
+  }
+  JS::Rooted<js::RegExpObject*> reobj(cx, &v.toObject().as<js::RegExpObject>());
+  js::RegExpShared* shared = js::RegExpObject::getShared(cx, reobj);
+  return shared ? shared->linearProgram() : nullptr;
+}
+
+bool evalBool(const char* code) {
+  JS::RootedValue v(cx);
+  EVAL(code, &v);
+  return v.isBoolean() && v.toBoolean();
+}
+END_FIXTURE_TEST(RegExpBacktrackLimitFixture,
+                 testRegExpLinear_catastrophicBacktracking)
@@ -81,6 +81,169 @@ BEGIN_TEST(testStructuredClone_string) {
 }
 END_TEST(testStructuredClone_string)
 
+BEGIN_TEST(testStructuredClone_shapedObjects) {
+  EXEC(
+      "var shared = {s: 1};"
+      "var records = [];"
+      "for (var i = 0; i < 100; i++) {"
+      "  records.push({id: i, name: 'n' + i, shared: shared});"
+      "}");
+
+  JS::RootedValue v1(cx);
+  EVAL("records", &v1);
+
+  JSAutoStructuredCloneBuffer buf(JS::StructuredCloneScope::DifferentProcess,
+                                  nullptr, nullptr);
+  CHECK(buf.write(cx, v1));
+
+  // The property names of the records are only written once, so each record
+  // takes less than the 96 bytes it takes with its property names.
+  CHECK(buf.data().Size() < 100 * 64);
+
+  JS::RootedValue v2(cx);
+  CHECK(buf.read(cx, &v2));
+  CHECK(JS_SetProperty(cx, global, "copy", v2));
+
+  CHECK(evalBool("copy !== records && copy.length === 100"));
+  CHECK(evalBool(
+      "copy.every((r, i) => Object.keys(r).join() === 'id,name,shared' &&"
+      "                     r.id === i && r.name === 'n' + i)"));
+  CHECK(evalBool("copy[0].shared.s === 1 && copy[0].shared !== shared"));
+  CHECK(evalBool("copy.every(r => r.shared === copy[0].shared)"));
+
+  // Delete a property of a shaped object while it's being written.
+  EXEC(
+      "var deleter = {get x() { delete records[2].b; return 3; }};"
+      "records = [{a: 1, b: 1}, {a: 2, b: 2}, {a: deleter, b: 3},"
+      "           {a: 4, b: 4}];");
+  EVAL("records", &v1);
+  CHECK(JS_StructuredClone(cx, v1, &v2, nullptr, nullptr));
+  CHECK(JS_SetProperty(cx, global, "copy", v2));
+
+  CHECK(evalBool("Object.keys(copy[2]).join() === 'a' && copy[2].a.x === 3"));
+  CHECK(evalBool("copy[3].a === 4 && copy[3].b === 4"));
+  CHECK(evalBool("copy.map(r => Object.keys(r).join()).join(';') ==="
+                 "'a,b;a,b;a;a,b'"));
+
+  return true;
+}
+
+bool evalBool(const char* code) {
+  JS::RootedValue v(cx);
+  EVAL(code, &v);
+  return v.isBoolean() && v.toBoolean();
+}
+END_TEST(testStructuredClone_shapedObjects)
+
+BEGIN_TEST(testStructuredClone_sharedStrings) {
+  EXEC(
+      "var big = '\\u1234'.repeat(100000);"
+      "var value = {big: big, small: '\\u1234'.repeat(10)};");
+
+  JS::RootedValue v1(cx);
+  EVAL("value", &v1);
+
+  JS::CloneDataPolicy policy;
+  policy.allowSharedStringBuffers();
+
+  // The characters of the large string aren't copied into the clone data.
+  JSAutoStructuredCloneBuffer buf(JS::StructuredCloneScope::SameProcess,
+                                  nullptr, nullptr);
+  CHECK(buf.write(cx, v1, JS::UndefinedHandleValue, policy));
+  CHECK(buf.data().Size() < 1024);
+
+  // Every read uses the same characters.
+  JS::RootedValue v2(cx);
+  CHECK(buf.read(cx, &v2, policy));
+  CHECK(JS_SetProperty(cx, global, "copy", v2));
+  CHECK(evalBool("copy.big === big && copy.small === value.small"));
+
+  JS::RootedValue big2(cx);
+  EVAL("copy.big", &big2);
+  const char16_t* chars2;
+  CHECK(getExternalChars(big2, &chars2));
+
+  JS::RootedValue v3(cx);
+  CHECK(buf.read(cx, &v3, policy));
+  CHECK(JS_SetProperty(cx, global, "copy", v3));
+  JS::RootedValue big3(cx);
+  EVAL("copy.big", &big3);
+  const char16_t* chars3;
+  CHECK(getExternalChars(big3, &chars3));
+  CHECK(chars2 == chars3);
+
+  // Readers must opt in too.
+  JS::RootedValue unused(cx);
+  CHECK(!buf.read(cx, &unused));
+  JS_ClearPendingException(cx);
+
+  // Data appended to another buffer keeps the characters alive after the
+  // original is cleared. |big| isn't an external string, so this write makes
+  // a new SharedStringBuffer that only |original| refers to.
+  {
+    JSAutoStructuredCloneBuffer original(JS::StructuredCloneScope::SameProcess,
+                                         nullptr, nullptr);
+    CHECK(original.write(cx, v1, JS::UndefinedHandleValue, policy));
+    JSStructuredCloneData appendedOriginal(
+        JS::StructuredCloneScope::SameProcess);
+    CHECK(appendedOriginal.Append(original.data()));
+    original.clear();
+
+    JS::RootedValue v5(cx);
+    CHECK(JS_ReadStructuredClone(
+        cx, appendedOriginal, JS_STRUCTURED_CLONE_VERSION,
+        JS::StructuredCloneScope::SameProcess, &v5, policy, nullptr, nullptr));
+    CHECK(JS_SetProperty(cx, global, "copy", v5));
+    CHECK(evalBool("copy.big === big && copy.small === value.small"));
+  }
+
+  // Cloning a string read from a clone doesn't copy its characters either.
+  JSAutoStructuredCloneBuffer buf2(JS::StructuredCloneScope::SameProcess,
+                                   nullptr, nullptr);
+  CHECK(buf2.write(cx, big2, JS::UndefinedHandleValue, policy));
+  CHECK(buf2.data().Size() < 1024);
+  buf.clear();
+
+  JS::RootedValue big4(cx);
+  CHECK(buf2.read(cx, &big4, policy));
+  const char16_t* chars4;
+  CHECK(getExternalChars(big4, &chars4));
+  CHECK(chars4 == chars2);
+  CHECK_SAME(big4, big2);
+
+  // Without the policy, and for other processes, the characters are copied.
+  JSAutoStructuredCloneBuffer buf3(JS::StructuredCloneScope::SameProcess,
+                                   nullptr, nullptr);
+  CHECK(buf3.write(cx, v1));
+  CHECK(buf3.data().Size() > 100000 * sizeof(char16_t));
+
+  JSAutoStructuredCloneBuffer buf4(JS::StructuredCloneScope::DifferentProcess,
+                                   nullptr, nullptr);
+  CHECK(buf4.write(cx, v1, JS::UndefinedHandleValue, policy));
+  CHECK(buf4.data().Size() > 100000 * sizeof(char16_t));
+
+  JS::RootedValue v4(cx);
+  CHECK(buf4.read(cx, &v4));
+  CHECK(JS_SetProperty(cx, global, "copy", v4));
+  CHECK(evalBool("copy.big === big"));
+
+  return true;
+}
+
+bool getExternalChars(JS::HandleValue v, const char16_t** chars) {
+  CHECK(v.isString());
+  const JSExternalStringCallbacks* callbacks;
+  CHECK(JS::IsExternalString(v.toString(), &callbacks, chars));
+  return true;
+}
+
+bool evalBool(const char* code) {
+  JS::RootedValue v(cx);
+  EVAL(code, &v);
+  return v.isBoolean() && v.toBoolean();
+}
+END_TEST(testStructuredClone_sharedStrings)
+
 BEGIN_TEST(testStructuredClone_externalArrayBuffer) {
   ExternalData data("One two three four");
   JS::RootedObject g1(cx, createGlobal());
@@ -275,3 +275,162 @@ bool TestArrayFromBuffer(JSContext* cx) {
 }
 
 END_TEST(testTypedArrays)
+
+// fill, indexOf, includes and reverse hand their element loops to native
+// code, with separate paths for shared and unshared memory. Check them against
+// the generic Array.prototype methods, which only use element gets and sets.
+BEGIN_TEST(testTypedArrays_elementLoops) {
+  EXEC(
+      "function make(T, shared, values) {"
+      "  var byteLength = values.length * T.BYTES_PER_ELEMENT;"
+      "  var buffer = shared ? new SharedArrayBuffer(byteLength)"
+      "                      : new ArrayBuffer(byteLength);"
+      "  var ta = new T(buffer);"
+      "  ta.set(values);"
+      "  return ta;"
+      "}"
+      "function sameElements(a, b) {"
+      "  if (a.length !== b.length) { return false; }"
+      "  for (var i = 0; i < a.length; i++) {"
+      "    if (!Object.is(a[i], b[i])) { return false; }"
+      "  }"
+      "  return true;"
+      "}"
+      "function checkArray(T, shared, values, searches, fills) {"
+      "  var ta = make(T, shared, values);"
+      "  for (var from of [0, 3, -2, values.length]) {"
+      "    for (var x of searches) {"
+      "      if (ta.indexOf(x, from) !=="
+      "          Array.prototype.indexOf.call(ta, x, from)) {"
+      "        return false;"
+      "      }"
+      "      if (ta.includes(x, from) !=="
+      "          Array.prototype.includes.call(ta, x, from)) {"
+      "        return false;"
+      "      }"
+      "    }"
+      "  }"
+      "  for (var v of fills) {"
+      "    var a = make(T, shared, values), b = make(T, shared, values);"
+      "    a.fill(v, 1, -1);"
+      "    Array.prototype.fill.call(b, v, 1, -1);"
+      "    if (!sameElements(a, b)) { return false; }"
+      "  }"
+      "  for (var n of [0, 1, values.length - 1, values.length]) {"
+      "    var a = make(T, shared, values.slice(0, n));"
+      "    var b = make(T, shared, values.slice(0, n));"
+      "    if (a.reverse() !== a) { return false; }"
+      "    Array.prototype.reverse.call(b);"
+      "    if (!sameElements(a, b)) { return false; }"
+      "  }"
+      "  return true;"
+      "}");
+
+  // Long enough for vectorized loops to have a tail.
+  CHECK(evalBool(
+      "var types = [Int8Array, Uint8Array, Uint8ClampedArray, Int16Array,"
+      "             Uint16Array, Int32Array, Uint32Array, Float32Array,"
+      "             Float64Array];"
+      "var values = [0, 1, -1, 2.5, 127, 128, 255, 256, -0, NaN, Infinity,"
+      "              1e10, 0.1, -32769, 65535];"
+      "for (var i = 0; values.length < 37; i++) { values.push(i * 7 - 50); }"
+      "var searches = [0, -0, 1, -1, 2.5, 127, 128, 255, 256, NaN, Infinity,"
+      "                0.1, Math.fround(0.1), 65535, -32769, 1e10, 2 ** 53,"
+      "                '1', null, undefined, 1n];"
+      "var fills = [1.5, 2.5, 3.5, -1, 300, -300, NaN, -0, Infinity, '7',"
+      "             null, undefined, true];"
+      "var ok = true;"
+      "for (var T of types) {"
+      "  for (var shared of [false, true]) {"
+      "    ok = ok && checkArray(T, shared, values, searches, fills);"
+      "  }"
+      "}"
+      "ok"));
+
+  // indexOf uses strict equality, so it finds -0 for 0 but never NaN.
+  // includes uses SameValueZero, so it finds NaN too.
+  CHECK(evalBool(
+      "var ok = true;"
+      "for (var T of [Float32Array, Float64Array]) {"
+      "  for (var shared of [false, true]) {"
+      "    var ta = make(T, shared, [1, NaN, -0]);"
+      "    ok = ok && ta.indexOf(NaN) === -1 && ta.includes(NaN) &&"
+      "         ta.indexOf(0) === 2 && ta.indexOf(-0) === 2 &&"
+      "         ta.includes(0) && !ta.includes(NaN, 2) &&"
+      "         Object.is(ta.fill(-0)[0], -0) && !ta.includes(NaN);"
+      "  }"
+      "}"
+      "ok"));
+
+  // Uint8Clamped rounds half to even and clamps.
+  CHECK(evalBool(
+      "var ok = true;"
+      "for (var shared of [false, true]) {"
+      "  var ta = make(Uint8ClampedArray, shared, [0, 0, 0, 0]);"
+      "  var fill = (v) => ta.fill(v)[0];"
+      "  ok = ok && fill(0.5) === 0 && fill(1.5) === 2 && fill(2.5) === 2 &&"
+      "       fill(3.5) === 4 && fill(-5) === 0 && fill(300) === 255 &&"
+      "       fill(NaN) === 0 && fill(254.6) === 255;"
+      "  ta = make(Uint8ClampedArray, shared, [1, 255, 0]);"
+      "  ok = ok && ta.indexOf(255) === 1 && ta.indexOf(300) === -1 &&"
+      "       ta.indexOf(-1) === -1 && ta.indexOf(0.5) === -1 &&"
+      "       !ta.includes(256);"
+      "}"
+      "ok"));
+
+  // BigInt arrays only match BigInts, after wrapping on store but not on
+  // search.
+  CHECK(evalBool(
+      "var ok = true;"
+      "var big = [0n, 1n, -1n, 2n ** 63n - 1n, -(2n ** 63n), 5n];"
+      "var searches = [0n, 1n, -1n, 2n ** 63n - 1n, -(2n ** 63n),"
+      "                2n ** 64n - 1n, 2n ** 64n, 5n, 1, 0, '1', NaN];"
+      "var fills = [7n, -7n, 2n ** 64n + 5n, -(2n ** 70n)];"
+      "for (var shared of [false, true]) {"
+      "  ok = ok && checkArray(BigInt64Array, shared, big, searches, fills);"
+      "  ok = ok && checkArray(BigUint64Array, shared,"
+      "                        big.map(x => BigInt.asUintN(64, x)), searches,"
+      "                        fills);"
+      "  var ta = make(BigInt64Array, shared, big);"
+      "  ok = ok && ta.indexOf(-1n) === 2 &&"
+      "       ta.indexOf(2n ** 64n - 1n) === -1 && ta.indexOf(1) === -1 &&"
+      "       !ta.includes(5) &&"
+      "       ta.fill(2n ** 64n + 5n)[3] === 5n;"
+      "  var tu = make(BigUint64Array, shared,"
+      "                big.map(x => BigInt.asUintN(64, x)));"
+      "  ok = ok && tu.indexOf(-1n) === -1 &&"
+      "       tu.indexOf(2n ** 64n - 1n) === 2 && tu.reverse()[0] === 5n;"
+      "}"
+      "ok"));
+
+  // Converting fromIndex can detach the buffer, leaving nothing to search.
+  CHECK(JS_DefineFunction(cx, global, "detach", detach, 1, 0));
+  CHECK(evalBool(
+      "var ta = new Int32Array(4);"
+      "var detachIndex = {valueOf() { detach(ta.buffer); return -1; }};"
+      "var r1 = ta.indexOf(0, detachIndex);"
+      "ta = new Int32Array(4);"
+      "var r2 = ta.includes(0, detachIndex);"
+      "ta = new Int32Array(4);"
+      "var r3 = ta.includes(undefined, detachIndex);"
+      "r1 === -1 && !r2 && r3"));
+
+  return true;
+}
+
+static bool detach(JSContext* cx, unsigned argc, JS::Value* vp) {
+  JS::CallArgs args = JS::CallArgsFromVp(argc, vp);
+  JS::RootedObject buffer(cx, &args[0].toObject());
+  if (!JS::DetachArrayBuffer(cx, buffer)) {
+    return false;
+  }
+  args.rval().setUndefined();
+  return true;
+}
+
+bool evalBool(const char* code) {
+  JS::RootedValue v(cx);
+  EVAL(code, &v);
+  return v.isBoolean() && v.toBoolean();
+}
+END_TEST(testTypedArrays_elementLoops)
@@ -9,6 +9,7 @@
 
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/PodOperations.h"
+#include "mozilla/TimeStamp.h"
 
 #include "jspubtd.h"
 
@@ -242,6 +243,40 @@ extern JS_PUBLIC_API void StopDrainingJobQueue(JSContext* cx);
 
 extern JS_PUBLIC_API void RunJobs(JSContext* cx);
 
+/**
+ * Drain the internal job queue like RunJobs, but stop once |budget| has
+ * elapsed so that the embedding can interleave other work with long job
+ * sequences. Jobs are run in small batches between budget checks, so a call
+ * always makes progress even with a zero budget, and a single long-running
+ * job can overrun the budget.
+ *
+ * Returns true if the queue was completely drained.
+ */
+extern JS_PUBLIC_API bool RunJobsWithBudget(JSContext* cx,
+                                            mozilla::TimeDuration budget);
+
+struct JobQueueMetrics {
+  // Number of jobs currently waiting in the queue.
+  size_t queueLength = 0;
+
+  // Largest number of jobs that have been waiting in the queue at once.
+  size_t maxQueueLength = 0;
+
+  // Total number of jobs run, and total time spent running them.
+  uint64_t jobsRun = 0;
+  mozilla::TimeDuration totalDrainTime;
+
+  // Number of jobs run, and time spent, by the most recent drain.
+  uint64_t lastDrainJobsRun = 0;
+  mozilla::TimeDuration lastDrainTime;
+};
+
+/**
+ * Get statistics about the internal job queue.
+ */
+extern JS_PUBLIC_API void GetJobQueueMetrics(JSContext* cx,
+                                             JobQueueMetrics* metrics);
+
 extern JS_PUBLIC_API JS::Zone* GetRealmZone(JS::Realm* realm);
 
 using PreserveWrapperCallback = bool (*)(JSContext*, JS::HandleObject);
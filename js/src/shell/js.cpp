@@ -11502,6 +11502,17 @@ static bool SetContextOptions(JSContext* cx, const OptionParser& op) {
     jit::JitOptions.regexpWarmUpThreshold = warmUpThreshold;
   }
 
+  int32_t backtrackLimit = op.getIntOption("regexp-backtrack-limit");
+  if (backtrackLimit >= 0) {
+    jit::JitOptions.regexpBacktrackLimit = backtrackLimit;
+  }
+
+  int32_t offThreadMinLength =
+      op.getIntOption("regexp-offthread-compile-min-length");
+  if (offThreadMinLength >= 0) {
+    jit::JitOptions.regexpOffThreadCompileMinLength = offThreadMinLength;
+  }
+
   if (op.getBoolOption("baseline-eager")) {
     jit::JitOptions.setEagerBaselineCompilation();
   }
@@ -12175,6 +12186,8 @@ int main(int argc, char** argv) {
           -1) ||
       !op.addIntOption('\0', "thread-count", "COUNT", "Alias for --cpu-count.",
                        -1) ||
+      !op.addBoolOption('\0', "helper-thread-affinity",
+                        "Pin each background helper thread to a CPU") ||
       !op.addBoolOption('\0', "ion", "Enable IonMonkey (default)") ||
       !op.addBoolOption('\0', "no-ion", "Disable IonMonkey") ||
       !op.addBoolOption('\0', "no-ion-for-main-context",
@@ -12228,6 +12241,16 @@ int main(int argc, char** argv) {
           "Wait for COUNT invocations before compiling regexps to native code "
           "(default 10)",
           -1) ||
+      !op.addIntOption(
+          '\0', "regexp-backtrack-limit", "COUNT",
+          "Rerun regexps with the linear-time engine after COUNT backtracks, "
+          "if supported (default 50000, 0 to disable)",
+          -1) ||
+      !op.addIntOption(
+          '\0', "regexp-offthread-compile-min-length", "LENGTH",
+          "Compile regexps at least LENGTH characters long to native code on "
+          "a helper thread (default 1000, 0 to disable)",
+          -1) ||
       !op.addBoolOption('\0', "trace-regexp-parser", "Trace regexp parsing") ||
       !op.addBoolOption('\0', "trace-regexp-assembler",
                         "Trace regexp assembler") ||
@@ -12625,6 +12648,9 @@ int main(int argc, char** argv) {
   if (cpuCount >= 0 && !SetFakeCPUCount(cpuCount)) {
     return 1;
   }
+  if (op.getBoolOption("helper-thread-affinity")) {
+    SetHelperThreadAffinity(true);
+  }
 
   /* Use the same parameters as the browser in xpcjsruntime.cpp. */
   JSContext* const cx = JS_NewContext(JS::DefaultHeapMaxBytes);
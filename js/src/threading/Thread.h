@@ -157,6 +157,10 @@ void SetName(const char* name);
 // 'nameBuffer', including the terminating NUL.
 void GetName(char* nameBuffer, size_t len);
 
+// Restrict the current thread to run on the given CPU. As with SetName, this
+// is not available on all platforms, and on these platforms it does nothing.
+void SetAffinity(size_t cpu);
+
 // Causes the current thread to sleep until the
 // number of real-time milliseconds specified have elapsed.
 void SleepMilliseconds(size_t ms);
@@ -27,6 +27,7 @@ void Thread::detach() {}
 ThreadId ThreadId::ThisThreadId() { return ThreadId(); }
 void ThisThread::SetName(const char*) {}
 void ThisThread::GetName(char*, size_t) {}
+void ThisThread::SetAffinity(size_t) {}
 void ThisThread::SleepMilliseconds(size_t) {
   MOZ_CRASH("There is no any implementation for sleep.");
 }
@@ -139,6 +139,22 @@ void ThisThread::GetName(char* nameBuffer, size_t len) {
   }
 }
 
+void ThisThread::SetAffinity(size_t cpu) {
+#if defined(__linux__) && !defined(__ANDROID__)
+  if (cpu >= CPU_SETSIZE) {
+    return;
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+
+  // Failing to pin the thread isn't fatal, it just runs wherever the scheduler
+  // puts it.
+  (void)pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+}
+
 void ThisThread::SleepMilliseconds(size_t ms) {
   std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 }
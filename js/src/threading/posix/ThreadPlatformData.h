@@ -20,6 +20,7 @@
 #endif
 
 #if defined(__linux__)
+#  include <sched.h>
 #  include <sys/prctl.h>
 #endif
 
@@ -120,6 +120,17 @@ void ThisThread::GetName(char* nameBuffer, size_t len) {
   *nameBuffer = '\0';
 }
 
+void ThisThread::SetAffinity(size_t cpu) {
+  // This only covers the first processor group, which has up to 64 CPUs.
+  if (cpu >= sizeof(DWORD_PTR) * 8) {
+    return;
+  }
+
+  // Failing to pin the thread isn't fatal, it just runs wherever the scheduler
+  // puts it.
+  (void)SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu);
+}
+
 void ThisThread::SleepMilliseconds(size_t ms) {
   std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 }
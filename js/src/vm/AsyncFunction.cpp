@@ -216,6 +216,7 @@ AsyncFunctionGeneratorObject* AsyncFunctionGeneratorObject::create(
     return nullptr;
   }
   obj->initFixedSlot(PROMISE_SLOT, ObjectValue(*resultPromise));
+  obj->initFixedSlot(AWAIT_REACTION_SLOT, NullValue());
 
   // Starts in the running state.
   obj->setResumeIndex(AbstractGeneratorObject::RESUME_INDEX_RUNNING);
@@ -260,6 +261,7 @@ AsyncFunctionGeneratorObject* AsyncFunctionGeneratorObject::create(
     return nullptr;
   }
   obj->initFixedSlot(PROMISE_SLOT, ObjectValue(*resultPromise));
+  obj->initFixedSlot(AWAIT_REACTION_SLOT, NullValue());
 
   RootedObject onFulfilled(
       cx, NewHandler(cx, AsyncModuleExecutionFulfilledHandler, module));
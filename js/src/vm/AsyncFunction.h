@@ -303,6 +303,12 @@ class AsyncFunctionGeneratorObject : public AbstractGeneratorObject {
   enum {
     PROMISE_SLOT = AbstractGeneratorObject::RESERVED_SLOTS,
 
+    // The PromiseReactionRecord created for the most recent await, kept so
+    // the next await can reuse it instead of allocating a new record. This is
+    // safe because the generator can only be resumed from that record's job,
+    // so the record is no longer in use once the generator awaits again.
+    AWAIT_REACTION_SLOT,
+
     RESERVED_SLOTS
   };
 
@@ -318,6 +324,13 @@ class AsyncFunctionGeneratorObject : public AbstractGeneratorObject {
   PromiseObject* promise() {
     return &getFixedSlot(PROMISE_SLOT).toObject().as<PromiseObject>();
   }
+
+  JSObject* awaitReaction() const {
+    return getFixedSlot(AWAIT_REACTION_SLOT).toObjectOrNull();
+  }
+  void setAwaitReaction(JSObject* reaction) {
+    setFixedSlot(AWAIT_REACTION_SLOT, ObjectValue(*reaction));
+  }
 };
 
 }  // namespace js
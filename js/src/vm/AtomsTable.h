@@ -11,6 +11,8 @@
 #ifndef vm_AtomsTable_h
 #define vm_AtomsTable_h
 
+#include "mozilla/Atomics.h"
+
 #include <type_traits>  // std::{enable_if_t,is_const_v}
 
 #include "js/GCHashTable.h"
@@ -139,6 +141,10 @@ class AtomsTable {
 
   Partition* partitions[PartitionCount];
 
+  // Changed whenever atoms may be swept, to invalidate the per-context
+  // AtomizeCaches. This is read by helper threads without holding a lock.
+  mozilla::Atomic<uint32_t, mozilla::ReleaseAcquire> sweepEpoch_;
+
 #ifdef DEBUG
   bool allPartitionsLocked = false;
 #endif
@@ -183,6 +189,8 @@ class AtomsTable {
                                indexValue, lookup);
   }
 
+  uint32_t sweepEpoch() const { return sweepEpoch_; }
+
   bool atomIsPinned(JSRuntime* rt, JSAtom* atom);
 
   void maybePinExistingAtom(JSContext* cx, JSAtom* atom);
@@ -208,6 +216,7 @@ class AtomsTable {
   MOZ_ALWAYS_INLINE size_t getPartitionIndex(const AtomHasher::Lookup& lookup);
 
   void tracePinnedAtomsInSet(JSTracer* trc, AtomSet& atoms);
+  void updateSweepEpoch();
   void mergeAtomsAddedWhileSweeping(Partition& partition);
 
   friend class AutoLockAllAtoms;
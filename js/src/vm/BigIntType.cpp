@@ -79,6 +79,7 @@
 #include "vm/BigIntType.h"
 
 #include "mozilla/Casting.h"
+#include "mozilla/DebugOnly.h"
 #include "mozilla/FloatingPoint.h"
 #include "mozilla/HashFunctions.h"
 #include "mozilla/MathAlgorithms.h"
@@ -89,6 +90,7 @@
 #include "mozilla/Span.h"  // mozilla::Span
 #include "mozilla/WrappingOperations.h"
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <math.h>
@@ -496,6 +498,243 @@ void BigInt::multiplyAccumulate(BigInt* multiplicand, Digit multiplier,
   }
 }
 
+// Add `y` to `x` in place and return the carry out of the most significant
+// digit of `x`. `x` must have at least as many digits as `y`.
+BigInt::Digit BigInt::digitsInplaceAdd(Digits x, ConstDigits y) {
+  MOZ_ASSERT(x.Length() >= y.Length());
+
+  Digit carry = 0;
+  size_t i = 0;
+  for (; i < y.Length(); i++) {
+    Digit newCarry = 0;
+    Digit sum = digitAdd(x[i], y[i], &newCarry);
+    x[i] = digitAdd(sum, carry, &newCarry);
+    carry = newCarry;
+  }
+  for (; carry && i < x.Length(); i++) {
+    Digit newCarry = 0;
+    x[i] = digitAdd(x[i], carry, &newCarry);
+    carry = newCarry;
+  }
+  return carry;
+}
+
+// Subtract `y` from `x` in place and return the borrow out of the most
+// significant digit of `x`. `x` must have at least as many digits as `y`.
+BigInt::Digit BigInt::digitsInplaceSub(Digits x, ConstDigits y) {
+  MOZ_ASSERT(x.Length() >= y.Length());
+
+  Digit borrow = 0;
+  size_t i = 0;
+  for (; i < y.Length(); i++) {
+    Digit newBorrow = 0;
+    Digit difference = digitSub(x[i], y[i], &newBorrow);
+    x[i] = digitSub(difference, borrow, &newBorrow);
+    borrow = newBorrow;
+  }
+  for (; borrow && i < x.Length(); i++) {
+    Digit newBorrow = 0;
+    x[i] = digitSub(x[i], borrow, &newBorrow);
+    borrow = newBorrow;
+  }
+  return borrow;
+}
+
+// Store `|x - y|` in `result`, which must have as many digits as `x`. `x` must
+// have at least as many digits as `y`. Returns true if `y` is larger than `x`.
+bool BigInt::digitsAbsoluteDifference(Digits result, ConstDigits x,
+                                      ConstDigits y) {
+  MOZ_ASSERT(x.Length() >= y.Length());
+  MOZ_ASSERT(result.Length() == x.Length());
+
+  // Compare `x` and `y`, treating the missing high digits of `y` as zero.
+  int8_t compare = 0;
+  for (size_t i = x.Length(); i > 0 && compare == 0; i--) {
+    Digit xDigit = x[i - 1];
+    Digit yDigit = i - 1 < y.Length() ? y[i - 1] : 0;
+    if (xDigit != yDigit) {
+      compare = xDigit > yDigit ? 1 : -1;
+    }
+  }
+
+  mozilla::DebugOnly<Digit> borrow;
+  if (compare >= 0) {
+    std::copy(x.begin(), x.end(), result.begin());
+    borrow = digitsInplaceSub(result, y);
+    MOZ_ASSERT(!borrow);
+    return false;
+  }
+
+  std::copy(y.begin(), y.end(), result.begin());
+  std::fill(result.begin() + y.Length(), result.end(), 0);
+  borrow = digitsInplaceSub(result, x);
+  MOZ_ASSERT(!borrow);
+  return true;
+}
+
+// Store `x * y` in `result`, which must have exactly `x.Length() + y.Length()`
+// digits.
+void BigInt::multiplySchoolbook(Digits result, ConstDigits x, ConstDigits y) {
+  MOZ_ASSERT(result.Length() == x.Length() + y.Length());
+
+  std::fill(result.begin(), result.end(), 0);
+
+  for (size_t i = 0; i < x.Length(); i++) {
+    Digit multiplier = x[i];
+    if (!multiplier) {
+      continue;
+    }
+
+    // `multiplier * y[j] + result[i + j] + carry` always fits in two digits,
+    // so the carries can be accumulated in the high digit of the product.
+    Digit carry = 0;
+    for (size_t j = 0; j < y.Length(); j++) {
+      Digit high = 0;
+      Digit low = digitMul(multiplier, y[j], &high);
+      low = digitAdd(low, result[i + j], &high);
+      low = digitAdd(low, carry, &high);
+      result[i + j] = low;
+      carry = high;
+    }
+    result[i + y.Length()] = carry;
+  }
+}
+
+// Return the number of scratch digits needed by `multiplyKaratsuba` for
+// operands with `length` digits.
+size_t BigInt::karatsubaScratchLength(size_t length) {
+  size_t scratchLength = 0;
+  while (length >= KaratsubaThreshold) {
+    size_t high = length - length / 2;
+    scratchLength += 6 * high + 1;
+    length = high;
+  }
+  return scratchLength;
+}
+
+// Store `x * y` in `result`, which must have exactly twice as many digits as
+// the equally long operands `x` and `y`. `scratch` must have at least
+// `karatsubaScratchLength(x.Length())` digits.
+//
+// With `x = x1 * B^k + x0` and `y = y1 * B^k + y0`, the product is
+//
+//   z2 * B^(2k) + (z0 + z2 - (x1 - x0) * (y1 - y0)) * B^k + z0
+//
+// where `z0 = x0 * y0` and `z2 = x1 * y1`. That's three multiplications of
+// half the size instead of four.
+void BigInt::multiplyKaratsuba(Digits result, ConstDigits x, ConstDigits y,
+                               Digits scratch) {
+  size_t length = x.Length();
+  MOZ_ASSERT(y.Length() == length);
+  MOZ_ASSERT(result.Length() == 2 * length);
+  MOZ_ASSERT(scratch.Length() >= karatsubaScratchLength(length));
+
+  if (length < KaratsubaThreshold) {
+    multiplySchoolbook(result, x, y);
+    return;
+  }
+
+  size_t low = length / 2;
+  size_t high = length - low;
+  MOZ_ASSERT(high >= low);
+
+  ConstDigits x0 = x.To(low);
+  ConstDigits x1 = x.From(low);
+  ConstDigits y0 = y.To(low);
+  ConstDigits y1 = y.From(low);
+
+  // Compute z0 and z2 directly into the low and high halves of the result.
+  Digits z0 = result.To(2 * low);
+  Digits z2 = result.From(2 * low);
+  multiplyKaratsuba(z0, x0, y0, scratch);
+  multiplyKaratsuba(z2, x1, y1, scratch);
+
+  Digits xDifference = scratch.To(high);
+  Digits yDifference = scratch.Subspan(high, high);
+  Digits product = scratch.Subspan(2 * high, 2 * high);
+  Digits middle = scratch.Subspan(4 * high, 2 * high + 1);
+  Digits rest = scratch.From(6 * high + 1);
+
+  bool xNegative = digitsAbsoluteDifference(xDifference, x1, x0);
+  bool yNegative = digitsAbsoluteDifference(yDifference, y1, y0);
+  multiplyKaratsuba(product, xDifference, yDifference, rest);
+
+  // middle = z0 + z2 - (x1 - x0) * (y1 - y0), which is `x0 * y1 + x1 * y0`
+  // and therefore non-negative.
+  std::copy(z2.begin(), z2.end(), middle.begin());
+  middle[2 * high] = 0;
+  mozilla::DebugOnly<Digit> carry = digitsInplaceAdd(middle, z0);
+  MOZ_ASSERT(!carry);
+  if (xNegative == yNegative) {
+    carry = digitsInplaceSub(middle, product);
+  } else {
+    carry = digitsInplaceAdd(middle, product);
+  }
+  MOZ_ASSERT(!carry);
+
+  carry = digitsInplaceAdd(result.From(low), middle);
+  MOZ_ASSERT(!carry);
+}
+
+// Return the number of scratch digits needed by `multiplyLarge` when the
+// shorter operand has `length` digits.
+size_t BigInt::multiplyLargeScratchLength(size_t length) {
+  return 4 * length + karatsubaScratchLength(length);
+}
+
+// Store `x * y` in `result`, which must have exactly `x.Length() + y.Length()`
+// digits. `y` must not be longer than `x` and must have at least
+// `KaratsubaThreshold` digits. `scratch` must have at least
+// `multiplyLargeScratchLength(y.Length())` digits.
+//
+// `x` is split into chunks of `y.Length()` digits, which are multiplied with
+// `y` using Karatsuba multiplication.
+void BigInt::multiplyLarge(Digits result, ConstDigits x, ConstDigits y,
+                           Digits scratch) {
+  size_t length = y.Length();
+  MOZ_ASSERT(x.Length() >= length);
+  MOZ_ASSERT(length >= KaratsubaThreshold);
+  MOZ_ASSERT(result.Length() == x.Length() + length);
+  MOZ_ASSERT(scratch.Length() >= multiplyLargeScratchLength(length));
+
+  Digits product = scratch.To(2 * length);
+  Digits rest = scratch.From(2 * length);
+
+  std::fill(result.begin(), result.end(), 0);
+
+  for (size_t i = 0; i < x.Length(); i += length) {
+    size_t chunkLength = std::min(length, x.Length() - i);
+    ConstDigits chunk = x.Subspan(i, chunkLength);
+    Digits chunkProduct = product.To(chunkLength + length);
+
+    if (chunkLength == length) {
+      multiplyKaratsuba(chunkProduct, chunk, y, rest);
+    } else if (chunkLength < KaratsubaThreshold) {
+      multiplySchoolbook(chunkProduct, y, chunk);
+    } else if (2 * chunkLength < length) {
+      // `multiplyLargeScratchLength(chunkLength)` fits into `rest`, because
+      // `chunkLength` is less than half of `length`.
+      multiplyLarge(chunkProduct, y, chunk, rest);
+    } else {
+      // Zero-extend a chunk of at least half the length, so both operands of
+      // the Karatsuba multiplication have the same length.
+      Digits extendedChunk = rest.To(length);
+      std::copy(chunk.begin(), chunk.end(), extendedChunk.begin());
+      std::fill(extendedChunk.begin() + chunkLength, extendedChunk.end(), 0);
+      multiplyKaratsuba(product, extendedChunk, y, rest.From(length));
+#ifdef DEBUG
+      for (size_t j = chunkLength + length; j < product.Length(); j++) {
+        MOZ_ASSERT(product[j] == 0);
+      }
+#endif
+    }
+
+    mozilla::DebugOnly<Digit> carry =
+        digitsInplaceAdd(result.From(i), chunkProduct);
+    MOZ_ASSERT(!carry);
+  }
+}
+
 inline int8_t BigInt::absoluteCompare(BigInt* x, BigInt* y) {
   MOZ_ASSERT(!HasLeadingZeroes(x));
   MOZ_ASSERT(!HasLeadingZeroes(y));
@@ -1910,6 +2149,30 @@ BigInt* BigInt::mul(JSContext* cx, HandleBigInt x, HandleBigInt y) {
   }
 
   unsigned resultLength = x->digitLength() + y->digitLength();
+
+  // Use Karatsuba multiplication when both operands are large.
+  HandleBigInt& longer = x->digitLength() >= y->digitLength() ? x : y;
+  HandleBigInt& shorter = x->digitLength() >= y->digitLength() ? y : x;
+  if (shorter->digitLength() >= KaratsubaThreshold) {
+    size_t scratchLength = multiplyLargeScratchLength(shorter->digitLength());
+    auto scratch = cx->make_pod_array<Digit>(scratchLength);
+    if (!scratch) {
+      return nullptr;
+    }
+
+    BigInt* result = createUninitialized(cx, resultLength, resultNegative);
+    if (!result) {
+      return nullptr;
+    }
+
+    // Allocating the result can GC and move the operands' digits, so only
+    // access them after the allocation.
+    multiplyLarge(result->digits(), longer->digits(), shorter->digits(),
+                  Digits(scratch.get(), scratchLength));
+
+    return destructivelyTrimHighZeroDigits(cx, result);
+  }
+
   BigInt* result = createUninitialized(cx, resultLength, resultNegative);
   if (!result) {
     return nullptr;
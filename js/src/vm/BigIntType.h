@@ -252,6 +252,10 @@ class BigInt final : public js::gc::CellWithLengthAndFlags {
  public:
   static constexpr size_t DigitBits = sizeof(Digit) * CHAR_BIT;
 
+  // Operands with fewer digits are multiplied with the schoolbook method,
+  // larger operands are split recursively using Karatsuba multiplication.
+  static constexpr size_t KaratsubaThreshold = 34;
+
  private:
   static constexpr size_t HalfDigitBits = DigitBits / 2;
   static constexpr Digit HalfDigitMask = (1ull << HalfDigitBits) - 1;
@@ -292,6 +296,18 @@ class BigInt final : public js::gc::CellWithLengthAndFlags {
   static void multiplyAccumulate(BigInt* multiplicand, Digit multiplier,
                                  BigInt* accumulator,
                                  unsigned accumulatorIndex);
+
+  static Digit digitsInplaceAdd(Digits x, ConstDigits y);
+  static Digit digitsInplaceSub(Digits x, ConstDigits y);
+  static bool digitsAbsoluteDifference(Digits result, ConstDigits x,
+                                       ConstDigits y);
+  static void multiplySchoolbook(Digits result, ConstDigits x, ConstDigits y);
+  static void multiplyKaratsuba(Digits result, ConstDigits x, ConstDigits y,
+                                Digits scratch);
+  static size_t karatsubaScratchLength(size_t length);
+  static size_t multiplyLargeScratchLength(size_t length);
+  static void multiplyLarge(Digits result, ConstDigits x, ConstDigits y,
+                            Digits scratch);
   static bool absoluteDivWithBigIntDivisor(
       JSContext* cx, Handle<BigInt*> dividend, Handle<BigInt*> divisor,
       const mozilla::Maybe<MutableHandle<BigInt*>>& quotient,
@@ -41,7 +41,8 @@ inline JS::BigInt* BytecodeLocation::getBigInt(const JSScript* script) const {
 
 inline JSObject* BytecodeLocation::getObject(const JSScript* script) const {
   MOZ_ASSERT(this->isValid());
-  MOZ_ASSERT(is(JSOp::CallSiteObj) || is(JSOp::Object));
+  MOZ_ASSERT(is(JSOp::CallSiteObj) || is(JSOp::Object) ||
+             is(JSOp::NewArrayCopy));
   return script->getObject(this->rawBytecode_);
 }
 
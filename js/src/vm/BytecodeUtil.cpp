@@ -1909,7 +1909,8 @@ bool ExpressionDecompiler::decompilePC(jsbytecode* pc, uint8_t defIndex) {
       }
       return write(str);
     }
-    case JSOp::Object: {
+    case JSOp::Object:
+    case JSOp::NewArrayCopy: {
       JSObject* obj = script->getObject(pc);
       RootedValue objv(cx, ObjectValue(*obj));
       JSString* str = ValueToSource(cx, objv);
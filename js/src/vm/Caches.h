@@ -7,6 +7,9 @@
 #ifndef vm_Caches_h
 #define vm_Caches_h
 
+#include "mozilla/Array.h"
+#include "mozilla/MathAlgorithms.h"
+
 #include <iterator>
 #include <new>
 
@@ -245,6 +248,110 @@ class StringToAtomCache {
   void purge() { map_.clearAndCompact(); }
 };
 
+// Small direct-mapped cache of recently atomized strings, indexed by hash.
+//
+// Unlike StringToAtomCache this is owned by a single JSContext (including
+// helper thread contexts), so it can be probed without taking any of the atoms
+// table partition locks. The atoms in it are kept alive by the atoms table, so
+// the whole cache is discarded whenever the table starts sweeping; this is
+// detected by comparing against AtomsTable::sweepEpoch() before each use. A
+// hit is only used if the epoch is unchanged after the lookup too.
+// Epochs are unique within the process, which also covers helper thread
+// contexts moving between runtimes.
+class AtomizeCache {
+ public:
+  static constexpr size_t NumEntries = 256;
+
+ private:
+  mozilla::Array<JSAtom*, NumEntries> entries_;
+  uint32_t epoch_ = 0;
+
+  static_assert(mozilla::IsPowerOfTwo(NumEntries),
+                "NumEntries must be a power of two");
+
+ public:
+  AtomizeCache() { purge(); }
+
+  // Discard all entries if the atoms table has been swept since the cache was
+  // last used.
+  void purgeIfStale(uint32_t sweepEpoch) {
+    if (MOZ_UNLIKELY(epoch_ != sweepEpoch)) {
+      purge();
+      epoch_ = sweepEpoch;
+    }
+  }
+
+  JSAtom*& entryFor(HashNumber hash) {
+    return entries_[hash & (NumEntries - 1)];
+  }
+
+  void purge() {
+    for (JSAtom*& entry : entries_) {
+      entry = nullptr;
+    }
+  }
+};
+
+// Small direct-mapped cache of own data property slots, used by the C++
+// interpreter for JSOp::GetProp, JSOp::SetProp and JSOp::GetGName. Scripts
+// only run in the C++ interpreter until they are warm enough for the baseline
+// interpreter, which has its own inline caches, so this is mostly for code
+// that runs once or twice, e.g. during startup.
+//
+// Entries are keyed by the op's pc and the receiver's shape. The shape implies
+// the property's slot and attributes, so on a hit the slot can be accessed
+// directly. For JSOp::GetGName the receiver is the global lexical environment
+// and, if the name was found on the global object instead, |holderShape| is
+// the global's shape.
+//
+// Shapes and scripts are only freed by GC, and the cache is purged on every
+// GC, so a matching entry is never stale.
+class InterpreterPropertyCache {
+ public:
+  struct Entry {
+    jsbytecode* pc = nullptr;
+    Shape* shape = nullptr;
+    Shape* holderShape = nullptr;
+    uint32_t slot = 0;
+  };
+
+  static constexpr size_t NumEntries = 1024;
+
+ private:
+  mozilla::Array<Entry, NumEntries> entries_;
+
+  static_assert(mozilla::IsPowerOfTwo(NumEntries),
+                "NumEntries must be a power of two");
+
+  Entry& entryFor(jsbytecode* pc, Shape* shape) {
+    uintptr_t hash = uintptr_t(pc) ^ (uintptr_t(shape) >> gc::CellAlignShift);
+    return entries_[(hash ^ (hash >> 10)) & (NumEntries - 1)];
+  }
+
+ public:
+  const Entry* lookup(jsbytecode* pc, Shape* shape) {
+    Entry& entry = entryFor(pc, shape);
+    if (entry.pc != pc || entry.shape != shape) {
+      return nullptr;
+    }
+    return &entry;
+  }
+
+  void fill(jsbytecode* pc, Shape* shape, Shape* holderShape, uint32_t slot) {
+    Entry& entry = entryFor(pc, shape);
+    entry.pc = pc;
+    entry.shape = shape;
+    entry.holderShape = holderShape;
+    entry.slot = slot;
+  }
+
+  void purge() {
+    for (Entry& entry : entries_) {
+      entry = Entry();
+    }
+  }
+};
+
 class RuntimeCaches {
  public:
   js::GSNCache gsnCache;
@@ -252,6 +359,7 @@ class RuntimeCaches {
   js::UncompressedSourceCache uncompressedSourceCache;
   js::EvalCache evalCache;
   js::StringToAtomCache stringToAtomCache;
+  js::InterpreterPropertyCache interpreterPropertyCache;
 
   void purgeForMinorGC(JSRuntime* rt) {
     newObjectCache.clearNurseryObjects(rt);
@@ -262,6 +370,7 @@ class RuntimeCaches {
     newObjectCache.purge();
     evalCache.clear();
     stringToAtomCache.purge();
+    interpreterPropertyCache.purge();
   }
 
   void purge() {
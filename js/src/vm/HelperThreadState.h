@@ -13,6 +13,7 @@
 #ifndef vm_HelperThreadState_h
 #define vm_HelperThreadState_h
 
+#include "mozilla/Array.h"
 #include "mozilla/Attributes.h"
 #include "mozilla/EnumeratedArray.h"
 #include "mozilla/TimeStamp.h"
@@ -40,6 +41,10 @@ struct ParseTask;
 struct PromiseHelperTask;
 class PromiseObject;
 
+namespace irregexp {
+class RegExpCompileTask;
+}  // namespace irregexp
+
 namespace jit {
 class IonCompileTask;
 class IonFreeTask;
@@ -116,6 +121,8 @@ class GlobalHelperThreadState {
   using GCParallelTaskList = mozilla::LinkedList<GCParallelTask>;
   typedef Vector<PromiseHelperTask*, 0, SystemAllocPolicy>
       PromiseHelperTaskVector;
+  using RegExpCompileTaskVector =
+      Vector<irregexp::RegExpCompileTask*, 0, SystemAllocPolicy>;
   typedef Vector<JSContext*, 0, SystemAllocPolicy> ContextVector;
 
   // Count of running task by each threadType.
@@ -161,6 +168,10 @@ class GlobalHelperThreadState {
   // Finished source compression tasks.
   SourceCompressionTaskVector compressionFinishedList_;
 
+  // Regexp native code compilation worklist. Tasks are owned by their
+  // RegExpShared, which links the code when the task has finished.
+  RegExpCompileTaskVector regExpWorklist_;
+
   // GC tasks needing to be done in parallel.
   GCParallelTaskList gcParallelWorklist_;
   size_t gcParallelThreadCount;
@@ -183,6 +194,24 @@ class GlobalHelperThreadState {
   // running yet.
   size_t tasksPending_ = 0;
 
+  // When each of the pending dispatches above was made, oldest first, starting
+  // at pendingDispatchHead_. Used to measure dispatch latency; may be shorter
+  // than tasksPending_ after OOM.
+  Vector<mozilla::TimeStamp, 0, SystemAllocPolicy> pendingDispatchTimes_;
+  size_t pendingDispatchHead_ = 0;
+
+  // Scheduling statistics per task type.
+  mozilla::EnumeratedArray<ThreadType, ThreadType::THREAD_TYPE_MAX,
+                           HelperThreadTaskStats>
+      taskStats_;
+
+  // The number of threads blocked in wait(). Tasks finishing only need to wake
+  // waiting threads when there are some.
+  size_t consumerWaiters_ = 0;
+
+  // Whether internal thread pool threads are pinned to CPUs.
+  bool threadAffinity_ = false;
+
   bool isInitialized_ = false;
 
   bool useInternalThreadPool_ = true;
@@ -200,6 +229,7 @@ class GlobalHelperThreadState {
   size_t maxPromiseHelperThreads() const;
   size_t maxParseThreads() const;
   size_t maxCompressionThreads() const;
+  size_t maxRegExpCompilationThreads() const;
   size_t maxGCParallelThreads(const AutoLockHelperThreadState& lock) const;
 
   GlobalHelperThreadState();
@@ -215,6 +245,19 @@ class GlobalHelperThreadState {
   void finishThreads(AutoLockHelperThreadState& lock);
 
   void setCpuCount(size_t count);
+  void setThreadAffinity(bool enabled);
+  bool threadAffinity(const AutoLockHelperThreadState& lock) const {
+    return threadAffinity_;
+  }
+
+  [[nodiscard]] bool setTaskPriorities(const ThreadType* types, size_t count,
+                                       const AutoLockHelperThreadState& lock);
+
+  const HelperThreadTaskStats& taskStats(
+      ThreadType type, const AutoLockHelperThreadState& lock) const {
+    return taskStats_[type];
+  }
+  void resetTaskStats(const AutoLockHelperThreadState& lock);
 
   void setDispatchTaskCallback(JS::HelperThreadTaskCallback callback,
                                size_t threadCount, size_t stackSize,
@@ -323,6 +366,10 @@ class GlobalHelperThreadState {
     return compressionFinishedList_;
   }
 
+  RegExpCompileTaskVector& regExpWorklist(const AutoLockHelperThreadState&) {
+    return regExpWorklist_;
+  }
+
   GCParallelTaskList& gcParallelWorklist(const AutoLockHelperThreadState&) {
     return gcParallelWorklist_;
   }
@@ -349,6 +396,7 @@ class GlobalHelperThreadState {
   bool canStartIonFreeTask(const AutoLockHelperThreadState& lock);
   bool canStartParseTask(const AutoLockHelperThreadState& lock);
   bool canStartCompressionTask(const AutoLockHelperThreadState& lock);
+  bool canStartRegExpCompileTask(const AutoLockHelperThreadState& lock);
   bool canStartGCParallelTask(const AutoLockHelperThreadState& lock);
 
   HelperThreadTask* maybeGetWasmCompile(const AutoLockHelperThreadState& lock,
@@ -368,6 +416,8 @@ class GlobalHelperThreadState {
   HelperThreadTask* maybeGetParseTask(const AutoLockHelperThreadState& lock);
   HelperThreadTask* maybeGetCompressionTask(
       const AutoLockHelperThreadState& lock);
+  HelperThreadTask* maybeGetRegExpCompileTask(
+      const AutoLockHelperThreadState& lock);
   HelperThreadTask* maybeGetGCParallelTask(
       const AutoLockHelperThreadState& lock);
 
@@ -454,6 +504,8 @@ class GlobalHelperThreadState {
                   const AutoLockHelperThreadState& locked);
   bool submitTask(JSRuntime* rt, UniquePtr<ParseTask> task,
                   const AutoLockHelperThreadState& locked);
+  bool submitTask(irregexp::RegExpCompileTask* task,
+                  const AutoLockHelperThreadState& locked);
   bool submitTask(PromiseHelperTask* task);
   bool submitTask(GCParallelTask* task,
                   const AutoLockHelperThreadState& locked);
@@ -462,8 +514,20 @@ class GlobalHelperThreadState {
 
   using Selector = HelperThreadTask* (
       GlobalHelperThreadState::*)(const AutoLockHelperThreadState&);
-  static const Selector selectors[];
+  struct TaskSelector {
+    ThreadType threadType;
+    Selector selector;
+  };
+  static constexpr size_t SelectorCount = 10;
+  static const TaskSelector selectors[SelectorCount];
+
+ private:
+  // The selectors in the order findHighestPriorityTask tries them. This starts
+  // out as the default order of |selectors| and is changed by
+  // setTaskPriorities.
+  mozilla::Array<TaskSelector, SelectorCount> selectorOrder_;
 
+ public:
   HelperThreadTask* findHighestPriorityTask(
       const AutoLockHelperThreadState& locked);
 };
@@ -15,6 +15,9 @@ class AutoLockHelperThreadState;
 struct ParseTask;
 class SourceCompressionTask;
 
+namespace irregexp {
+class RegExpCompileTask;
+}  // namespace irregexp
 namespace jit {
 class IonCompileTask;
 class IonFreeTask;
@@ -46,6 +49,11 @@ struct MapTypeToThreadType<SourceCompressionTask> {
   static const ThreadType threadType = THREAD_TYPE_COMPRESS;
 };
 
+template <>
+struct MapTypeToThreadType<irregexp::RegExpCompileTask> {
+  static const ThreadType threadType = THREAD_TYPE_REGEXP_COMPILE;
+};
+
 struct HelperThreadTask {
   virtual void runHelperThreadTask(AutoLockHelperThreadState& locked) = 0;
   virtual ThreadType threadType() = 0;
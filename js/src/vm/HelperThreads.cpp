@@ -17,6 +17,7 @@
 #include "frontend/CompilationStencil.h"  // frontend::{CompilationStencil, ExtensibleCompilationStencil, CompilationInput, CompilationGCOutput, BorrowingCompilationStencil}
 #include "frontend/ParserAtom.h"          // frontend::ParserAtomsTable
 #include "gc/GC.h"                        // gc::MergeRealms
+#include "irregexp/RegExpAPI.h"
 #include "jit/IonCompileTask.h"
 #include "jit/JitRuntime.h"
 #include "js/ContextOptions.h"      // JS::ContextOptions
@@ -119,6 +120,86 @@ void GlobalHelperThreadState::setCpuCount(size_t count) {
   threadCount = ThreadCountForCPUCount(count);
 }
 
+void js::SetHelperThreadAffinity(bool enabled) {
+  HelperThreadState().setThreadAffinity(enabled);
+}
+
+void GlobalHelperThreadState::setThreadAffinity(bool enabled) {
+  // This must be called before any threads have been initialized.
+  AutoLockHelperThreadState lock;
+  MOZ_ASSERT(!isInitialized(lock));
+
+  threadAffinity_ = enabled;
+}
+
+bool js::SetHelperThreadTaskPriorities(const ThreadType* types, size_t count) {
+  AutoLockHelperThreadState lock;
+  return HelperThreadState().setTaskPriorities(types, count, lock);
+}
+
+bool GlobalHelperThreadState::setTaskPriorities(
+    const ThreadType* types, size_t count,
+    const AutoLockHelperThreadState& lock) {
+  auto isListed = [&](ThreadType type, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+      if (types[i] == type) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  mozilla::Array<TaskSelector, SelectorCount> order;
+  size_t length = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    if (isListed(types[i], i)) {
+      return false;
+    }
+
+    const TaskSelector* selector =
+        std::find_if(std::begin(selectors), std::end(selectors),
+                     [&](const TaskSelector& s) {
+                       return s.threadType == types[i];
+                     });
+    if (selector == std::end(selectors)) {
+      return false;
+    }
+
+    order[length++] = *selector;
+  }
+
+  for (const TaskSelector& selector : selectors) {
+    if (!isListed(selector.threadType, count)) {
+      order[length++] = selector;
+    }
+  }
+
+  MOZ_ASSERT(length == SelectorCount);
+  selectorOrder_ = order;
+  return true;
+}
+
+void js::GetHelperThreadTaskStats(ThreadType type,
+                                  HelperThreadTaskStats* stats) {
+  MOZ_ASSERT(type < THREAD_TYPE_MAX);
+
+  AutoLockHelperThreadState lock;
+  *stats = HelperThreadState().taskStats(type, lock);
+}
+
+void js::ResetHelperThreadTaskStats() {
+  AutoLockHelperThreadState lock;
+  HelperThreadState().resetTaskStats(lock);
+}
+
+void GlobalHelperThreadState::resetTaskStats(
+    const AutoLockHelperThreadState& lock) {
+  for (HelperThreadTaskStats& stats : taskStats_) {
+    stats = HelperThreadTaskStats();
+  }
+}
+
 size_t js::GetHelperThreadCount() { return HelperThreadState().threadCount; }
 
 size_t js::GetHelperThreadCPUCount() { return HelperThreadState().cpuCount; }
@@ -1429,6 +1510,10 @@ GlobalHelperThreadState::GlobalHelperThreadState()
   threadCount = ThreadCountForCPUCount(cpuCount);
   gcParallelThreadCount = threadCount;
 
+  for (size_t i = 0; i < SelectorCount; i++) {
+    selectorOrder_[i] = selectors[i];
+  }
+
   MOZ_ASSERT(cpuCount > 0, "GetCPUCount() seems broken");
 }
 
@@ -1505,6 +1590,10 @@ void GlobalHelperThreadState::dispatch(
     // limit the number.
     tasksPending_++;
 
+    // Failing to record the time only makes the dispatch latency statistics
+    // less accurate.
+    (void)pendingDispatchTimes_.append(TimeStamp::Now());
+
     // The hazard analysis can't tell that the callback doesn't GC.
     JS::AutoSuppressGCAnalysis nogc;
 
@@ -1515,15 +1604,21 @@ void GlobalHelperThreadState::dispatch(
 void GlobalHelperThreadState::wait(
     AutoLockHelperThreadState& locked,
     TimeDuration timeout /* = TimeDuration::Forever() */) {
+  consumerWaiters_++;
   consumerWakeup.wait_for(locked, timeout);
+  consumerWaiters_--;
 }
 
 void GlobalHelperThreadState::notifyAll(const AutoLockHelperThreadState&) {
-  consumerWakeup.notify_all();
+  if (consumerWaiters_) {
+    consumerWakeup.notify_all();
+  }
 }
 
 void GlobalHelperThreadState::notifyOne(const AutoLockHelperThreadState&) {
-  consumerWakeup.notify_one();
+  if (consumerWaiters_) {
+    consumerWakeup.notify_one();
+  }
 }
 
 bool GlobalHelperThreadState::hasActiveThreads(
@@ -1556,6 +1651,7 @@ void GlobalHelperThreadState::waitForAllTasksLocked(
   MOZ_ASSERT(promiseHelperTasks(lock).empty());
   MOZ_ASSERT(parseWorklist(lock).empty());
   MOZ_ASSERT(compressionWorklist(lock).empty());
+  MOZ_ASSERT(regExpWorklist(lock).empty());
   MOZ_ASSERT(ionFreeList(lock).empty());
   MOZ_ASSERT(wasmWorklist(lock, wasm::CompileMode::Tier2).empty());
   MOZ_ASSERT(wasmTier2GeneratorWorklist(lock).empty());
@@ -1670,9 +1766,11 @@ void GlobalHelperThreadState::addSizeOfIncludingThis(
       compressionPendingList_.sizeOfExcludingThis(mallocSizeOf) +
       compressionWorklist_.sizeOfExcludingThis(mallocSizeOf) +
       compressionFinishedList_.sizeOfExcludingThis(mallocSizeOf) +
+      regExpWorklist_.sizeOfExcludingThis(mallocSizeOf) +
       gcParallelWorklist_.sizeOfExcludingThis(mallocSizeOf) +
       helperContexts_.sizeOfExcludingThis(mallocSizeOf) +
-      helperTasks_.sizeOfExcludingThis(mallocSizeOf);
+      helperTasks_.sizeOfExcludingThis(mallocSizeOf) +
+      pendingDispatchTimes_.sizeOfExcludingThis(mallocSizeOf);
 
   // Report ParseTasks on wait lists
   for (const auto& task : parseWorklist_) {
@@ -1767,6 +1865,13 @@ size_t GlobalHelperThreadState::maxCompressionThreads() const {
   return 1;
 }
 
+size_t GlobalHelperThreadState::maxRegExpCompilationThreads() const {
+  if (IsHelperThreadSimulatingOOM(js::THREAD_TYPE_REGEXP_COMPILE)) {
+    return 1;
+  }
+  return std::min(cpuCount, threadCount);
+}
+
 size_t GlobalHelperThreadState::maxGCParallelThreads(
     const AutoLockHelperThreadState& lock) const {
   if (IsHelperThreadSimulatingOOM(js::THREAD_TYPE_GCPARALLEL)) {
@@ -1997,6 +2102,24 @@ bool GlobalHelperThreadState::canStartCompressionTask(
                               lock);
 }
 
+HelperThreadTask* GlobalHelperThreadState::maybeGetRegExpCompileTask(
+    const AutoLockHelperThreadState& lock) {
+  if (!canStartRegExpCompileTask(lock)) {
+    return nullptr;
+  }
+
+  irregexp::RegExpCompileTask* task = regExpWorklist(lock).popCopy();
+  task->setState(irregexp::RegExpCompileTask::State::Running, lock);
+  return task;
+}
+
+bool GlobalHelperThreadState::canStartRegExpCompileTask(
+    const AutoLockHelperThreadState& lock) {
+  return !regExpWorklist(lock).empty() &&
+         checkTaskThreadLimit(THREAD_TYPE_REGEXP_COMPILE,
+                              maxRegExpCompilationThreads(), lock);
+}
+
 void GlobalHelperThreadState::startHandlingCompressionTasks(
     ScheduleCompressionTask schedule, JSRuntime* maybeRuntime,
     const AutoLockHelperThreadState& lock) {
@@ -2028,6 +2151,85 @@ bool GlobalHelperThreadState::submitTask(
   return true;
 }
 
+bool js::StartOffThreadRegExpCompile(irregexp::RegExpCompileTask* task) {
+  AutoLockHelperThreadState lock;
+  return HelperThreadState().submitTask(task, lock);
+}
+
+bool GlobalHelperThreadState::submitTask(
+    irregexp::RegExpCompileTask* task,
+    const AutoLockHelperThreadState& locked) {
+  MOZ_ASSERT(isInitialized(locked));
+
+  if (!regExpWorklist(locked).append(task)) {
+    return false;
+  }
+
+  dispatch(locked);
+  return true;
+}
+
+bool js::IsOffThreadRegExpCompileFinished(irregexp::RegExpCompileTask* task) {
+  AutoLockHelperThreadState lock;
+  return task->state(lock) == irregexp::RegExpCompileTask::State::Finished;
+}
+
+void js::CancelOffThreadRegExpCompile(irregexp::RegExpCompileTask* task) {
+  using State = irregexp::RegExpCompileTask::State;
+
+  AutoLockHelperThreadState lock;
+
+  switch (task->state(lock)) {
+    case State::Pending:
+      HelperThreadState().regExpWorklist(lock).eraseIfEqual(task);
+      break;
+    case State::Running:
+      // The helper thread deletes the task when it finishes.
+      task->abandon(lock);
+      return;
+    case State::Finished:
+      break;
+  }
+
+  js_delete(task);
+}
+
+void js::CancelOffThreadRegExpCompiles(JSRuntime* runtime) {
+  if (!CanUseExtraThreads()) {
+    return;
+  }
+
+  AutoLockHelperThreadState lock;
+
+  // Cancel pending tasks. They are still owned by their RegExpShareds, which
+  // delete them when they are finalized.
+  auto& worklist = HelperThreadState().regExpWorklist(lock);
+  for (size_t i = 0; i < worklist.length(); i++) {
+    irregexp::RegExpCompileTask* task = worklist[i];
+    if (task->runtimeMatches(runtime)) {
+      task->setState(irregexp::RegExpCompileTask::State::Finished, lock);
+      HelperThreadState().remove(worklist, &i);
+    }
+  }
+
+  // Wait for in-progress tasks, which may be using the runtime.
+  while (true) {
+    bool inProgress = false;
+    for (auto* helper : HelperThreadState().helperTasks(lock)) {
+      if (helper->is<irregexp::RegExpCompileTask>() &&
+          helper->as<irregexp::RegExpCompileTask>()->runtimeMatches(runtime)) {
+        inProgress = true;
+      }
+    }
+
+    if (!inProgress) {
+      break;
+    }
+
+    HelperThreadState().wait(lock);
+  }
+}
+
 bool GlobalHelperThreadState::submitTask(
     GCParallelTask* task, const AutoLockHelperThreadState& locked) {
   gcParallelWorklist(locked).insertBack(task);
@@ -2759,24 +2961,35 @@ void GlobalHelperThreadState::trace(JSTracer* trc) {
 
 // Definition of helper thread tasks.
 //
-// Priority is determined by the order they're listed here.
-const GlobalHelperThreadState::Selector GlobalHelperThreadState::selectors[] = {
-    &GlobalHelperThreadState::maybeGetGCParallelTask,
-    &GlobalHelperThreadState::maybeGetIonCompileTask,
-    &GlobalHelperThreadState::maybeGetWasmTier1CompileTask,
-    &GlobalHelperThreadState::maybeGetPromiseHelperTask,
-    &GlobalHelperThreadState::maybeGetParseTask,
-    &GlobalHelperThreadState::maybeGetCompressionTask,
-    &GlobalHelperThreadState::maybeGetIonFreeTask,
-    &GlobalHelperThreadState::maybeGetWasmTier2CompileTask,
-    &GlobalHelperThreadState::maybeGetWasmTier2GeneratorTask};
+// The default priority is determined by the order they're listed here. It can
+// be changed with js::SetHelperThreadTaskPriorities.
+const GlobalHelperThreadState::TaskSelector
+    GlobalHelperThreadState::selectors[SelectorCount] = {
+        {THREAD_TYPE_GCPARALLEL,
+         &GlobalHelperThreadState::maybeGetGCParallelTask},
+        {THREAD_TYPE_ION, &GlobalHelperThreadState::maybeGetIonCompileTask},
+        {THREAD_TYPE_WASM_COMPILE_TIER1,
+         &GlobalHelperThreadState::maybeGetWasmTier1CompileTask},
+        {THREAD_TYPE_PROMISE_TASK,
+         &GlobalHelperThreadState::maybeGetPromiseHelperTask},
+        {THREAD_TYPE_PARSE, &GlobalHelperThreadState::maybeGetParseTask},
+        {THREAD_TYPE_REGEXP_COMPILE,
+         &GlobalHelperThreadState::maybeGetRegExpCompileTask},
+        {THREAD_TYPE_COMPRESS,
+         &GlobalHelperThreadState::maybeGetCompressionTask},
+        {THREAD_TYPE_ION_FREE, &GlobalHelperThreadState::maybeGetIonFreeTask},
+        {THREAD_TYPE_WASM_COMPILE_TIER2,
+         &GlobalHelperThreadState::maybeGetWasmTier2CompileTask},
+        {THREAD_TYPE_WASM_GENERATOR_TIER2,
+         &GlobalHelperThreadState::maybeGetWasmTier2GeneratorTask}};
 
 bool GlobalHelperThreadState::canStartTasks(
     const AutoLockHelperThreadState& lock) {
   return canStartGCParallelTask(lock) || canStartIonCompileTask(lock) ||
          canStartWasmTier1CompileTask(lock) ||
          canStartPromiseHelperTask(lock) || canStartParseTask(lock) ||
-         canStartCompressionTask(lock) || canStartIonFreeTask(lock) ||
+         canStartRegExpCompileTask(lock) || canStartCompressionTask(lock) ||
+         canStartIonFreeTask(lock) ||
          canStartWasmTier2CompileTask(lock) ||
          canStartWasmTier2GeneratorTask(lock);
 }
@@ -2797,12 +3010,37 @@ void GlobalHelperThreadState::runOneTask(AutoLockHelperThreadState& lock) {
   MOZ_ASSERT(tasksPending_ > 0);
   tasksPending_--;
 
+  TimeStamp start = TimeStamp::Now();
+  TimeDuration dispatchLatency;
+  if (pendingDispatchHead_ < pendingDispatchTimes_.length()) {
+    dispatchLatency = start - pendingDispatchTimes_[pendingDispatchHead_++];
+  }
+  if (!tasksPending_) {
+    pendingDispatchTimes_.clear();
+    pendingDispatchHead_ = 0;
+  } else if (pendingDispatchHead_ * 2 >= pendingDispatchTimes_.length()) {
+    // Drop the used entries once they are at least half of the vector, so each
+    // task pays a constant amount for this on average.
+    pendingDispatchTimes_.erase(
+        pendingDispatchTimes_.begin(),
+        pendingDispatchTimes_.begin() + pendingDispatchHead_);
+    pendingDispatchHead_ = 0;
+  }
+
   // The selectors may depend on the HelperThreadState not changing between task
   // selection and task execution, in particular, on new tasks not being added
   // (because of the lifo structure of the work lists). Unlocking the
   // HelperThreadState between task selection and execution is not well-defined.
   HelperThreadTask* task = findHighestPriorityTask(lock);
   if (task) {
+    HelperThreadTaskStats& stats = taskStats_[task->threadType()];
+    stats.count++;
+    stats.dispatchLatency += dispatchLatency;
+    if (dispatchLatency > stats.maxDispatchLatency) {
+      stats.maxDispatchLatency = dispatchLatency;
+    }
+    stats.selectionTime += TimeStamp::Now() - start;
+
     runTaskLocked(task, lock);
     dispatch(lock);
   }
@@ -2814,8 +3052,8 @@ HelperThreadTask* GlobalHelperThreadState::findHighestPriorityTask(
     const AutoLockHelperThreadState& locked) {
   // Return the highest priority task that is ready to start, or nullptr.
 
-  for (const auto& selector : selectors) {
-    if (auto* task = (this->*(selector))(locked)) {
+  for (const auto& selector : selectorOrder_) {
+    if (auto* task = (this->*(selector.selector))(locked)) {
       return task;
     }
   }
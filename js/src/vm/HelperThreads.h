@@ -11,6 +11,7 @@
 #ifndef vm_HelperThreads_h
 #define vm_HelperThreads_h
 
+#include "mozilla/TimeStamp.h"
 #include "mozilla/Variant.h"
 #include "NamespaceImports.h"
 
@@ -37,6 +38,10 @@ namespace gc {
 class GCRuntime;
 }
 
+namespace irregexp {
+class RegExpCompileTask;
+}  // namespace irregexp
+
 namespace jit {
 class IonCompileTask;
 class IonFreeTask;
@@ -87,6 +92,42 @@ size_t GetMaxWasmCompilationThreads();
 // --thread-count=N option.
 bool SetFakeCPUCount(size_t count);
 
+// Pin the threads of the internal thread pool to one CPU each, round-robin.
+// This must be called before the helper threads are started and has no effect
+// when the embedding provides its own thread pool. Used by the JS shell's
+// --helper-thread-affinity option.
+void SetHelperThreadAffinity(bool enabled);
+
+// Give the listed task types priority over the others when a helper thread
+// picks its next task. Types are listed from highest to lowest priority; the
+// types that are not listed keep their default order after the listed ones.
+// Passing no types restores the default order. Returns false and leaves the
+// order unchanged if a type is listed twice or is not a helper task type.
+bool SetHelperThreadTaskPriorities(const ThreadType* types, size_t count);
+
+// Scheduling statistics for helper thread tasks of one type, gathered since
+// the helper thread state was created or the last call to
+// ResetHelperThreadTaskStats.
+struct HelperThreadTaskStats {
+  // Number of tasks of this type that were run.
+  uint64_t count = 0;
+
+  // Time between a dispatch to the thread pool and a thread starting to run a
+  // task of this type, summed over all tasks and the largest single delay.
+  // Dispatches aren't tied to tasks: each thread that starts is charged with
+  // the oldest outstanding dispatch, and then picks the highest priority task.
+  // When priorities reorder the work this is not how long that task waited,
+  // only how long the thread pool took to start a thread for it.
+  mozilla::TimeDuration dispatchLatency;
+  mozilla::TimeDuration maxDispatchLatency;
+
+  // Time spent holding the helper thread lock to pick these tasks.
+  mozilla::TimeDuration selectionTime;
+};
+
+void GetHelperThreadTaskStats(ThreadType type, HelperThreadTaskStats* stats);
+void ResetHelperThreadTaskStats();
+
 // Enqueues a wasm compilation task.
 bool StartOffThreadWasmCompile(wasm::CompileTask* task, wasm::CompileMode mode);
 
@@ -283,6 +324,21 @@ void RunPendingSourceCompressions(JSRuntime* runtime);
 // main-thread execution.
 bool IsOffThreadSourceCompressionEnabled();
 
+// Schedule compiling a regexp to native code. Returns false if the task could
+// not be scheduled, in which case the caller still owns it.
+bool StartOffThreadRegExpCompile(irregexp::RegExpCompileTask* task);
+
+// Whether a scheduled regexp compilation has finished, successfully or not.
+bool IsOffThreadRegExpCompileFinished(irregexp::RegExpCompileTask* task);
+
+// Delete a regexp compilation task whose result is no longer wanted. If the
+// task is running, it is deleted when it finishes instead.
+void CancelOffThreadRegExpCompile(irregexp::RegExpCompileTask* task);
+
+// Cancel scheduled regexp compilations for the runtime and wait for in
+// progress ones to finish. The tasks are deleted later by their owners.
+void CancelOffThreadRegExpCompiles(JSRuntime* runtime);
+
 // Return whether, if a new parse task was started, it would need to wait for
 // an in-progress GC to complete before starting.
 extern bool OffThreadParsingMustWaitForGC(JSRuntime* rt);
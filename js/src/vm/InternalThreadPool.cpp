@@ -6,10 +6,12 @@
 
 #include "vm/InternalThreadPool.h"
 
+#include "mozilla/Maybe.h"
 #include "mozilla/TimeStamp.h"
 
 #include "js/ProfilingCategory.h"
 #include "js/ProfilingStack.h"
+#include "threading/CpuCount.h"
 #include "threading/Thread.h"
 #include "util/NativeStack.h"
 #include "vm/HelperThreadState.h"
@@ -64,13 +66,14 @@ class HelperThread {
 
  public:
   HelperThread();
-  [[nodiscard]] bool init(InternalThreadPool* pool);
+  [[nodiscard]] bool init(InternalThreadPool* pool, mozilla::Maybe<size_t> cpu);
 
   ThreadId threadId() { return thread.get_id(); }
 
   void join();
 
-  static void ThreadMain(InternalThreadPool* pool, HelperThread* helper);
+  static void ThreadMain(InternalThreadPool* pool, HelperThread* helper,
+                         mozilla::Maybe<size_t> cpu);
   void threadLoop(InternalThreadPool* pool);
 
   void ensureRegisteredWithProfiler();
@@ -127,9 +130,18 @@ bool InternalThreadPool::ensureThreadCount(size_t threadCount,
     return false;
   }
 
+  // When pinning threads, spread them over the CPUs round-robin.
+  size_t cpuCount = GetCPUCount();
+  bool pinThreads = HelperThreadState().threadAffinity(lock);
+
   while (threads(lock).length() < threadCount) {
+    mozilla::Maybe<size_t> cpu;
+    if (pinThreads) {
+      cpu.emplace(threads(lock).length() % cpuCount);
+    }
+
     auto thread = js::MakeUnique<HelperThread>();
-    if (!thread || !thread->init(this)) {
+    if (!thread || !thread->init(this, cpu)) {
       return false;
     }
 
@@ -186,7 +198,10 @@ void InternalThreadPool::DispatchTask() { Get().dispatchTask(); }
 void InternalThreadPool::dispatchTask() {
   gHelperThreadLock.assertOwnedByCurrentThread();
   queuedTasks++;
-  wakeup.notify_one();
+  if (idleThreads > pendingWakeups) {
+    pendingWakeups++;
+    wakeup.notify_one();
+  }
 }
 
 void InternalThreadPool::notifyAll(const AutoLockHelperThreadState& lock) {
@@ -194,21 +209,33 @@ void InternalThreadPool::notifyAll(const AutoLockHelperThreadState& lock) {
 }
 
 void InternalThreadPool::wait(AutoLockHelperThreadState& lock) {
+  idleThreads++;
   wakeup.wait_for(lock, mozilla::TimeDuration::Forever());
+  idleThreads--;
+
+  // This may also be a spurious wakeup, in which case a later dispatch sends
+  // an extra notification. That's harmless.
+  if (pendingWakeups) {
+    pendingWakeups--;
+  }
 }
 
 HelperThread::HelperThread()
     : thread(Thread::Options().setStackSize(HELPER_STACK_SIZE)) {}
 
-bool HelperThread::init(InternalThreadPool* pool) {
-  return thread.init(HelperThread::ThreadMain, pool, this);
+bool HelperThread::init(InternalThreadPool* pool, mozilla::Maybe<size_t> cpu) {
+  return thread.init(HelperThread::ThreadMain, pool, this, cpu);
 }
 
 void HelperThread::join() { thread.join(); }
 
 /* static */
-void HelperThread::ThreadMain(InternalThreadPool* pool, HelperThread* helper) {
+void HelperThread::ThreadMain(InternalThreadPool* pool, HelperThread* helper,
+                              mozilla::Maybe<size_t> cpu) {
   ThisThread::SetName("JS Helper");
+  if (cpu) {
+    ThisThread::SetAffinity(*cpu);
+  }
 
   helper->ensureRegisteredWithProfiler();
   helper->threadLoop(pool);
@@ -62,6 +62,13 @@ class InternalThreadPool {
 
   HelperThreadLockData<size_t> queuedTasks;
 
+  // The number of threads waiting for a task, and how many of them have been
+  // notified but have not woken up yet. Threads that are running a task check
+  // for queued tasks before waiting, so a dispatch only needs to wake a thread
+  // if there is an idle thread that hasn't been notified already.
+  HelperThreadLockData<size_t> idleThreads;
+  HelperThreadLockData<size_t> pendingWakeups;
+
   HelperThreadLockData<bool> terminating;
 };
 
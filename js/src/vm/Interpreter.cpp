@@ -44,6 +44,7 @@
 #include "vm/AsyncIteration.h"
 #include "vm/BigIntType.h"
 #include "vm/BytecodeUtil.h"        // JSDVG_SEARCH_STACK
+#include "vm/Caches.h"
 #include "vm/EqualityOperations.h"  // js::StrictlyEqual
 #include "vm/FunctionFlags.h"       // js::FunctionFlags
 #include "vm/GeneratorObject.h"
@@ -69,6 +70,7 @@
 #include "vm/EnvironmentObject-inl.h"
 #include "vm/GeckoProfiler-inl.h"
 #include "vm/JSAtom-inl.h"
+#include "vm/JSContext-inl.h"
 #include "vm/JSFunction-inl.h"
 #include "vm/JSScript-inl.h"
 #include "vm/NativeObject-inl.h"
@@ -193,10 +195,47 @@ bool js::Debug_CheckSelfHosted(JSContext* cx, HandleValue fun) {
   return true;
 }
 
+// Add an InterpreterPropertyCache entry for the op at |pc| if |name| is an own
+// data property of |obj| that the op can access directly.
+static void MaybeFillPropertyCache(JSContext* cx, jsbytecode* pc,
+                                   JSObject* obj, PropertyName* name) {
+  if (!obj->is<NativeObject>()) {
+    return;
+  }
+  bool isSet = JSOp(*pc) == JSOp::SetProp || JSOp(*pc) == JSOp::StrictSetProp;
+  if (isSet ? !!obj->getOpsSetProperty() : !!obj->getOpsGetProperty()) {
+    return;
+  }
+
+  NativeObject* nobj = &obj->as<NativeObject>();
+  mozilla::Maybe<PropertyInfo> prop = nobj->lookupPure(name);
+  if (prop.isNothing() || !prop->isDataProperty()) {
+    return;
+  }
+  if (isSet && !prop->writable()) {
+    return;
+  }
+
+  cx->caches().interpreterPropertyCache.fill(pc, nobj->shape(), nullptr,
+                                             prop->slot());
+}
+
 static inline bool GetPropertyOperation(JSContext* cx, InterpreterFrame* fp,
                                         HandleScript script, jsbytecode* pc,
                                         MutableHandleValue lval,
                                         MutableHandleValue vp) {
+  if (lval.isObject()) {
+    JSObject* obj = &lval.toObject();
+    InterpreterPropertyCache& cache = cx->caches().interpreterPropertyCache;
+    if (const auto* entry = cache.lookup(pc, obj->shape())) {
+      const Value& v = obj->as<NativeObject>().getSlot(entry->slot);
+      if (!v.isMagic()) {
+        vp.set(v);
+        return true;
+      }
+    }
+  }
+
   RootedPropertyName name(cx, script->getName(pc));
 
   if (name == cx->names().length && GetLengthProperty(lval, vp)) {
@@ -205,7 +244,66 @@ static inline bool GetPropertyOperation(JSContext* cx, InterpreterFrame* fp,
 
   // Copy lval, because it might alias vp.
   RootedValue v(cx, lval);
-  return GetProperty(cx, v, name, vp);
+  if (!GetProperty(cx, v, name, vp)) {
+    return false;
+  }
+
+  if (v.isObject()) {
+    MaybeFillPropertyCache(cx, pc, &v.toObject(), name);
+  }
+  return true;
+}
+
+// Look up a JSOp::GetGName in the InterpreterPropertyCache. The entry is keyed
+// by the global lexical environment's shape, which implies that the name is
+// not a lexical binding if it was found on the global object.
+static inline bool GetGlobalNameFromCache(JSContext* cx,
+                                          GlobalLexicalEnvironmentObject* env,
+                                          jsbytecode* pc,
+                                          MutableHandleValue vp) {
+  InterpreterPropertyCache& cache = cx->caches().interpreterPropertyCache;
+  const auto* entry = cache.lookup(pc, env->shape());
+  if (!entry) {
+    return false;
+  }
+
+  NativeObject* holder = env;
+  if (entry->holderShape) {
+    holder = &env->global();
+    if (holder->shape() != entry->holderShape) {
+      return false;
+    }
+  }
+
+  // Uninitialized lexical bindings take the slow path to throw.
+  const Value& v = holder->getSlot(entry->slot);
+  if (v.isMagic()) {
+    return false;
+  }
+  vp.set(v);
+  return true;
+}
+
+static void MaybeFillGlobalNameCache(JSContext* cx,
+                                     GlobalLexicalEnvironmentObject* env,
+                                     jsbytecode* pc, PropertyName* name) {
+  InterpreterPropertyCache& cache = cx->caches().interpreterPropertyCache;
+
+  if (mozilla::Maybe<PropertyInfo> prop = env->lookupPure(name)) {
+    if (prop->isDataProperty()) {
+      cache.fill(pc, env->shape(), nullptr, prop->slot());
+    }
+    return;
+  }
+
+  GlobalObject* global = &env->global();
+  if (global->getOpsGetProperty()) {
+    return;
+  }
+  mozilla::Maybe<PropertyInfo> prop = global->lookupPure(name);
+  if (prop.isSome() && prop->isDataProperty()) {
+    cache.fill(pc, env->shape(), global->shape(), prop->slot());
+  }
 }
 
 static inline bool GetNameOperation(JSContext* cx, InterpreterFrame* fp,
@@ -222,16 +320,28 @@ static inline bool GetNameOperation(JSContext* cx, InterpreterFrame* fp,
    * the actual behavior even if the id could be found on the env chain
    * before the global object.
    */
+  GlobalLexicalEnvironmentObject* globalLexical = nullptr;
   if (IsGlobalOp(JSOp(*pc)) && !fp->script()->hasNonSyntacticScope()) {
-    envChain = &cx->global()->lexicalEnvironment();
+    globalLexical = &cx->global()->lexicalEnvironment();
+    if (GetGlobalNameFromCache(cx, globalLexical, pc, vp)) {
+      return true;
+    }
+    envChain = globalLexical;
   }
 
   /* Kludge to allow (typeof foo == "undefined") tests. */
   JSOp op2 = JSOp(pc[JSOpLength_GetName]);
+  bool ok;
   if (op2 == JSOp::Typeof) {
-    return GetEnvironmentName<GetNameMode::TypeOf>(cx, envChain, name, vp);
+    ok = GetEnvironmentName<GetNameMode::TypeOf>(cx, envChain, name, vp);
+  } else {
+    ok = GetEnvironmentName<GetNameMode::Normal>(cx, envChain, name, vp);
+  }
+
+  if (ok && globalLexical) {
+    MaybeFillGlobalNameCache(cx, globalLexical, pc, name);
   }
-  return GetEnvironmentName<GetNameMode::Normal>(cx, envChain, name, vp);
+  return ok;
 }
 
 bool js::GetImportOperation(JSContext* cx, HandleObject envChain,
@@ -247,10 +357,25 @@ bool js::GetImportOperation(JSContext* cx, HandleObject envChain,
   return FetchName<GetNameMode::Normal>(cx, env, pobj, name, prop, vp);
 }
 
-static bool SetPropertyOperation(JSContext* cx, JSOp op, HandleValue lval,
-                                 int lvalIndex, HandleId id, HandleValue rval) {
+static bool SetPropertyOperation(JSContext* cx, jsbytecode* pc,
+                                 HandleValue lval, int lvalIndex,
+                                 HandlePropertyName name, HandleValue rval) {
+  JSOp op = JSOp(*pc);
   MOZ_ASSERT(op == JSOp::SetProp || op == JSOp::StrictSetProp);
 
+  if (lval.isObject()) {
+    JSObject* obj = &lval.toObject();
+    InterpreterPropertyCache& cache = cx->caches().interpreterPropertyCache;
+    if (const auto* entry = cache.lookup(pc, obj->shape())) {
+      NativeObject* nobj = &obj->as<NativeObject>();
+      if (!nobj->getSlot(entry->slot).isMagic()) {
+        nobj->setSlot(entry->slot, rval);
+        return true;
+      }
+    }
+  }
+
+  RootedId id(cx, NameToId(name));
   RootedObject obj(cx,
                    ToObjectFromStackForPropertyAccess(cx, lval, lvalIndex, id));
   if (!obj) {
@@ -258,8 +383,15 @@ static bool SetPropertyOperation(JSContext* cx, JSOp op, HandleValue lval,
   }
 
   ObjectOpResult result;
-  return SetProperty(cx, obj, id, rval, lval, result) &&
-         result.checkStrictModeError(cx, obj, id, op == JSOp::StrictSetProp);
+  if (!SetProperty(cx, obj, id, rval, lval, result) ||
+      !result.checkStrictModeError(cx, obj, id, op == JSOp::StrictSetProp)) {
+    return false;
+  }
+
+  if (lval.isObject() && result.ok()) {
+    MaybeFillPropertyCache(cx, pc, obj, name);
+  }
+  return true;
 }
 
 static JSObject* SuperFunOperation(JSObject* callee) {
@@ -3022,9 +3154,8 @@ static MOZ_NEVER_INLINE JS_HAZ_JSNATIVE_CALLER bool Interpret(JSContext* cx,
       HandleValue lval = REGS.stackHandleAt(lvalIndex);
       HandleValue rval = REGS.stackHandleAt(-1);
 
-      ReservedRooted<jsid> id(&rootId0, NameToId(script->getName(REGS.pc)));
-      if (!SetPropertyOperation(cx, JSOp(*REGS.pc), lval, lvalIndex, id,
-                                rval)) {
+      ReservedRooted<PropertyName*> name(&rootName0, script->getName(REGS.pc));
+      if (!SetPropertyOperation(cx, REGS.pc, lval, lvalIndex, name, rval)) {
         goto error;
       }
 
@@ -3865,6 +3996,18 @@ static MOZ_NEVER_INLINE JS_HAZ_JSNATIVE_CALLER bool Interpret(JSContext* cx,
     }
     END_CASE(NewArray)
 
+    CASE(NewArrayCopy) {
+      ReservedRooted<JSObject*> templateObject(&rootObject0,
+                                               script->getObject(REGS.pc));
+      ArrayObject* obj =
+          NewArrayCopyOperation(cx, templateObject.as<ArrayObject>());
+      if (!obj) {
+        goto error;
+      }
+      PUSH_OBJECT(*obj);
+    }
+    END_CASE(NewArrayCopy)
+
     CASE(NewObject) {
       JSObject* obj = NewObjectOperation(cx, script, REGS.pc);
       if (!obj) {
@@ -5083,6 +5226,22 @@ ArrayObject* js::NewArrayOperation(
   return NewDenseFullyAllocatedArray(cx, length, nullptr, newKind);
 }
 
+ArrayObject* js::NewArrayCopyOperation(JSContext* cx,
+                                       Handle<ArrayObject*> templateObject) {
+  MOZ_ASSERT(templateObject->denseElementsArePacked());
+
+  uint32_t length = templateObject->getDenseInitializedLength();
+  MOZ_ASSERT(templateObject->length() == length);
+
+  ArrayObject* array = NewDenseFullyAllocatedArray(cx, length);
+  if (!array) {
+    return nullptr;
+  }
+
+  array->initDenseElements(templateObject, 0, length);
+  return array;
+}
+
 ArrayObject* js::NewArrayObjectBaselineFallback(JSContext* cx, uint32_t length,
                                                 gc::AllocKind allocKind,
                                                 gc::AllocSite* site) {
@@ -634,6 +634,11 @@ JSObject* CreateThisWithTemplate(JSContext* cx, HandleObject templateObject);
 ArrayObject* NewArrayOperation(JSContext* cx, uint32_t length,
                                NewObjectKind newKind = GenericObject);
 
+// Create a new array with a copy of the elements of the array literal template
+// object of a JSOp::NewArrayCopy instruction.
+ArrayObject* NewArrayCopyOperation(JSContext* cx,
+                                   Handle<ArrayObject*> templateObject);
+
 // Called from JIT code when inline array allocation fails.
 ArrayObject* NewArrayObjectBaselineFallback(JSContext* cx, uint32_t length,
                                             gc::AllocKind allocKind,
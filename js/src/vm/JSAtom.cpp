@@ -15,6 +15,7 @@
 #include "mozilla/HashFunctions.h"  // mozilla::HashStringKnownLength
 #include "mozilla/RangedPtr.h"
 
+#include <atomic>
 #include <iterator>
 #include <string.h>
 
@@ -366,7 +367,16 @@ AtomsTable::~AtomsTable() {
   }
 }
 
+// Source of sweep epochs for all atoms tables in the process. Sharing a single
+// counter means an epoch identifies both a table and a sweep of that table.
+static mozilla::Atomic<uint32_t, mozilla::ReleaseAcquire> NextAtomsSweepEpoch(
+    1);
+
+void AtomsTable::updateSweepEpoch() { sweepEpoch_ = NextAtomsSweepEpoch++; }
+
 bool AtomsTable::init() {
+  updateSweepEpoch();
+
   for (size_t i = 0; i < PartitionCount; i++) {
     partitions[i] = js_new<Partition>(i);
     if (!partitions[i]) {
@@ -482,6 +492,7 @@ void js::TraceWellKnownSymbols(JSTracer* trc) {
 
 void AtomsTable::traceWeak(JSTracer* trc) {
   JSRuntime* rt = trc->runtime();
+  updateSweepEpoch();
   for (size_t i = 0; i < PartitionCount; i++) {
     AutoLock lock(rt, partitions[i]->lock);
     AtomSet& atoms = partitions[i]->atoms;
@@ -550,6 +561,8 @@ inline void AtomsTable::SweepIterator::popFront() {
 bool AtomsTable::startIncrementalSweep() {
   MOZ_ASSERT(JS::RuntimeHeapIsCollecting());
 
+  updateSweepEpoch();
+
   bool ok = true;
   for (size_t i = 0; i < PartitionCount; i++) {
     auto& part = *partitions[i];
@@ -716,16 +729,48 @@ static MOZ_ALWAYS_INLINE JSAtom* AtomizeAndCopyCharsFromLookup(
     return atom;
   }
 
-  // Validate the length before taking an atoms partition lock, as throwing an
-  // exception here may reenter this code.
-  if (MOZ_UNLIKELY(!JSString::validateLength(cx, length))) {
-    return nullptr;
+  // Try the per-context cache next. This is shared by all zones the context
+  // runs in and lets helper threads find atoms that are already in the atoms
+  // table without taking a partition lock. Like the per-Zone cache it is not
+  // used for pinned atoms, which must be updated in the table itself.
+  JSAtom** cachedAtom = nullptr;
+  uint32_t sweepEpoch = 0;
+  if (MOZ_LIKELY(pin == DoNotPinAtom)) {
+    AtomizeCache& cache = cx->atomizeCache();
+    sweepEpoch = cx->atoms().sweepEpoch();
+    cache.purgeIfStale(sweepEpoch);
+    cachedAtom = &cache.entryFor(lookup.hash);
+  }
+
+  // A helper thread can find an entry just before the main thread starts
+  // sweeping the atoms table, in which case the atom may be about to be
+  // finalized. Check the epoch again after the lookup and treat a change as a
+  // miss, so the locked path below deals with atoms found while sweeping.
+  JSAtom* atom = nullptr;
+  if (cachedAtom && *cachedAtom &&
+      AtomHasher::match(AtomStateEntry(*cachedAtom, false), lookup)) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (MOZ_LIKELY(cx->atoms().sweepEpoch() == sweepEpoch)) {
+      atom = AtomStateEntry(*cachedAtom, false).asPtr(cx);
+    }
   }
 
-  JSAtom* atom = cx->atoms().atomizeAndCopyChars(cx, chars, length, pin,
-                                                 indexValue, lookup);
   if (!atom) {
-    return nullptr;
+    // Validate the length before taking an atoms partition lock, as throwing
+    // an exception here may reenter this code.
+    if (MOZ_UNLIKELY(!JSString::validateLength(cx, length))) {
+      return nullptr;
+    }
+
+    atom = cx->atoms().atomizeAndCopyChars(cx, chars, length, pin, indexValue,
+                                           lookup);
+    if (!atom) {
+      return nullptr;
+    }
+
+    if (cachedAtom) {
+      *cachedAtom = atom;
+    }
   }
 
   if (MOZ_UNLIKELY(!cx->atomMarking().inlinedMarkAtomFallible(cx, atom))) {
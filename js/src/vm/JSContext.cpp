@@ -15,8 +15,10 @@
 #include "mozilla/MemoryReporting.h"
 #include "mozilla/Sprintf.h"
 #include "mozilla/TextUtils.h"
+#include "mozilla/TimeStamp.h"
 #include "mozilla/Utf8.h"  // mozilla::ConvertUtf16ToUtf8
 
+#include <algorithm>
 #include <stdarg.h>
 #include <string.h>
 #ifdef ANDROID
@@ -30,6 +32,7 @@
 
 #include "jsapi.h"  // JS_SetNativeStackQuota
 #include "jsexn.h"
+#include "jsfriendapi.h"  // js::JobQueueMetrics
 #include "jspubtd.h"
 #include "jstypes.h"
 
@@ -739,6 +742,20 @@ JS_PUBLIC_API void js::RunJobs(JSContext* cx) {
   JS::ClearKeptObjects(cx);
 }
 
+JS_PUBLIC_API bool js::RunJobsWithBudget(JSContext* cx,
+                                         mozilla::TimeDuration budget) {
+  MOZ_ASSERT(cx->internalJobQueue.ref());
+  bool drained = cx->internalJobQueue->runJobsWithBudget(cx, budget);
+  JS::ClearKeptObjects(cx);
+  return drained;
+}
+
+JS_PUBLIC_API void js::GetJobQueueMetrics(JSContext* cx,
+                                          JobQueueMetrics* metrics) {
+  MOZ_ASSERT(cx->internalJobQueue.ref());
+  cx->internalJobQueue->getMetrics(metrics);
+}
+
 JSObject* InternalJobQueue::getIncumbentGlobal(JSContext* cx) {
   if (!cx->compartment()) {
     return nullptr;
@@ -756,16 +773,30 @@ bool InternalJobQueue::enqueuePromiseJob(JSContext* cx,
     ReportOutOfMemory(cx);
     return false;
   }
+  maxQueueLength_ = std::max(maxQueueLength_, queue.length());
 
   JS::JobQueueMayNotBeEmpty(cx);
   return true;
 }
 
 void InternalJobQueue::runJobs(JSContext* cx) {
+  (void)drain(cx, mozilla::TimeStamp());
+}
+
+bool InternalJobQueue::runJobsWithBudget(JSContext* cx,
+                                         mozilla::TimeDuration budget) {
+  return drain(cx, mozilla::TimeStamp::Now() + budget);
+}
+
+bool InternalJobQueue::drain(JSContext* cx, mozilla::TimeStamp deadline) {
   if (draining_ || interrupted_) {
-    return;
+    return queue.empty();
   }
 
+  mozilla::TimeStamp start = mozilla::TimeStamp::Now();
+  uint64_t jobsRunAtStart = jobsRun_;
+  bool outOfTime = false;
+
   while (true) {
     cx->runtime()->offThreadPromiseState.ref().internalDrain(cx);
 
@@ -787,8 +818,18 @@ void InternalJobQueue::runJobs(JSContext* cx) {
         break;
       }
 
+      // Only look at the clock once per batch of jobs, so that draining
+      // with a budget stays cheap for queues of many short jobs.
+      if (!deadline.IsNull() && jobsRun_ != jobsRunAtStart &&
+          (jobsRun_ - jobsRunAtStart) % JobsPerBudgetCheck == 0 &&
+          mozilla::TimeStamp::Now() >= deadline) {
+        outOfTime = true;
+        break;
+      }
+
       job = queue.front();
       queue.popFront();
+      jobsRun_++;
 
       // If the next job is the last job in the job queue, allow
       // skipping the standard job queuing behavior.
@@ -825,6 +866,10 @@ void InternalJobQueue::runJobs(JSContext* cx) {
       break;
     }
 
+    if (outOfTime) {
+      break;
+    }
+
     queue.clear();
 
     // It's possible a job added a new off-thread promise task.
@@ -832,6 +877,21 @@ void InternalJobQueue::runJobs(JSContext* cx) {
       break;
     }
   }
+
+  lastDrainJobsRun_ = jobsRun_ - jobsRunAtStart;
+  lastDrainTime_ = mozilla::TimeStamp::Now() - start;
+  totalDrainTime_ += lastDrainTime_;
+
+  return queue.empty();
+}
+
+void InternalJobQueue::getMetrics(JobQueueMetrics* metrics) const {
+  metrics->queueLength = queue.length();
+  metrics->maxQueueLength = maxQueueLength_;
+  metrics->jobsRun = jobsRun_;
+  metrics->totalDrainTime = totalDrainTime_;
+  metrics->lastDrainJobsRun = lastDrainJobsRun_;
+  metrics->lastDrainTime = lastDrainTime_;
 }
 
 bool InternalJobQueue::empty() const { return queue.empty(); }
@@ -908,6 +968,7 @@ JSContext::JSContext(JSRuntime* runtime, const JS::ContextOptions& options)
       defaultFreeOp_(this, runtime, true),
       freeUnusedMemory(false),
       measuringExecutionTime_(this, false),
+      atomizeCache_(this),
       jitActivation(this, nullptr),
       isolate(this, nullptr),
       activation_(this, nullptr),
@@ -11,6 +11,7 @@
 
 #include "mozilla/Maybe.h"
 #include "mozilla/MemoryReporting.h"
+#include "mozilla/TimeStamp.h"
 
 #include "jstypes.h"  // JS_PUBLIC_API
 
@@ -81,6 +82,8 @@ class MOZ_RAII AutoCycleDetector {
 
 struct AutoResolving;
 
+struct JobQueueMetrics;
+
 struct ParseTask;
 
 class InternalJobQueue : public JS::JobQueue {
@@ -97,6 +100,12 @@ class InternalJobQueue : public JS::JobQueue {
   void runJobs(JSContext* cx) override;
   bool empty() const override;
 
+  // Like runJobs(), but stop once |budget| has elapsed. Returns true if the
+  // queue was completely drained.
+  bool runJobsWithBudget(JSContext* cx, mozilla::TimeDuration budget);
+
+  void getMetrics(JobQueueMetrics* metrics) const;
+
   // If we are currently in a call to runJobs(), make that call stop processing
   // jobs once the current one finishes, and return. If we are not currently in
   // a call to runJobs, make all future calls return immediately.
@@ -111,6 +120,20 @@ class InternalJobQueue : public JS::JobQueue {
 
   JS::PersistentRooted<Queue> queue;
 
+  // The number of jobs run between checks of the time budget.
+  static constexpr size_t JobsPerBudgetCheck = 8;
+
+  // Run jobs until the queue is empty, we are interrupted, or |deadline| has
+  // passed. A null deadline means no time limit.
+  bool drain(JSContext* cx, mozilla::TimeStamp deadline);
+
+  // Metrics reported through getMetrics().
+  size_t maxQueueLength_ = 0;
+  uint64_t jobsRun_ = 0;
+  uint64_t lastDrainJobsRun_ = 0;
+  mozilla::TimeDuration totalDrainTime_;
+  mozilla::TimeDuration lastDrainTime_;
+
   // True if we are in the midst of draining jobs from this queue. We use this
   // to avoid re-entry (nested calls simply return immediately).
   bool draining_;
@@ -199,6 +222,10 @@ struct JS_PUBLIC_API JSContext : public JS::RootingContext,
   // double-count execution time in reentrant situations.
   js::ContextData<bool> measuringExecutionTime_;
 
+  // Per-thread cache of recent atomizations, probed before taking an atoms
+  // table lock.
+  js::ContextData<js::AtomizeCache> atomizeCache_;
+
  public:
   // This is used by helper threads to change the runtime their context is
   // currently operating on.
@@ -218,6 +245,8 @@ struct JS_PUBLIC_API JSContext : public JS::RootingContext,
     return kind_ == js::ContextKind::HelperThread && freeUnusedMemory;
   }
 
+  js::AtomizeCache& atomizeCache() { return atomizeCache_.ref(); }
+
   bool isMeasuringExecutionTime() const { return measuringExecutionTime_; }
   void setIsMeasuringExecutionTime(bool value) {
     measuringExecutionTime_ = value;
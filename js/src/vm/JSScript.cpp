@@ -4820,9 +4820,13 @@ void JSScript::resetWarmUpCounterToDelayIonCompilation() {
   // because we don't want scripts to get stuck in the (Baseline) interpreter in
   // pathological cases.
 
-  if (getWarmUpCount() > jit::JitOptions.baselineJitWarmUpThreshold) {
+  uint32_t baselineThreshold =
+      warmUpData_.isWarmUpCount()
+          ? jit::JitOptions.baselineJitWarmUpThreshold
+          : warmUpData_.toJitScript()->baselineJitWarmUpThreshold(this);
+  if (getWarmUpCount() > baselineThreshold) {
     incWarmUpResetCounter();
-    uint32_t newCount = jit::JitOptions.baselineJitWarmUpThreshold;
+    uint32_t newCount = baselineThreshold;
     if (warmUpData_.isWarmUpCount()) {
       warmUpData_.resetWarmUpCount(newCount);
     } else {
@@ -75,6 +75,19 @@ inline void NativeObject::markDenseElementsNotPacked() {
   getElementsHeader()->markNonPacked();
 }
 
+inline void NativeObject::noteStoredDenseElements(const Value* src,
+                                                  uint32_t count) {
+  if (!denseElementsAreInt32()) {
+    return;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    if (!src[i].isInt32()) {
+      markDenseElementsNonInt32();
+      return;
+    }
+  }
+}
+
 inline void NativeObject::elementsRangePostWriteBarrier(uint32_t start,
                                                         uint32_t count) {
   if (!isTenured()) {
@@ -105,6 +118,7 @@ inline void NativeObject::copyDenseElements(uint32_t dstStart, const Value* src,
   if (count == 0) {
     return;
   }
+  noteStoredDenseElements(src, count);
   if (zone()->needsIncrementalBarrier()) {
     uint32_t numShifted = getElementsHeader()->numShiftedElements();
     for (uint32_t i = 0; i < count; ++i) {
@@ -124,6 +138,12 @@ inline void NativeObject::initDenseElements(NativeObject* src,
 
   const Value* vp = src->getDenseElements() + srcStart;
 
+  // Don't bother scanning the copied values for non-Int32 values if the source
+  // elements already tell us they can be there.
+  if (!src->denseElementsAreInt32()) {
+    markDenseElementsNonInt32();
+  }
+
   if (!src->denseElementsArePacked()) {
     // Mark non-packed if we're copying holes or if there are too many elements
     // to check this efficiently.
@@ -156,6 +176,7 @@ inline void NativeObject::initDenseElements(const Value* src, uint32_t count) {
   }
 #endif
 
+  noteStoredDenseElements(src, count);
   memcpy(reinterpret_cast<Value*>(elements_), src, count * sizeof(Value));
   elementsRangePostWriteBarrier(0, count);
 }
@@ -191,6 +212,7 @@ inline bool NativeObject::initDenseElementsFromRange(JSContext* cx, Iter begin,
 #ifdef DEBUG
     checkStoredValue(v);
 #endif
+    noteStoredDenseElement(v);
     sp->init(this, HeapSlot::Element, slot++, v);
   }
   MOZ_ASSERT(slot == count);
@@ -317,6 +339,7 @@ inline void NativeObject::ensureDenseInitializedLength(uint32_t index,
 
   if (index > initlen) {
     markDenseElementsNotPacked();
+    markDenseElementsNonInt32();
   }
 
   uint32_t numShifted = getElementsHeader()->numShiftedElements();
@@ -591,10 +591,10 @@ void NativeObject::moveShiftedElements() {
   // the shifted elements.
   newHeader->initializedLength += numShifted;
 
-  // Move the elements. Initialize to |undefined| to ensure pre-barriers
-  // don't see garbage.
+  // Move the elements. Initialize to |0| to ensure pre-barriers don't see
+  // garbage. (An Int32 value is used so the NON_INT32 flag isn't set.)
   for (size_t i = 0; i < numShifted; i++) {
-    initDenseElement(i, UndefinedValue());
+    initDenseElement(i, Int32Value(0));
   }
   moveDenseElements(0, numShifted, initLength);
 
@@ -668,7 +668,7 @@ bool NativeObject::tryUnshiftDenseElements(uint32_t count) {
     uint32_t initLen = header->initializedLength;
     setDenseInitializedLength(initLen + toShift);
     for (uint32_t i = 0; i < toShift; i++) {
-      initDenseElement(initLen + i, UndefinedValue());
+      initDenseElement(initLen + i, Int32Value(0));
     }
     moveDenseElements(toShift, 0, initLen);
 
@@ -689,9 +689,11 @@ bool NativeObject::tryUnshiftDenseElements(uint32_t count) {
 
   newHeader->unshiftShiftedElements(count);
 
-  // Initialize to |undefined| to ensure pre-barriers don't see garbage.
+  // Initialize to |0| to ensure pre-barriers don't see garbage. The caller
+  // overwrites these values, so use an Int32 value to not set the NON_INT32
+  // flag unnecessarily.
   for (uint32_t i = 0; i < count; i++) {
-    initDenseElement(i, UndefinedValue());
+    initDenseElement(i, Int32Value(0));
   }
 
   return true;
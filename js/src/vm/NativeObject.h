@@ -183,7 +183,12 @@ extern bool ArraySetLength(JSContext* cx, Handle<ArrayObject*> obj, HandleId id,
 class ObjectElements {
  public:
   enum Flags : uint16_t {
-    // (0x1 is unused)
+    // If this flag is not set, the elements are guaranteed to contain only
+    // Int32 values in [0, initializedLength). In particular, there are no
+    // holes, so an array without this flag is also packed. This flag is
+    // sticky: it's never cleared once set, even if the non-Int32 values are
+    // later overwritten or removed.
+    NON_INT32 = 0x1,
 
     // Present only if these elements correspond to an array with
     // non-writable length; never present for non-arrays.
@@ -305,6 +310,8 @@ class ObjectElements {
 
   void markNonPacked() { flags |= NON_PACKED; }
 
+  void markNonInt32() { flags |= NON_INT32; }
+
   void markMaybeInIteration() { flags |= MAYBE_IN_ITERATION; }
   bool maybeInIteration() { return flags & MAYBE_IN_ITERATION; }
 
@@ -381,6 +388,8 @@ class ObjectElements {
 
   bool isPacked() const { return !(flags & NON_PACKED); }
 
+  bool hasOnlyInt32Values() const { return !(flags & NON_INT32); }
+
   JS::PropertyAttributes elementAttributes() const {
     if (isFrozen()) {
       return {JS::PropertyAttribute::Enumerable};
@@ -1314,18 +1323,32 @@ class NativeObject : public JSObject {
     MOZ_ASSERT(index < getDenseInitializedLength());
     MOZ_ASSERT(isExtensible());
     checkStoredValue(val);
+    noteStoredDenseElement(val);
     elements_[index].init(this, HeapSlot::Element, unshiftedIndex(index), val);
   }
   void setDenseElementUnchecked(uint32_t index, const Value& val) {
     MOZ_ASSERT(index < getDenseInitializedLength());
     MOZ_ASSERT(!denseElementsAreFrozen());
     checkStoredValue(val);
+    noteStoredDenseElement(val);
     elements_[index].set(this, HeapSlot::Element, unshiftedIndex(index), val);
   }
 
   // Mark the dense elements as possibly containing holes.
   inline void markDenseElementsNotPacked();
 
+  // Mark the dense elements as possibly containing non-Int32 values.
+  void markDenseElementsNonInt32() { getElementsHeader()->markNonInt32(); }
+
+  // Update the NON_INT32 flag for values that are about to be stored in the
+  // dense elements.
+  MOZ_ALWAYS_INLINE void noteStoredDenseElement(const Value& v) {
+    if (MOZ_UNLIKELY(!v.isInt32())) {
+      markDenseElementsNonInt32();
+    }
+  }
+  inline void noteStoredDenseElements(const Value* src, uint32_t count);
+
  public:
   inline void initDenseElementHole(uint32_t index);
   inline void setDenseElementHole(uint32_t index);
@@ -1371,6 +1394,10 @@ class NativeObject : public JSObject {
     return getElementsHeader()->isPacked();
   }
 
+  bool denseElementsAreInt32() const {
+    return getElementsHeader()->hasOnlyInt32Values();
+  }
+
   void markDenseElementsMaybeInIteration() {
     getElementsHeader()->markMaybeInIteration();
   }
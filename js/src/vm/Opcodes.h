@@ -1430,6 +1430,22 @@
      *   Stack: => array
      */ \
     MACRO(NewArray, new_array, NULL, 5, 0, 1, JOF_UINT32|JOF_IC) \
+    /*
+     * Create and push a new Array object holding a copy of the elements of the
+     * preconstructed array `script->getObject(objectIndex)`.
+     *
+     * This is used for array literals whose elements are all constant
+     * primitives when `JSOp::Object` can't be used because the literal may be
+     * evaluated more than once. The elements are copied in bulk instead of
+     * being stored one at a time by `JSOp::InitElemArray`. The template array
+     * is never exposed to script.
+     *
+     *   Category: Objects
+     *   Type: Array literals
+     *   Operands: uint32_t objectIndex
+     *   Stack: => array
+     */ \
+    MACRO(NewArrayCopy, new_array_copy, NULL, 5, 0, 1, JOF_OBJECT) \
     /*
      * Initialize an array element `array[index]` with value `val`.
      *
@@ -1675,9 +1691,9 @@
      * `args` argument to `JSOp::SpreadCall`.
      *
      * This instruction and the branch around the iterator loop are emitted
-     * only when `arr` is itself a rest parameter, as in `(...arr) =>
-     * f(...arr)`, a strong hint that it's a packed Array whose prototype is
-     * `Array.prototype`.
+     * only when `arr` is the only argument and is a name or a property access
+     * on a name or `this`, as in `f(...arr)` or `f(...this.items)`, a hint
+     * that it's a packed Array whose prototype is `Array.prototype`.
      *
      * See `js::OptimizeSpreadCall`.
      *
@@ -3513,7 +3529,6 @@
  * a power of two.  Use this macro to do so.
  */
 #define FOR_EACH_TRAILING_UNUSED_OPCODE(MACRO) \
-  MACRO(227)                                   \
   MACRO(228)                                   \
   MACRO(229)                                   \
   MACRO(230)                                   \
@@ -33,10 +33,10 @@ class PlainObject : public NativeObject {
   void assertHasNoNonWritableOrAccessorPropExclProto() const;
 #endif
 
+ public:
   static inline JS::Result<PlainObject*, JS::OOM> createWithShape(
       JSContext* cx, JS::Handle<Shape*> shape);
 
- public:
   static inline JS::Result<PlainObject*, JS::OOM> createWithTemplate(
       JSContext* cx, JS::Handle<PlainObject*> templateObject);
 
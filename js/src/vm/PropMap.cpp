@@ -673,10 +673,15 @@ void DictionaryPropMap::removeProperty(JSContext* cx,
   JS::AutoCheckCannotGC nogc;
   MOZ_ASSERT(map->asLinked()->maybeTable(nogc) == table);
 
-  bool removingLast = (map == ptr->map() && *mapLength - 1 == ptr->index());
-  ptr->map()->asDictionary()->clearProperty(ptr->index());
-  map->incHoleCount();
+  DictionaryPropMap* propMap = ptr->map()->asDictionary();
+  uint32_t propIndex = ptr->index();
+  bool removingLast = (map == propMap && *mapLength - 1 == propIndex);
+
+  // Note: remove the table entry first because PropMapTable::remove needs the
+  // key.
   table->remove(ptr);
+  propMap->clearProperty(propIndex);
+  map->incHoleCount();
 
   if (removingLast) {
     skipTrailingHoles(map, mapLength);
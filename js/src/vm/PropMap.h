@@ -393,8 +393,11 @@ class PropMapTable {
   }
 
   void remove(Ptr ptr) {
+    // Record the removal in the cache instead of purging it. Objects used as
+    // hash maps often delete a key and then look it up or add it again.
+    PropertyKey key = ptr->map()->getKey(ptr->index());
     set_.remove(ptr);
-    purgeCache();
+    setCacheEntry(key, PropMapAndIndex());
   }
 
   void replaceEntry(Ptr ptr, PropertyKey key, PropMapAndIndex newEntry) {
@@ -886,6 +889,14 @@ class DictionaryPropMap final : public PropMap {
   // compacting heuristics.
   uint32_t holeCount_ = 0;
 
+ public:
+  // Dictionary objects with at least this many properties keep their
+  // PropMapTable on shrinking GCs. Lookups from JIT code use lookupPure, which
+  // can't allocate a new table, so without one these lookups have to walk the
+  // whole chain of maps.
+  static constexpr uint32_t MinEntriesToKeepTable = 64;
+
+ private:
   DictionaryPropMap(DictionaryPropMap* prev, PropertyKey key, PropertyInfo prop)
       : linkedData_(prev) {
     setHeaderFlagBits(IsDictionaryFlag | CanHaveTableFlag |
@@ -466,6 +466,7 @@ void Realm::fixupGlobal() {
 void Realm::purge() {
   dtoaCache.purge();
   newProxyCache.purge();
+  enumerablePropertiesCache.purge();
   objects_.iteratorCache.clearAndCompact();
   arraySpeciesLookup.purge();
   promiseLookup.purge();
@@ -125,6 +125,73 @@ class NewProxyCache {
   void purge() { entries_.reset(); }
 };
 
+// Cache used by Object.keys, Object.values and Object.entries. It maps a Shape
+// to the enumerable string-keyed properties of objects with that shape, in
+// property iteration order. Only objects whose own properties are fully
+// described by their Shape are cached, see CanUseEnumerablePropertiesCache.
+//
+// The cache is purged on GC, so the shapes and property keys don't need to be
+// traced.
+class EnumerablePropertiesCache {
+ public:
+  struct Property {
+    JSAtom* key;
+    uint32_t slot;
+  };
+  using PropertyVector = Vector<Property, 0, SystemAllocPolicy>;
+
+  struct Entry {
+    Shape* shape = nullptr;
+
+    // Whether all properties are data properties, so that their values can be
+    // read directly from the object's slots.
+    bool allDataProperties = false;
+
+    PropertyVector properties;
+  };
+
+ private:
+  static const size_t NumEntries = 8;
+  Entry entries_[NumEntries];
+  size_t nextEntry_ = 0;
+
+ public:
+  MOZ_ALWAYS_INLINE const Entry* lookup(Shape* shape) const {
+    for (const Entry& entry : entries_) {
+      if (entry.shape == shape) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  // Return an empty entry for |shape|, replacing an existing entry if needed.
+  Entry& add(Shape* shape) {
+    MOZ_ASSERT(shape);
+    MOZ_ASSERT(!lookup(shape));
+    Entry& entry = entries_[nextEntry_];
+    nextEntry_ = (nextEntry_ + 1) % NumEntries;
+    entry.shape = shape;
+    entry.allDataProperties = false;
+    entry.properties.clear();
+    return entry;
+  }
+
+  // Remove |entry| after a failed attempt to fill it in.
+  void remove(Entry& entry) {
+    entry.shape = nullptr;
+    entry.properties.clear();
+  }
+
+  void purge() {
+    for (Entry& entry : entries_) {
+      entry.shape = nullptr;
+      entry.properties.clearAndFree();
+    }
+    nextEntry_ = 0;
+  }
+};
+
 // [SMDOC] Object MetadataBuilder API
 //
 // We must ensure that all newly allocated JSObjects get their metadata
@@ -422,6 +489,7 @@ class JS::Realm : public JS::shadow::Realm {
 
   js::DtoaCache dtoaCache;
   js::NewProxyCache newProxyCache;
+  js::EnumerablePropertiesCache enumerablePropertiesCache;
   js::ArraySpeciesLookup arraySpeciesLookup;
   js::PromiseLookup promiseLookup;
 
@@ -17,6 +17,7 @@
 #include "frontend/TokenStream.h"
 #include "gc/HashUtil.h"
 #include "irregexp/RegExpAPI.h"
+#include "irregexp/RegExpLinear.h"
 #include "js/friend/ErrorMessages.h"  // js::GetErrorMessage, JSMSG_*
 #include "js/friend/StackLimits.h"    // js::ReportOverRecursed
 #include "js/Object.h"                // JS::GetBuiltinClass
@@ -24,6 +25,7 @@
 #include "js/RegExpFlags.h"  // JS::RegExpFlags
 #include "js/StableStringChars.h"
 #include "util/StringBuffer.h"
+#include "vm/HelperThreads.h"
 #include "vm/MatchPairs.h"
 #include "vm/RegExpStatics.h"
 #include "vm/StringType.h"
@@ -556,9 +558,18 @@ RegExpShared::RegExpShared(JSAtom* source, RegExpFlags flags)
     : CellWithTenuredGCPointer(source), pairCount_(0), flags(flags) {}
 
 void RegExpShared::traceChildren(JSTracer* trc) {
-  // Discard code to avoid holding onto ExecutablePools.
-  if (IsMarkingTrace(trc) && trc->runtime()->gc.isShrinkingGC()) {
-    discardJitCode();
+  if (IsMarkingTrace(trc)) {
+    if (gcsSinceExecution_ < UINT32_MAX) {
+      gcsSinceExecution_++;
+    }
+
+    // Discard code to avoid holding onto ExecutablePools, unless it is likely
+    // to be used again soon.
+    gc::GCRuntime& gc = trc->runtime()->gc;
+    if (gc.isShrinkingGC() &&
+        !zone()->regExps().keepJitCode(this, gc.majorGCCount())) {
+      discardJitCode();
+    }
   }
 
   TraceNullableCellHeaderEdge(trc, this, "RegExpShared source");
@@ -569,6 +580,7 @@ void RegExpShared::traceChildren(JSTracer* trc) {
       TraceNullableEdge(trc, &comp.jitCode, "RegExpShared code");
     }
     TraceNullableEdge(trc, &groupsTemplate_, "RegExpShared groups template");
+    TraceNullableEdge(trc, &requiredLiteral_, "RegExpShared required literal");
   }
 }
 
@@ -581,6 +593,44 @@ void RegExpShared::discardJitCode() {
   tables.clearAndFree();
 }
 
+size_t RegExpShared::jitCodeBytes() const {
+  size_t bytes = 0;
+  for (const auto& comp : compilationArray) {
+    if (jit::JitCode* code = comp.jitCode.unbarrieredGet()) {
+      bytes += code->instructionsSize();
+    }
+  }
+  return bytes;
+}
+
+void RegExpShared::discardByteCode() {
+  for (auto& comp : compilationArray) {
+    if (comp.byteCode) {
+      RemoveCellMemory(this, comp.byteCodeLength(),
+                       MemoryUse::RegExpSharedBytecode);
+      js_free(comp.byteCode);
+      comp.byteCode = nullptr;
+    }
+  }
+}
+
+void RegExpShared::clearBacktrackLimit() {
+  MOZ_ASSERT(kind() == RegExpShared::Kind::RegExp);
+  backtrackLimit_ = 0;
+  discardByteCode();
+  discardJitCode();
+}
+
+void RegExpShared::useLinearProgram(irregexp::LinearProgram* program) {
+  MOZ_ASSERT(kind() == RegExpShared::Kind::RegExp);
+  MOZ_ASSERT(!linearProgram_);
+  discardByteCode();
+  discardJitCode();
+  linearProgram_ = program;
+  AddCellMemory(this, program->allocatedBytes(),
+                MemoryUse::RegExpSharedLinearProgram);
+}
+
 void RegExpShared::finalize(JSFreeOp* fop) {
   for (auto& comp : compilationArray) {
     if (comp.byteCode) {
@@ -588,6 +638,13 @@ void RegExpShared::finalize(JSFreeOp* fop) {
       fop->free_(this, comp.byteCode, length, MemoryUse::RegExpSharedBytecode);
     }
   }
+  if (linearProgram_) {
+    fop->delete_(this, linearProgram_, linearProgram_->allocatedBytes(),
+                 MemoryUse::RegExpSharedLinearProgram);
+  }
+  if (offThreadCompileTask_) {
+    CancelOffThreadRegExpCompile(offThreadCompileTask_);
+  }
   if (namedCaptureIndices_) {
     size_t length = numNamedCaptures() * sizeof(uint32_t);
     fop->free_(this, namedCaptureIndices_, length,
@@ -619,12 +676,16 @@ bool RegExpShared::compileIfNecessary(JSContext* cx,
   if (re->kind() == RegExpShared::Kind::Unparsed) {
     needsCompile = true;
   }
-  if (re->kind() == RegExpShared::Kind::RegExp) {
+  if (re->kind() == RegExpShared::Kind::RegExp && !re->linearProgram()) {
     if (!re->isCompiled(input->hasLatin1Chars(), codeKind)) {
       needsCompile = true;
     }
   }
   if (needsCompile) {
+    if (codeKind == RegExpShared::CodeKind::Jitcode &&
+        irregexp::ShouldCompileOffThread(cx, re)) {
+      return irregexp::CompilePatternOffThread(cx, re, input);
+    }
     return irregexp::CompilePattern(cx, re, input, codeKind);
   }
   return true;
@@ -657,6 +718,8 @@ RegExpRunStatus RegExpShared::execute(JSContext* cx,
     return RegExpShared::executeAtom(re, input, start, matches);
   }
 
+  re->noteExecution();
+
   /*
    * Ensure sufficient memory for output vector.
    * No need to initialize it. The RegExp engine fills them in on a match.
@@ -666,6 +729,12 @@ RegExpRunStatus RegExpShared::execute(JSContext* cx,
     return RegExpRunStatus_Error;
   }
 
+  // Use the literal that every match contains to reject the input, or to
+  // skip ahead to the first place a match can start.
+  if (!re->skipToPossibleMatch(input, &start)) {
+    return RegExpRunStatus_Success_NotFound;
+  }
+
   uint32_t interruptRetries = 0;
   const uint32_t maxInterruptRetries = 4;
   do {
@@ -678,6 +747,16 @@ RegExpRunStatus RegExpShared::execute(JSContext* cx,
       cx->requestInterrupt(InterruptReason::CallbackUrgent);
     }
 #endif
+    if (result == RegExpRunStatus_Fallback) {
+      // Irregexp has backtracked too many times. Rerun the match with the
+      // linear-time engine, or without a backtrack limit if the pattern is
+      // too large for it.
+      irregexp::FallBackToLinearEngine(cx, re);
+      if (!compileIfNecessary(cx, re, input, RegExpShared::CodeKind::Any)) {
+        return RegExpRunStatus_Error;
+      }
+      continue;
+    }
     if (result == RegExpRunStatus_Error) {
       /* Execute can return RegExpRunStatus_Error:
        *
@@ -811,6 +890,75 @@ bool RegExpShared::markedForTierUp() const {
   return ticks_ == 0;
 }
 
+void RegExpShared::setRequiredLiteral(JSAtom* literal, bool isPrefix) {
+  MOZ_ASSERT(kind() == RegExpShared::Kind::RegExp);
+  MOZ_ASSERT(!requiredLiteral_);
+  MOZ_ASSERT(literal->length() > 0);
+  requiredLiteral_ = literal;
+  requiredLiteralIsPrefix_ = isPrefix;
+}
+
+void RegExpShared::setFirstChars(const FirstCharSet& chars, uint32_t count) {
+  MOZ_ASSERT(kind() == RegExpShared::Kind::RegExp);
+  MOZ_ASSERT(count > 0 && count <= MaxFirstChars);
+  firstChars_ = chars;
+  firstCharCount_ = count;
+}
+
+template <typename CharT>
+static size_t FindFirstChar(const RegExpShared::FirstCharSet& firstChars,
+                            const CharT* chars, size_t start, size_t length) {
+  for (size_t i = start; i < length; i++) {
+    char16_t c = chars[i];
+    if (c <= JSString::MAX_LATIN1_CHAR && firstChars.Test(c)) {
+      return i;
+    }
+  }
+  return length;
+}
+
+bool RegExpShared::skipToPossibleMatch(JSLinearString* input,
+                                       size_t* start) const {
+  size_t length = input->length();
+  if (*start > length) {
+    return true;
+  }
+
+  if (requiredLiteral_) {
+    MOZ_ASSERT(!sticky());
+    int res = StringFindPattern(input, requiredLiteral_, *start);
+    if (res == -1) {
+      return false;
+    }
+    if (requiredLiteralIsPrefix_) {
+      *start = size_t(res);
+    }
+  }
+
+  if (firstCharCount_) {
+    MOZ_ASSERT(!sticky());
+    JS::AutoCheckCannotGC nogc;
+    size_t index =
+        input->hasLatin1Chars()
+            ? FindFirstChar(firstChars_, input->latin1Chars(nogc), *start,
+                            length)
+            : FindFirstChar(firstChars_, input->twoByteChars(nogc), *start,
+                            length);
+    if (index == length) {
+      return false;
+    }
+    *start = index;
+  }
+
+  return true;
+}
+
+bool js::RegExpSkipToPossibleMatchRaw(RegExpShared* re, JSLinearString* input,
+                                      size_t* start) {
+  AutoUnsafeCallWithABI unsafe;
+  return re->skipToPossibleMatch(input, start);
+}
+
 static RegExpRunStatus ExecuteAtomImpl(RegExpShared* re, JSLinearString* input,
                                        size_t start, MatchPairs* matches) {
   MOZ_ASSERT(re->pairCount() == 1);
@@ -867,6 +1015,10 @@ size_t RegExpShared::sizeOfExcludingThis(mozilla::MallocSizeOf mallocSizeOf) {
     }
   }
 
+  if (linearProgram_) {
+    n += linearProgram_->sizeOfIncludingThis(mallocSizeOf);
+  }
+
   n += tables.sizeOfExcludingThis(mallocSizeOf);
   for (size_t i = 0; i < tables.length(); i++) {
     n += mallocSizeOf(tables[i].get());
@@ -994,6 +1146,28 @@ RegExpShared* RegExpZone::get(JSContext* cx, HandleAtom source,
   return shared;
 }
 
+bool RegExpZone::keepJitCode(RegExpShared* shared, uint64_t gcNumber) {
+  size_t codeBytes = shared->jitCodeBytes();
+  if (codeBytes == 0) {
+    return true;
+  }
+
+  if (gcNumber != keptCodeGCNumber_) {
+    keptCodeGCNumber_ = gcNumber;
+    keptCodeBytes_ = 0;
+  }
+
+  if (shared->gcsSinceExecution() <= CodeMaxAge &&
+      keptCodeBytes_ + codeBytes <= CodeMaxBytes) {
+    keptCodeBytes_ += codeBytes;
+    codeKeptCount_++;
+    return true;
+  }
+
+  codeDiscardedCount_++;
+  return false;
+}
+
 size_t RegExpZone::sizeOfIncludingThis(
     mozilla::MallocSizeOf mallocSizeOf) const {
   return mallocSizeOf(this) + set_.sizeOfExcludingThis(mallocSizeOf);
@@ -14,6 +14,7 @@
 #define vm_RegExpShared_h
 
 #include "mozilla/Assertions.h"
+#include "mozilla/BitSet.h"
 #include "mozilla/MemoryReporting.h"
 
 #include "gc/Barrier.h"
@@ -45,6 +46,11 @@ enum RegExpRunStatus : int32_t {
   RegExpRunStatus_Error = -1,
   RegExpRunStatus_Success = 1,
   RegExpRunStatus_Success_NotFound = 0,
+
+  // Returned by irregexp code that hit its backtrack limit. This never
+  // escapes RegExpShared::execute, which reruns the match with the
+  // linear-time engine.
+  RegExpRunStatus_Fallback = -3,
 };
 
 inline bool IsNativeRegExpEnabled() {
@@ -123,10 +129,46 @@ class RegExpShared
   uint32_t maxRegisters_ = 0;
   uint32_t ticks_ = 0;
 
+  // The number of major GCs since this regexp was last executed. Native code
+  // for recently executed regexps survives shrinking GCs; see
+  // RegExpZone::keepJitCode.
+  uint32_t gcsSinceExecution_ = 0;
+
+  // Irregexp code is compiled to give up after this many backtracks, or never
+  // if this is zero. When it gives up, matching switches to linearProgram_.
+  uint32_t backtrackLimit_ = 0;
+  irregexp::LinearProgram* linearProgram_ = nullptr;
+
+  // A helper thread compilation of native code, if one has been started and
+  // its code hasn't been linked yet.
+  irregexp::RegExpCompileTask* offThreadCompileTask_ = nullptr;
+
+  // A literal that every match contains, or starts with if
+  // requiredLiteralIsPrefix_. Used to reject the input, or to skip ahead to
+  // the first place a match can start, before running the matcher.
+  GCPtrAtom requiredLiteral_ = {};
+  bool requiredLiteralIsPrefix_ = false;
+
+  // If non-zero, every match starts with one of these firstCharCount_ Latin-1
+  // code units. Used like requiredLiteral_, for patterns such as large
+  // alternations that have no literal in common.
+  uint32_t firstCharCount_ = 0;
+
   uint32_t numNamedCaptures_ = {};
   uint32_t* namedCaptureIndices_ = {};
   GCPtr<PlainObject*> groupsTemplate_ = {};
 
+ public:
+  // One bit per Latin-1 code unit.
+  using FirstCharSet = mozilla::BitSet<256, uint32_t>;
+
+  // Sets of more first characters than this don't rule out enough positions
+  // to be worth checking.
+  static constexpr uint32_t MaxFirstChars = 64;
+
+ private:
+  FirstCharSet firstChars_;
+
   static int CompilationIndex(bool latin1) { return latin1 ? 0 : 1; }
 
   // Tables referenced by JIT code.
@@ -143,6 +185,8 @@ class RegExpShared
     return compilationArray[CompilationIndex(latin1)];
   }
 
+  void discardByteCode();
+
  public:
   ~RegExpShared() = delete;
 
@@ -176,6 +220,17 @@ class RegExpShared
   // Use the regular expression engine for this regexp.
   void useRegExpMatch(size_t parenCount);
 
+  void setRequiredLiteral(JSAtom* literal, bool isPrefix);
+  JSAtom* requiredLiteral() const { return requiredLiteral_; }
+  bool requiredLiteralIsPrefix() const { return requiredLiteralIsPrefix_; }
+
+  void setFirstChars(const FirstCharSet& chars, uint32_t count);
+  uint32_t firstCharCount() const { return firstCharCount_; }
+
+  // Returns false if no match can start at or after |*start|. Otherwise
+  // |*start| may be advanced past positions where no match can start.
+  bool skipToPossibleMatch(JSLinearString* input, size_t* start) const;
+
   static bool initializeNamedCaptures(JSContext* cx, HandleRegExpShared re,
                                       HandleNativeObject namedCaptures);
   PlainObject* getGroupsTemplate() { return groupsTemplate_; }
@@ -183,6 +238,12 @@ class RegExpShared
   void tierUpTick();
   bool markedForTierUp() const;
 
+  void noteExecution() { gcsSinceExecution_ = 0; }
+  uint32_t gcsSinceExecution() const { return gcsSinceExecution_; }
+
+  // The size of the native code for this regexp.
+  size_t jitCodeBytes() const;
+
   void setByteCode(ByteCode* code, bool latin1) {
     compilation(latin1).byteCode = code;
   }
@@ -195,6 +256,34 @@ class RegExpShared
   jit::JitCode* getJitCode(bool latin1) const {
     return compilation(latin1).jitCode;
   }
+  uint32_t backtrackLimit() const { return backtrackLimit_; }
+  void setBacktrackLimit(uint32_t limit) {
+    MOZ_ASSERT(!isCompiled());
+    backtrackLimit_ = limit;
+  }
+
+  // Discard the irregexp code, which was compiled with a backtrack limit, and
+  // recompile without one from now on.
+  void clearBacktrackLimit();
+
+  // Match using the linear-time engine from now on, and discard the irregexp
+  // code. Takes ownership of |program|.
+  void useLinearProgram(irregexp::LinearProgram* program);
+  irregexp::LinearProgram* linearProgram() const { return linearProgram_; }
+
+  irregexp::RegExpCompileTask* offThreadCompileTask() const {
+    return offThreadCompileTask_;
+  }
+  void setOffThreadCompileTask(irregexp::RegExpCompileTask* task) {
+    MOZ_ASSERT(!offThreadCompileTask_);
+    offThreadCompileTask_ = task;
+  }
+  irregexp::RegExpCompileTask* takeOffThreadCompileTask() {
+    irregexp::RegExpCompileTask* task = offThreadCompileTask_;
+    offThreadCompileTask_ = nullptr;
+    return task;
+  }
+
   uint32_t getMaxRegisters() const { return maxRegisters_; }
   void updateMaxRegisters(uint32_t numRegisters) {
     maxRegisters_ = std::max(maxRegisters_, numRegisters);
@@ -246,6 +335,18 @@ class RegExpShared
            offsetof(RegExpCompilation, jitCode);
   }
 
+  static size_t offsetOfGCsSinceExecution() {
+    return offsetof(RegExpShared, gcsSinceExecution_);
+  }
+
+  static size_t offsetOfRequiredLiteral() {
+    return offsetof(RegExpShared, requiredLiteral_);
+  }
+
+  static size_t offsetOfFirstCharCount() {
+    return offsetof(RegExpShared, firstCharCount_);
+  }
+
   static size_t offsetOfGroupsTemplate() {
     return offsetof(RegExpShared, groupsTemplate_);
   }
@@ -290,6 +391,21 @@ class RegExpZone {
       JS::GCHashSet<WeakHeapPtr<RegExpShared*>, Key, ZoneAllocPolicy>>;
   Set set_;
 
+  // Shrinking GCs discard the native code of regexps that haven't been
+  // executed in the last CodeMaxAge major GCs, and of any regexps beyond the
+  // first CodeMaxBytes of code, so that hot regexps aren't recompiled after
+  // every GC but cold ones don't hold on to executable memory.
+  static constexpr uint32_t CodeMaxAge = 4;
+  static constexpr size_t CodeMaxBytes = 1024 * 1024;
+
+  // The amount of code kept so far by the GC numbered keptCodeGCNumber_.
+  uint64_t keptCodeGCNumber_ = 0;
+  size_t keptCodeBytes_ = 0;
+
+  // The number of times a shrinking GC kept or discarded a regexp's code.
+  uint64_t codeKeptCount_ = 0;
+  uint64_t codeDiscardedCount_ = 0;
+
  public:
   explicit RegExpZone(Zone* zone);
 
@@ -304,6 +420,15 @@ class RegExpZone {
 
   RegExpShared* get(JSContext* cx, HandleAtom source, JS::RegExpFlags flags);
 
+  // Called when |shared| is marked by a shrinking GC, to decide whether to
+  // keep its native code.
+  bool keepJitCode(RegExpShared* shared, uint64_t gcNumber);
+
+  // Each time code is kept, it saves recompiling that regexp if it runs
+  // again.
+  uint64_t codeKeptCount() const { return codeKeptCount_; }
+  uint64_t codeDiscardedCount() const { return codeDiscardedCount_; }
+
 #ifdef DEBUG
   void clear() { set_.clear(); }
 #endif
@@ -418,6 +543,9 @@ class RegExpRealm {
 RegExpRunStatus ExecuteRegExpAtomRaw(RegExpShared* re, JSLinearString* input,
                                      size_t start, MatchPairs* matchPairs);
 
+bool RegExpSkipToPossibleMatchRaw(RegExpShared* re, JSLinearString* input,
+                                  size_t* start);
+
 } /* namespace js */
 
 namespace JS {
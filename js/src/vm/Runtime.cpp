@@ -265,14 +265,15 @@ void JSRuntime::destroyRuntime() {
     sourceHook = nullptr;
 
     /*
-     * Cancel any pending, in progress or completed Ion compilations and
-     * parse tasks. Waiting for wasm and compression tasks is done
-     * synchronously (on the main thread or during parse tasks), so no
-     * explicit canceling is needed for these.
+     * Cancel any pending, in progress or completed Ion compilations,
+     * parse tasks and regexp compilations. Waiting for wasm and compression
+     * tasks is done synchronously (on the main thread or during parse tasks),
+     * so no explicit canceling is needed for these.
      */
     CancelOffThreadIonCompile(this);
     CancelOffThreadParses(this);
     CancelOffThreadCompressions(this);
+    CancelOffThreadRegExpCompiles(this);
 
     /*
      * Flag us as being destroyed. This allows the GC to free things like
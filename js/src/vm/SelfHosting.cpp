@@ -2367,6 +2367,10 @@ static const JSFunctionSpec intrinsic_functions[] = {
                     0, IntrinsicTypedArrayElementSize),
     JS_FN("TypedArrayInitFromPackedArray",
           intrinsic_TypedArrayInitFromPackedArray, 2, 0),
+    JS_FN("TypedArrayNativeFill", intrinsic_TypedArrayNativeFill, 4, 0),
+    JS_FN("TypedArrayNativeIncludes", intrinsic_TypedArrayNativeIncludes, 3, 0),
+    JS_FN("TypedArrayNativeIndexOf", intrinsic_TypedArrayNativeIndexOf, 3, 0),
+    JS_FN("TypedArrayNativeReverse", intrinsic_TypedArrayNativeReverse, 1, 0),
     JS_INLINABLE_FN("TypedArrayLength", intrinsic_TypedArrayLength, 1, 0,
                     IntrinsicTypedArrayLength),
     JS_INLINABLE_FN("UnsafeGetBooleanFromReservedSlot",
@@ -28,10 +28,12 @@
 
 #include "js/StructuredClone.h"
 
+#include "mozilla/Atomics.h"
 #include "mozilla/Casting.h"
 #include "mozilla/CheckedInt.h"
 #include "mozilla/EndianUtils.h"
 #include "mozilla/FloatingPoint.h"
+#include "mozilla/PodOperations.h"
 #include "mozilla/RangedPtr.h"
 #include "mozilla/ScopeExit.h"
 
@@ -68,6 +70,7 @@
 #include "vm/InlineCharBuffer-inl.h"
 #include "vm/JSContext-inl.h"
 #include "vm/JSObject-inl.h"
+#include "vm/PlainObject-inl.h"  // js::PlainObject::createWithShape
 
 using namespace js;
 
@@ -135,6 +138,12 @@ enum StructuredDataType : uint32_t {
   SCTAG_TYPED_ARRAY_OBJECT,
   SCTAG_DATA_VIEW_OBJECT,
 
+  SCTAG_SHAPE_DEFINITION,
+  SCTAG_SHAPED_OBJECT,
+  SCTAG_SHAPED_PROPERTY_MISSING,
+
+  SCTAG_SHARED_STRING,
+
   SCTAG_TYPED_ARRAY_V1_MIN = 0xFFFF0100,
   SCTAG_TYPED_ARRAY_V1_INT8 = SCTAG_TYPED_ARRAY_V1_MIN + Scalar::Int8,
   SCTAG_TYPED_ARRAY_V1_UINT8 = SCTAG_TYPED_ARRAY_V1_MIN + Scalar::Uint8,
@@ -301,6 +310,116 @@ void SharedArrayRawBufferRefs::releaseAll() {
   refs_.clear();
 }
 
+// Two-byte strings at least this long are stored in SharedStringBuffers when
+// the clone data policy allows it.
+static const size_t SharedStringMinLength = 32 * 1024;
+
+namespace js {
+
+// The characters of a large string, shared by the structured clone data that
+// refers to them and by the external strings created when reading it. The
+// characters are immutable and follow the header in the same allocation, so
+// the external string finalizer can get back to the buffer.
+class SharedStringBuffer {
+  mozilla::Atomic<uintptr_t, mozilla::ReleaseAcquire> refCount_;
+  size_t length_;
+
+  explicit SharedStringBuffer(size_t length) : refCount_(1), length_(length) {}
+
+ public:
+  // Create a buffer holding a copy of the characters, with one reference.
+  static SharedStringBuffer* create(const char16_t* chars, size_t length) {
+    void* p = js_malloc(sizeof(SharedStringBuffer) + length * sizeof(char16_t));
+    if (!p) {
+      return nullptr;
+    }
+    auto* buffer = new (p) SharedStringBuffer(length);
+    mozilla::PodCopy(buffer->chars(), chars, length);
+    return buffer;
+  }
+
+  static SharedStringBuffer* fromChars(const char16_t* chars) {
+    return reinterpret_cast<SharedStringBuffer*>(
+               const_cast<char16_t*>(chars)) -
+           1;
+  }
+
+  size_t length() const { return length_; }
+  char16_t* chars() { return reinterpret_cast<char16_t*>(this + 1); }
+
+  void addReference() { refCount_++; }
+  void dropReference() {
+    if (--refCount_ == 0) {
+      js_free(this);
+    }
+  }
+
+  size_t sizeOfIncludingThisIfUnshared(mozilla::MallocSizeOf mallocSizeOf) {
+    return refCount_ == 1 ? mallocSizeOf(this) : 0;
+  }
+};
+
+}  // namespace js
+
+// External strings created from a SharedStringBuffer hold a reference to it.
+struct SharedStringBufferCallbacks : public JSExternalStringCallbacks {
+  void finalize(char16_t* chars) const override {
+    SharedStringBuffer::fromChars(chars)->dropReference();
+  }
+
+  size_t sizeOfBuffer(const char16_t* chars,
+                      mozilla::MallocSizeOf mallocSizeOf) const override {
+    return SharedStringBuffer::fromChars(chars)->sizeOfIncludingThisIfUnshared(
+        mallocSizeOf);
+  }
+};
+
+static constexpr SharedStringBufferCallbacks sharedStringBufferCallbacks;
+
+SharedStringBufferRefs& SharedStringBufferRefs::operator=(
+    SharedStringBufferRefs&& other) {
+  takeOwnership(std::move(other));
+  return *this;
+}
+
+SharedStringBufferRefs::~SharedStringBufferRefs() { releaseAll(); }
+
+bool SharedStringBufferRefs::acquire(JSContext* cx,
+                                     SharedStringBuffer* buffer) {
+  if (!refs_.append(buffer)) {
+    ReportOutOfMemory(cx);
+    return false;
+  }
+
+  buffer->addReference();
+  return true;
+}
+
+bool SharedStringBufferRefs::acquireAll(const SharedStringBufferRefs& that) {
+  if (!refs_.reserve(refs_.length() + that.refs_.length())) {
+    return false;
+  }
+
+  for (auto ref : that.refs_) {
+    ref->addReference();
+    MOZ_ALWAYS_TRUE(refs_.append(ref));
+  }
+
+  return true;
+}
+
+void SharedStringBufferRefs::takeOwnership(SharedStringBufferRefs&& other) {
+  MOZ_ASSERT(refs_.empty());
+  refs_ = std::move(other.refs_);
+}
+
+void SharedStringBufferRefs::releaseAll() {
+  for (auto ref : refs_) {
+    ref->dropReference();
+  }
+  refs_.clear();
+}
+
 // SCOutput provides an interface to write raw data -- eg uint64_ts, doubles,
 // arrays of bytes -- into a structured clone data output stream. It also knows
 // how to free any transferable data within that stream.
@@ -407,9 +526,15 @@ struct JSStructuredCloneReader {
                                    void* cbClosure)
       : in(in),
         allowedScope(scope),
+        storedScope(JS::StructuredCloneScope::Unassigned),
         cloneDataPolicy(cloneDataPolicy),
         objs(in.context()),
         allObjs(in.context()),
+        shapeDescriptors(in.context()),
+        shapeKeys(in.context()),
+        shapeSlots(in.context()),
+        shapes(in.context()),
+        shapedObjs(in.context()),
         numItemsRead(0),
         callbacks(cb),
         closure(cbClosure) {}
@@ -427,6 +552,8 @@ struct JSStructuredCloneReader {
   JSString* readStringImpl(uint32_t nchars, gc::InitialHeap heap);
   JSString* readString(uint32_t data, gc::InitialHeap heap = gc::DefaultHeap);
 
+  JSString* readSharedString(uint32_t length);
+
   BigInt* readBigInt(uint32_t data);
 
   [[nodiscard]] bool readTypedArray(uint32_t arrayType, uint64_t nelems,
@@ -440,6 +567,9 @@ struct JSStructuredCloneReader {
   [[nodiscard]] bool readV1ArrayBuffer(uint32_t arrayType, uint32_t nelems,
                                        MutableHandleValue vp);
   JSObject* readSavedFrame(uint32_t principalsTag);
+  [[nodiscard]] bool readShapeDefinition(uint32_t numKeys);
+  PlainObject* newObjectWithShapeKeys(uint32_t shapeIndex);
+  JSObject* readShapedObject(uint32_t tag, uint32_t data);
   [[nodiscard]] bool startRead(MutableHandleValue vp,
                                gc::InitialHeap strHeap = gc::DefaultHeap);
 
@@ -451,6 +581,10 @@ struct JSStructuredCloneReader {
   // be valid cross-process.)
   JS::StructuredCloneScope allowedScope;
 
+  // The scope recorded in the header by the writer. Unassigned until the
+  // header has been read.
+  JS::StructuredCloneScope storedScope;
+
   const JS::CloneDataPolicy cloneDataPolicy;
 
   // Stack of objects with properties remaining to be read.
@@ -469,6 +603,30 @@ struct JSStructuredCloneReader {
   // one `undefined` placeholder value (the readTypedArray hack).
   RootedValueVector allObjs;
 
+  // Shapes defined by SCTAG_SHAPE_DEFINITION, in the order they were read.
+  // The keys of shape i are shapeKeys[keysStart, keysStart + numKeys), and
+  // shapes[i] is the shape of the first object read with them. Objects with
+  // the same keys are created directly with that shape, and the slots of
+  // their properties are in shapeSlots.
+  struct ShapeDescriptor {
+    size_t keysStart;
+    uint32_t numKeys;
+  };
+  Vector<ShapeDescriptor> shapeDescriptors;
+  RootedIdVector shapeKeys;
+  Vector<uint32_t> shapeSlots;
+  JS::RootedVector<Shape*> shapes;
+
+  // Objects on the 'objs' stack that were read with SCTAG_SHAPE_DEFINITION or
+  // SCTAG_SHAPED_OBJECT. Their children are values only, one for each key of
+  // their shape.
+  struct ShapedObject {
+    size_t objsIndex;
+    uint32_t shapeIndex;
+    uint32_t nextKey;
+  };
+  Vector<ShapedObject> shapedObjs;
+
   size_t numItemsRead;
 
   // The user defined callbacks that will be used for cloning.
@@ -496,6 +654,8 @@ struct JSStructuredCloneWriter {
         objectEntries(out.context()),
         otherEntries(out.context()),
         memory(out.context()),
+        shapes(out.context()),
+        shapedObjs(out.context()),
         transferable(out.context(), tVal),
         transferableObjects(out.context(), TransferableObjectsSet(cx)),
         cloneDataPolicy(cloneDataPolicy) {
@@ -526,6 +686,7 @@ struct JSStructuredCloneWriter {
   bool writeTransferMap();
 
   bool writeString(uint32_t tag, JSString* str);
+  bool writeSharedString(JSString* str);
   bool writeBigInt(uint32_t tag, BigInt* bi);
   bool writeArrayBuffer(HandleObject obj);
   bool writeTypedArray(HandleObject obj);
@@ -535,6 +696,7 @@ struct JSStructuredCloneWriter {
   bool startObject(HandleObject obj, bool* backref);
   bool startWrite(HandleValue v);
   bool traverseObject(HandleObject obj, ESClass cls);
+  bool writeShapedObject(HandleObject obj, size_t count, bool* written);
   bool traverseMap(HandleObject obj);
   bool traverseSet(HandleObject obj);
   bool traverseSavedFrame(HandleObject obj);
@@ -582,6 +744,19 @@ struct JSStructuredCloneWriter {
                 SystemAllocPolicy>;
   Rooted<CloneMemory> memory;
 
+  // Shapes of the plain objects seen so far. The value is the index of the
+  // shape in the SCTAG_SHAPE_DEFINITION records written, or ShapeSeenOnce if
+  // the only object seen with the shape was written as a normal object.
+  static constexpr uint32_t ShapeSeenOnce = UINT32_MAX;
+  using ShapeMap = GCHashMap<Shape*, uint32_t, MovableCellHasher<Shape*>,
+                             SystemAllocPolicy>;
+  Rooted<ShapeMap> shapes;
+  uint32_t numShapesDefined = 0;
+
+  // Indices in objs of the objects written with SCTAG_SHAPE_DEFINITION or
+  // SCTAG_SHAPED_OBJECT, whose properties are written as values only.
+  Vector<size_t> shapedObjs;
+
   struct TransferableObjectsHasher : public DefaultHasher<JSObject*> {
     static inline HashNumber hash(const Lookup& l) {
       return DefaultHasher<JSObject*>::hash(l);
@@ -1214,6 +1389,47 @@ bool JSStructuredCloneWriter::writeString(uint32_t tag, JSString* str) {
              : out.writeChars(linear->twoByteChars(nogc), length);
 }
 
+bool JSStructuredCloneWriter::writeSharedString(JSString* str) {
+  MOZ_ASSERT(output().scope() == JS::StructuredCloneScope::SameProcess);
+
+  SharedStringBuffer* buffer;
+  if (str->isExternal() &&
+      str->asExternal().callbacks() == &sharedStringBufferCallbacks) {
+    // Strings read from an earlier clone already have a buffer.
+    buffer = SharedStringBuffer::fromChars(str->asExternal().twoByteChars());
+    if (!out.buf.stringBuffersHeld_.acquire(context(), buffer)) {
+      return false;
+    }
+  } else {
+    JSLinearString* linear = str->ensureLinear(context());
+    if (!linear) {
+      return false;
+    }
+
+    {
+      JS::AutoCheckCannotGC nogc;
+      buffer = SharedStringBuffer::create(linear->twoByteChars(nogc),
+                                          linear->length());
+    }
+    if (!buffer) {
+      ReportOutOfMemory(context());
+      return false;
+    }
+
+    // The clone data takes over the initial reference.
+    bool ok = out.buf.stringBuffersHeld_.acquire(context(), buffer);
+    buffer->dropReference();
+    if (!ok) {
+      return false;
+    }
+  }
+
+  static_assert(JSString::MAX_LENGTH <= UINT32_MAX);
+  intptr_t p = reinterpret_cast<intptr_t>(buffer);
+  return out.writePair(SCTAG_SHARED_STRING, uint32_t(buffer->length())) &&
+         out.writeBytes(&p, sizeof(p));
+}
+
 bool JSStructuredCloneWriter::writeBigInt(uint32_t tag, BigInt* bi) {
   bool signBit = bi->isNegative();
   size_t length = bi->digitLength();
@@ -1560,9 +1776,90 @@ bool JSStructuredCloneWriter::traverseObject(HandleObject obj, ESClass cls) {
                          NativeEndian::swapToLittleEndian(length));
   }
 
+  if (optimized && count > 0 && obj->is<PlainObject>()) {
+    bool written;
+    if (!writeShapedObject(obj, count, &written)) {
+      return false;
+    }
+    if (written) {
+      return true;
+    }
+  }
+
   return out.writePair(SCTAG_OBJECT_OBJECT, 0);
 }
 
+// Plain objects sharing a shape, like the records in an array of records, are
+// written with their property names only once. The second object seen with a
+// shape writes the names as a shape definition, and the following objects
+// with that shape refer to it by index. The properties of these objects are
+// values only, in the order of the names:
+//
+//     <SCTAG_SHAPE_DEFINITION tag for obj2, number of names>
+//       <key1 data>
+//       <key2 data>
+//       <val2.1 data>
+//       <val2.2 data>
+//     <end-of-children marker for obj2>
+//     <SCTAG_SHAPED_OBJECT tag for obj3, shape index>
+//       <val3.1 data>
+//       <val3.2 data>
+//     <end-of-children marker for obj3>
+//
+// Properties are still read lazily, as for other objects. If one has been
+// deleted by the time its value is written, SCTAG_SHAPED_PROPERTY_MISSING
+// takes the place of the value.
+bool JSStructuredCloneWriter::writeShapedObject(HandleObject obj, size_t count,
+                                                bool* written) {
+  *written = false;
+
+  // Dictionary shapes are never shared, and TryAppendNativeProperties has put
+  // the ids of any dense elements after the property names.
+  PlainObject* plainObj = &obj->as<PlainObject>();
+  if (plainObj->inDictionaryMode() ||
+      plainObj->getDenseInitializedLength() != 0) {
+    return true;
+  }
+
+  ShapeMap::AddPtr p = shapes.lookupForAdd(plainObj->shape());
+  if (!p) {
+    if (!shapes.add(p, plainObj->shape(), ShapeSeenOnce)) {
+      ReportOutOfMemory(context());
+      return false;
+    }
+    return true;
+  }
+
+  if (p->value() != ShapeSeenOnce) {
+    if (!out.writePair(SCTAG_SHAPED_OBJECT, p->value())) {
+      return false;
+    }
+  } else {
+    if (numShapesDefined == ShapeSeenOnce - 1) {
+      return true;
+    }
+    p->value() = numShapesDefined++;
+
+    // The property names are on top of objectEntries, in reverse order.
+    if (!out.writePair(SCTAG_SHAPE_DEFINITION, uint32_t(count))) {
+      return false;
+    }
+    for (size_t i = 1; i <= count; i++) {
+      jsid id = objectEntries[objectEntries.length() - i];
+      if (!writeString(SCTAG_STRING, JSID_TO_STRING(id))) {
+        return false;
+      }
+    }
+  }
+
+  if (!shapedObjs.append(objs.length() - 1)) {
+    return false;
+  }
+
+  *written = true;
+  return true;
+}
+
 // Use the same basic setup as for traverseObject, but now keys can themselves
 // be complex objects. Keys and values are visited first via startWrite(), then
 // the key's children (if any) are handled, then the value's children.
@@ -1746,7 +2043,13 @@ bool JSStructuredCloneWriter::startWrite(HandleValue v) {
   context()->check(v);
 
   if (v.isString()) {
-    return writeString(SCTAG_STRING, v.toString());
+    JSString* str = v.toString();
+    if (cloneDataPolicy.areSharedStringBuffersAllowed() &&
+        output().scope() == JS::StructuredCloneScope::SameProcess &&
+        str->length() >= SharedStringMinLength && str->hasTwoByteChars()) {
+      return writeSharedString(str);
+    }
+    return writeString(SCTAG_STRING, str);
   } else if (v.isInt32()) {
     return out.writePair(SCTAG_INT32, v.toInt32());
   } else if (v.isDouble()) {
@@ -2116,22 +2419,24 @@ bool JSStructuredCloneWriter::write(HandleValue v) {
 
         // If obj still has an own property named id, write it out.
         bool found;
-        if (GetOwnPropertyPure(context(), obj, id, val.address(), &found)) {
-          if (found) {
-            if (!startWrite(key) || !startWrite(val)) {
-              return false;
-            }
+        if (!GetOwnPropertyPure(context(), obj, id, val.address(), &found)) {
+          if (!HasOwnProperty(context(), obj, id, &found)) {
+            return false;
+          }
+          if (found && !GetProperty(context(), obj, obj, id, &val)) {
+            return false;
           }
-          continue;
-        }
-
-        if (!HasOwnProperty(context(), obj, id, &found)) {
-          return false;
         }
 
+        // The keys of shaped objects are in their shape definition.
+        bool shaped =
+            !shapedObjs.empty() && shapedObjs.back() == objs.length() - 1;
         if (found) {
-          if (!startWrite(key) || !GetProperty(context(), obj, obj, id, &val) ||
-              !startWrite(val)) {
+          if ((!shaped && !startWrite(key)) || !startWrite(val)) {
+            return false;
+          }
+        } else if (shaped) {
+          if (!out.writePair(SCTAG_SHAPED_PROPERTY_MISSING, 0)) {
             return false;
           }
         }
@@ -2140,6 +2445,9 @@ bool JSStructuredCloneWriter::write(HandleValue v) {
       if (!out.writePair(SCTAG_END_OF_KEYS, 0)) {
         return false;
       }
+      if (!shapedObjs.empty() && shapedObjs.back() == objs.length() - 1) {
+        shapedObjs.popBack();
+      }
       objs.popBack();
       counts.popBack();
     }
@@ -2174,6 +2482,40 @@ JSString* JSStructuredCloneReader::readString(uint32_t data,
                 : readStringImpl<char16_t>(nchars, heap);
 }
 
+JSString* JSStructuredCloneReader::readSharedString(uint32_t length) {
+  // Only SameProcess clones can refer to SharedStringBuffers, and only readers
+  // whose policy allows them may use one. The pointer in any other data can't
+  // be trusted.
+  if (allowedScope > JS::StructuredCloneScope::SameProcess ||
+      storedScope != JS::StructuredCloneScope::SameProcess ||
+      !cloneDataPolicy.areSharedStringBuffersAllowed()) {
+    JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
+                              JSMSG_SC_BAD_SERIALIZED_DATA,
+                              "invalid shared string");
+    return nullptr;
+  }
+
+  intptr_t p;
+  if (!in.readBytes(&p, sizeof(p))) {
+    in.reportTruncated();
+    return nullptr;
+  }
+
+  SharedStringBuffer* buffer = reinterpret_cast<SharedStringBuffer*>(p);
+  MOZ_RELEASE_ASSERT(buffer->length() == length);
+
+  // The clone data keeps the buffer alive while it's being read. The new
+  // string holds its own reference.
+  buffer->addReference();
+  JSString* str = JS_NewExternalString(context(), buffer->chars(), length,
+                                       &sharedStringBufferCallbacks);
+  if (!str) {
+    buffer->dropReference();
+    return nullptr;
+  }
+  return str;
+}
+
 BigInt* JSStructuredCloneReader::readBigInt(uint32_t data) {
   size_t length = data & BitMask(31);
   bool isNegative = data & (1 << 31);
@@ -2565,6 +2907,132 @@ static bool PrimitiveToObject(JSContext* cx, MutableHandleValue vp) {
   return true;
 }
 
+bool JSStructuredCloneReader::readShapeDefinition(uint32_t numKeys) {
+  JSContext* cx = context();
+
+  if (!shapeDescriptors.append(ShapeDescriptor{shapeKeys.length(), numKeys})) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < numKeys; i++) {
+    uint32_t tag, data;
+    if (!in.readPair(&tag, &data)) {
+      return false;
+    }
+    if (tag != SCTAG_STRING) {
+      JS_ReportErrorNumberASCII(cx, GetErrorMessage, nullptr,
+                                JSMSG_SC_BAD_SERIALIZED_DATA,
+                                "shape key expected");
+      return false;
+    }
+
+    JSString* str = readString(data, gc::TenuredHeap);
+    if (!str) {
+      return false;
+    }
+    JSAtom* atom = AtomizeString(cx, str);
+    if (!atom) {
+      return false;
+    }
+
+    // Shapes only have named properties. Indexed properties are elements.
+    jsid id = AtomToId(atom);
+    if (!JSID_IS_STRING(id)) {
+      JS_ReportErrorNumberASCII(cx, GetErrorMessage, nullptr,
+                                JSMSG_SC_BAD_SERIALIZED_DATA,
+                                "invalid shape key");
+      return false;
+    }
+    if (!shapeKeys.append(id)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Create a plain object with an undefined data property for each key of the
+// shape, in order. The first object created for a shape provides the shape
+// and property slots of the objects read with SCTAG_SHAPED_OBJECT.
+PlainObject* JSStructuredCloneReader::newObjectWithShapeKeys(
+    uint32_t shapeIndex) {
+  JSContext* cx = context();
+  ShapeDescriptor desc = shapeDescriptors[shapeIndex];
+
+  gc::AllocKind allocKind = gc::GetGCObjectKind(desc.numKeys);
+  Rooted<PlainObject*> obj(
+      cx, NewBuiltinClassInstance<PlainObject>(cx, allocKind));
+  if (!obj) {
+    return nullptr;
+  }
+
+  RootedId id(cx);
+  for (uint32_t i = 0; i < desc.numKeys; i++) {
+    id = shapeKeys[desc.keysStart + i];
+    if (!DefineDataProperty(cx, obj, id, UndefinedHandleValue)) {
+      return nullptr;
+    }
+  }
+
+  if (shapeIndex == shapes.length()) {
+    for (uint32_t i = 0; i < desc.numKeys; i++) {
+      mozilla::Maybe<PropertyInfo> prop =
+          obj->lookupPure(shapeKeys[desc.keysStart + i]);
+      MOZ_ASSERT(prop.isSome() && prop->isDataProperty());
+      if (!shapeSlots.append(prop->slot())) {
+        return nullptr;
+      }
+    }
+    if (!shapes.append(obj->shape())) {
+      return nullptr;
+    }
+  }
+
+  return obj;
+}
+
+JSObject* JSStructuredCloneReader::readShapedObject(uint32_t tag,
+                                                    uint32_t data) {
+  JSContext* cx = context();
+
+  Rooted<PlainObject*> obj(cx);
+  uint32_t shapeIndex;
+  if (tag == SCTAG_SHAPE_DEFINITION) {
+    shapeIndex = shapeDescriptors.length();
+    if (!readShapeDefinition(data)) {
+      return nullptr;
+    }
+    obj = newObjectWithShapeKeys(shapeIndex);
+  } else {
+    shapeIndex = data;
+    if (shapeIndex >= shapeDescriptors.length()) {
+      JS_ReportErrorNumberASCII(cx, GetErrorMessage, nullptr,
+                                JSMSG_SC_BAD_SERIALIZED_DATA,
+                                "invalid shape index");
+      return nullptr;
+    }
+
+    // Dictionary shapes can't be shared, so define the properties again in
+    // that case.
+    if (shapes[shapeIndex]->isDictionary()) {
+      obj = newObjectWithShapeKeys(shapeIndex);
+    } else {
+      Rooted<Shape*> shape(cx, shapes[shapeIndex]);
+      JS_TRY_VAR_OR_RETURN_NULL(cx, obj,
+                                PlainObject::createWithShape(cx, shape));
+    }
+  }
+  if (!obj) {
+    return nullptr;
+  }
+
+  if (!objs.append(ObjectValue(*obj)) ||
+      !shapedObjs.append(ShapedObject{objs.length() - 1, shapeIndex, 0})) {
+    return nullptr;
+  }
+  return obj;
+}
+
 bool JSStructuredCloneReader::startRead(MutableHandleValue vp,
                                         gc::InitialHeap strHeap) {
   uint32_t tag, data;
@@ -2610,6 +3078,15 @@ bool JSStructuredCloneReader::startRead(MutableHandleValue vp,
       break;
     }
 
+    case SCTAG_SHARED_STRING: {
+      JSString* str = readSharedString(data);
+      if (!str) {
+        return false;
+      }
+      vp.setString(str);
+      break;
+    }
+
     case SCTAG_NUMBER_OBJECT: {
       double d;
       if (!in.readDouble(&d)) {
@@ -2706,6 +3183,16 @@ bool JSStructuredCloneReader::startRead(MutableHandleValue vp,
       break;
     }
 
+    case SCTAG_SHAPE_DEFINITION:
+    case SCTAG_SHAPED_OBJECT: {
+      JSObject* obj = readShapedObject(tag, data);
+      if (!obj) {
+        return false;
+      }
+      vp.setObject(*obj);
+      break;
+    }
+
     case SCTAG_BACK_REFERENCE_OBJECT: {
       if (data >= allObjs.length() || !allObjs[data].isObject()) {
         JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
@@ -2719,7 +3206,9 @@ bool JSStructuredCloneReader::startRead(MutableHandleValue vp,
 
     case SCTAG_TRANSFER_MAP_HEADER:
     case SCTAG_TRANSFER_MAP_PENDING_ENTRY:
-      // We should be past all the transfer map tags.
+    case SCTAG_SHAPED_PROPERTY_MISSING:
+      // We should be past all the transfer map tags, and missing properties
+      // only appear in place of the values of shaped objects.
       JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
                                 JSMSG_SC_BAD_SERIALIZED_DATA, "invalid input");
       return false;
@@ -2861,7 +3350,6 @@ bool JSStructuredCloneReader::readHeader() {
     return in.reportTruncated();
   }
 
-  JS::StructuredCloneScope storedScope;
   if (tag == SCTAG_HEADER) {
     MOZ_ALWAYS_TRUE(in.readPair(&tag, &data));
     storedScope = JS::StructuredCloneScope(data);
@@ -3265,11 +3753,26 @@ bool JSStructuredCloneReader::read(MutableHandleValue vp, size_t nbytes) {
       return false;
     }
 
+    bool shaped =
+        !shapedObjs.empty() && shapedObjs.back().objsIndex == objs.length() - 1;
+
     if (tag == SCTAG_END_OF_KEYS) {
       if (!childCounter.handleEndOfChildren(objs)) {
         return false;
       }
 
+      if (shaped) {
+        const ShapedObject& shapedObj = shapedObjs.back();
+        if (shapedObj.nextKey !=
+            shapeDescriptors[shapedObj.shapeIndex].numKeys) {
+          JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
+                                    JSMSG_SC_BAD_SERIALIZED_DATA,
+                                    "missing shaped object values");
+          return false;
+        }
+        shapedObjs.popBack();
+      }
+
       // Pop the current obj off the stack, since we are done with it and
       // its children.
       MOZ_ALWAYS_TRUE(in.readPair(&tag, &data));
@@ -3277,6 +3780,53 @@ bool JSStructuredCloneReader::read(MutableHandleValue vp, size_t nbytes) {
       continue;
     }
 
+    // Shaped objects: the children are the values of the properties named
+    // by the shape's keys, in order. The properties already exist, so store
+    // the values directly in their slots.
+    if (shaped) {
+      ShapedObject& shapedObj = shapedObjs.back();
+      uint32_t shapeIndex = shapedObj.shapeIndex;
+      const ShapeDescriptor& desc = shapeDescriptors[shapeIndex];
+      if (shapedObj.nextKey == desc.numKeys) {
+        JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
+                                  JSMSG_SC_BAD_SERIALIZED_DATA,
+                                  "too many shaped object values");
+        return false;
+      }
+      size_t keyIndex = desc.keysStart + shapedObj.nextKey++;
+      RootedId id(context(), shapeKeys[keyIndex]);
+
+      if (tag == SCTAG_SHAPED_PROPERTY_MISSING) {
+        MOZ_ALWAYS_TRUE(in.readPair(&tag, &data));
+        ObjectOpResult result;
+        if (!DeleteProperty(context(), obj, id, result)) {
+          return false;
+        }
+        continue;
+      }
+
+      RootedValue val(context());
+      if (!startRead(&val) || !childCounter.postStartRead(objs)) {
+        return false;
+      }
+
+      // Objects that had properties deleted have a different shape.
+      PlainObject& plainObj = obj->as<PlainObject>();
+      if (plainObj.shape() == shapes[shapeIndex]) {
+        plainObj.setSlot(shapeSlots[keyIndex], val);
+        continue;
+      }
+      mozilla::Maybe<PropertyInfo> prop = plainObj.lookupPure(id);
+      if (prop.isNothing()) {
+        JS_ReportErrorNumberASCII(context(), GetErrorMessage, nullptr,
+                                  JSMSG_SC_BAD_SERIALIZED_DATA,
+                                  "invalid shaped object value");
+        return false;
+      }
+      plainObj.setSlot(prop->slot(), val);
+      continue;
+    }
+
     // The input stream contains a sequence of "child" values, whose
     // interpretation depends on the type of obj. These values can be
     // anything, and startRead() will push onto 'objs' for any non-leaf
@@ -3495,6 +4045,7 @@ void JSAutoStructuredCloneBuffer::clear() {
   data_.discardTransferables();
   data_.ownTransferables_ = OwnTransferablePolicy::NoTransferables;
   data_.refsHeld_.releaseAll();
+  data_.stringBuffersHeld_.releaseAll();
   data_.Clear();
   version_ = 0;
 }
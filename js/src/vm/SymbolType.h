@@ -70,6 +70,8 @@ class Symbol
   SymbolCode code() const { return code_; }
   js::HashNumber hash() const { return hash_; }
 
+  static constexpr size_t offsetOfHash() { return offsetof(Symbol, hash_); }
+
   bool isWellKnownSymbol() const {
     return uint32_t(code_) < WellKnownSymbolLimit;
   }
@@ -534,6 +534,37 @@ class ElementSpecific {
     return true;
   }
 
+  // Convert |v| to the element type. canConvertInfallibly(v) must be true.
+  static T infallibleValueToNative(const Value& v) {
+    if (TypeIDOfType<T>::id == Scalar::BigInt64) {
+      if (v.isBigInt()) {
+        return T(BigInt::toInt64(v.toBigInt()));
+      }
+      return T(v.toBoolean());
+    }
+    if (TypeIDOfType<T>::id == Scalar::BigUint64) {
+      if (v.isBigInt()) {
+        return T(BigInt::toUint64(v.toBigInt()));
+      }
+      return T(v.toBoolean());
+    }
+    if (v.isInt32()) {
+      return T(v.toInt32());
+    }
+    if (v.isDouble()) {
+      return doubleToNative(v.toDouble());
+    }
+    if (v.isBoolean()) {
+      return T(v.toBoolean());
+    }
+    if (v.isNull()) {
+      return T(0);
+    }
+
+    MOZ_ASSERT(v.isUndefined());
+    return TypeIsFloatingPoint<T>() ? T(JS::GenericNaN()) : T(0);
+  }
+
  private:
   static bool setFromOverlappingTypedArray(Handle<TypedArrayObject*> target,
                                            Handle<TypedArrayObject*> source,
@@ -664,36 +695,6 @@ class ElementSpecific {
     return v.isNumber() || v.isBoolean() || v.isNull() || v.isUndefined();
   }
 
-  static T infallibleValueToNative(const Value& v) {
-    if (TypeIDOfType<T>::id == Scalar::BigInt64) {
-      if (v.isBigInt()) {
-        return T(BigInt::toInt64(v.toBigInt()));
-      }
-      return T(v.toBoolean());
-    }
-    if (TypeIDOfType<T>::id == Scalar::BigUint64) {
-      if (v.isBigInt()) {
-        return T(BigInt::toUint64(v.toBigInt()));
-      }
-      return T(v.toBoolean());
-    }
-    if (v.isInt32()) {
-      return T(v.toInt32());
-    }
-    if (v.isDouble()) {
-      return doubleToNative(v.toDouble());
-    }
-    if (v.isBoolean()) {
-      return T(v.toBoolean());
-    }
-    if (v.isNull()) {
-      return T(0);
-    }
-
-    MOZ_ASSERT(v.isUndefined());
-    return TypeIsFloatingPoint<T>() ? T(JS::GenericNaN()) : T(0);
-  }
-
   static bool valueToNative(JSContext* cx, HandleValue v, T* result) {
     MOZ_ASSERT(!v.isMagic());
 
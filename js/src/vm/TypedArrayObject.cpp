@@ -12,8 +12,11 @@
 #include "mozilla/PodOperations.h"
 #include "mozilla/TextUtils.h"
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <string.h>
+#include <type_traits>
 #if !defined(XP_WIN) && !defined(__wasi__)
 #  include <sys/mman.h>
 #endif
@@ -1928,6 +1931,301 @@ bool TypedArrayObject::copyWithin(JSContext* cx, unsigned argc, Value* vp) {
                               TypedArrayObject::copyWithin_impl>(cx, args);
 }
 
+/*
+ * Bulk element operations used by the self-hosted fill, indexOf, includes and
+ * reverse methods. The self-hosted code performs all argument conversions and
+ * detachment checks, so these can work directly on the element data.
+ *
+ * For unshared memory these are written as plain loops over the element type
+ * (or memset/memchr for single-byte elements), which compilers vectorize. For
+ * shared memory every access has to go through the racy-access primitives in
+ * |jit::AtomicOperations|.
+ */
+
+template <typename T, typename Ops>
+static void TypedArrayFillElements(TypedArrayObject* tarray, T value,
+                                   size_t start, size_t end) {
+  MOZ_ASSERT(start <= end && end <= tarray->length());
+
+  SharedMem<T*> data = Ops::extract(tarray).template cast<T*>();
+  if constexpr (std::is_same_v<Ops, UnsharedOps>) {
+    T* elements = data.unwrapUnshared();
+    if constexpr (sizeof(T) == 1) {
+      uint8_t byte;
+      memcpy(&byte, &value, sizeof(T));
+      memset(elements + start, byte, end - start);
+    } else {
+      std::fill(elements + start, elements + end, value);
+    }
+  } else {
+    for (size_t i = start; i < end; i++) {
+      Ops::store(data + i, value);
+    }
+  }
+}
+
+template <typename T>
+static void TypedArrayFillElements(TypedArrayObject* tarray, const Value& v,
+                                   size_t start, size_t end) {
+  if (tarray->isSharedMemory()) {
+    T value = ElementSpecific<T, SharedOps>::infallibleValueToNative(v);
+    TypedArrayFillElements<T, SharedOps>(tarray, value, start, end);
+  } else {
+    T value = ElementSpecific<T, UnsharedOps>::infallibleValueToNative(v);
+    TypedArrayFillElements<T, UnsharedOps>(tarray, value, start, end);
+  }
+}
+
+bool js::intrinsic_TypedArrayNativeFill(JSContext* cx, unsigned argc,
+                                        Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  MOZ_ASSERT(args.length() == 4);
+  MOZ_ASSERT(args[1].isNumber() || args[1].isBigInt());
+
+  auto* tarray = &args[0].toObject().as<TypedArrayObject>();
+  MOZ_ASSERT(!tarray->hasDetachedBuffer());
+
+  size_t start = size_t(args[2].toNumber());
+  size_t end = size_t(args[3].toNumber());
+  MOZ_ASSERT(start <= end);
+  MOZ_ASSERT(end <= tarray->length());
+
+  switch (tarray->type()) {
+#define FILL_ELEMENTS(T, N)                                 \
+  case Scalar::N:                                           \
+    TypedArrayFillElements<T>(tarray, args[1], start, end); \
+    break;
+    JS_FOR_EACH_TYPED_ARRAY(FILL_ELEMENTS)
+#undef FILL_ELEMENTS
+    default:
+      MOZ_CRASH("Unsupported TypedArray type");
+  }
+
+  args.rval().setUndefined();
+  return true;
+}
+
+// Convert the search element of indexOf or includes to the element type.
+// Returns false if |v| can't be equal to any element of this type, e.g. if
+// it's a non-integral number and the elements are integers. NaN is never
+// converted; includes() handles it separately.
+template <typename T>
+static bool SearchElementToNative(const Value& v, T* result) {
+  if constexpr (std::is_same_v<T, int64_t>) {
+    return v.isBigInt() && BigInt::isInt64(v.toBigInt(), result);
+  } else if constexpr (std::is_same_v<T, uint64_t>) {
+    return v.isBigInt() && BigInt::isUint64(v.toBigInt(), result);
+  } else {
+    if (!v.isNumber()) {
+      return false;
+    }
+    double d = v.toNumber();
+
+    if constexpr (TypeIsFloatingPoint<T>()) {
+      if (mozilla::IsNaN(d)) {
+        return false;
+      }
+      *result = T(d);
+      return double(*result) == d;
+    } else {
+      using Limits = std::numeric_limits<
+          std::conditional_t<std::is_same_v<T, uint8_clamped>, uint8_t, T>>;
+      if (!(d >= double(Limits::min()) && d <= double(Limits::max()))) {
+        return false;
+      }
+
+      // All non-BigInt integer element types fit into int64_t.
+      int64_t i = int64_t(d);
+      if (double(i) != d) {
+        return false;
+      }
+      *result = T(i);
+      return true;
+    }
+  }
+}
+
+// Return the index of the first element in [start, length) which is equal to
+// |value|, or |length| if there's no such element.
+template <typename T, typename Ops>
+static size_t TypedArrayFindElement(TypedArrayObject* tarray, T value,
+                                    size_t start, size_t length) {
+  SharedMem<T*> data = Ops::extract(tarray).template cast<T*>();
+  if constexpr (std::is_same_v<Ops, UnsharedOps>) {
+    const T* elements = data.unwrapUnshared();
+    if constexpr (sizeof(T) == 1) {
+      uint8_t byte;
+      memcpy(&byte, &value, sizeof(T));
+      const auto* bytes = reinterpret_cast<const uint8_t*>(elements);
+      const void* found = memchr(bytes + start, byte, length - start);
+      return found ? static_cast<const uint8_t*>(found) - bytes : length;
+    } else {
+      const T* found = std::find(elements + start, elements + length, value);
+      return found - elements;
+    }
+  } else {
+    for (size_t i = start; i < length; i++) {
+      if (Ops::load(data + i) == value) {
+        return i;
+      }
+    }
+    return length;
+  }
+}
+
+template <typename T, typename Ops>
+static bool TypedArrayHasNaN(TypedArrayObject* tarray, size_t start,
+                             size_t length) {
+  SharedMem<T*> data = Ops::extract(tarray).template cast<T*>();
+  for (size_t i = start; i < length; i++) {
+    if (mozilla::IsNaN(Ops::load(data + i))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename T>
+static bool TypedArrayHasNaN(TypedArrayObject* tarray, size_t start) {
+  size_t length = tarray->length();
+  if (tarray->isSharedMemory()) {
+    return TypedArrayHasNaN<T, SharedOps>(tarray, start, length);
+  }
+  return TypedArrayHasNaN<T, UnsharedOps>(tarray, start, length);
+}
+
+template <typename T>
+static size_t TypedArrayFindElement(TypedArrayObject* tarray, const Value& v,
+                                    size_t start, size_t length) {
+  T value;
+  if (!SearchElementToNative(v, &value)) {
+    return length;
+  }
+  if (tarray->isSharedMemory()) {
+    return TypedArrayFindElement<T, SharedOps>(tarray, value, start, length);
+  }
+  return TypedArrayFindElement<T, UnsharedOps>(tarray, value, start, length);
+}
+
+static size_t TypedArrayFindElement(TypedArrayObject* tarray, const Value& v,
+                                    size_t start) {
+  size_t length = tarray->length();
+  MOZ_ASSERT(start < length);
+  MOZ_ASSERT(!tarray->hasDetachedBuffer());
+
+  switch (tarray->type()) {
+#define FIND_ELEMENT(T, N) \
+  case Scalar::N:          \
+    return TypedArrayFindElement<T>(tarray, v, start, length);
+    JS_FOR_EACH_TYPED_ARRAY(FIND_ELEMENT)
+#undef FIND_ELEMENT
+    default:
+      break;
+  }
+  MOZ_CRASH("Unsupported TypedArray type");
+}
+
+bool js::intrinsic_TypedArrayNativeIndexOf(JSContext* cx, unsigned argc,
+                                           Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  MOZ_ASSERT(args.length() == 3);
+
+  auto* tarray = &args[0].toObject().as<TypedArrayObject>();
+  size_t start = size_t(args[2].toNumber());
+
+  size_t index = TypedArrayFindElement(tarray, args[1], start);
+  if (index == tarray->length()) {
+    args.rval().setInt32(-1);
+  } else {
+    args.rval().setNumber(double(index));
+  }
+  return true;
+}
+
+bool js::intrinsic_TypedArrayNativeIncludes(JSContext* cx, unsigned argc,
+                                            Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  MOZ_ASSERT(args.length() == 3);
+
+  auto* tarray = &args[0].toObject().as<TypedArrayObject>();
+  size_t start = size_t(args[2].toNumber());
+
+  // SameValueZero treats NaN as equal to itself.
+  if (args[1].isNumber() && mozilla::IsNaN(args[1].toNumber())) {
+    MOZ_ASSERT(start < tarray->length());
+    MOZ_ASSERT(!tarray->hasDetachedBuffer());
+
+    bool found;
+    switch (tarray->type()) {
+      case Scalar::Float32:
+        found = TypedArrayHasNaN<float>(tarray, start);
+        break;
+      case Scalar::Float64:
+        found = TypedArrayHasNaN<double>(tarray, start);
+        break;
+      default:
+        found = false;
+        break;
+    }
+    args.rval().setBoolean(found);
+    return true;
+  }
+
+  size_t index = TypedArrayFindElement(tarray, args[1], start);
+  args.rval().setBoolean(index != tarray->length());
+  return true;
+}
+
+template <typename T, typename Ops>
+static void TypedArrayReverseElements(TypedArrayObject* tarray) {
+  size_t length = tarray->length();
+  if (length < 2) {
+    return;
+  }
+
+  SharedMem<T*> data = Ops::extract(tarray).template cast<T*>();
+  if constexpr (std::is_same_v<Ops, UnsharedOps>) {
+    T* elements = data.unwrapUnshared();
+    std::reverse(elements, elements + length);
+  } else {
+    for (size_t lower = 0, upper = length - 1; lower < upper;
+         lower++, upper--) {
+      T lowerValue = Ops::load(data + lower);
+      T upperValue = Ops::load(data + upper);
+      Ops::store(data + lower, upperValue);
+      Ops::store(data + upper, lowerValue);
+    }
+  }
+}
+
+bool js::intrinsic_TypedArrayNativeReverse(JSContext* cx, unsigned argc,
+                                           Value* vp) {
+  CallArgs args = CallArgsFromVp(argc, vp);
+  MOZ_ASSERT(args.length() == 1);
+
+  auto* tarray = &args[0].toObject().as<TypedArrayObject>();
+  MOZ_ASSERT(!tarray->hasDetachedBuffer());
+
+  bool shared = tarray->isSharedMemory();
+  switch (tarray->type()) {
+#define REVERSE_ELEMENTS(T, N)                           \
+  case Scalar::N:                                        \
+    if (shared) {                                        \
+      TypedArrayReverseElements<T, SharedOps>(tarray);   \
+    } else {                                             \
+      TypedArrayReverseElements<T, UnsharedOps>(tarray); \
+    }                                                    \
+    break;
+    JS_FOR_EACH_TYPED_ARRAY(REVERSE_ELEMENTS)
+#undef REVERSE_ELEMENTS
+    default:
+      MOZ_CRASH("Unsupported TypedArray type");
+  }
+
+  args.rval().setUndefined();
+  return true;
+}
+
 /* static */ const JSFunctionSpec TypedArrayObject::protoFunctions[] = {
     JS_SELF_HOSTED_FN("subarray", "TypedArraySubarray", 2, 0),
     JS_FN("set", TypedArrayObject::set, 1, 0),
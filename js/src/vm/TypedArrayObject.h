@@ -180,6 +180,20 @@ class TypedArrayObject : public ArrayBufferViewObject {
 [[nodiscard]] bool TypedArray_bufferGetter(JSContext* cx, unsigned argc,
                                            Value* vp);
 
+/* Natives called from the self-hosted %TypedArray%.prototype methods. */
+
+[[nodiscard]] bool intrinsic_TypedArrayNativeFill(JSContext* cx, unsigned argc,
+                                                  Value* vp);
+
+[[nodiscard]] bool intrinsic_TypedArrayNativeIndexOf(JSContext* cx,
+                                                     unsigned argc, Value* vp);
+
+[[nodiscard]] bool intrinsic_TypedArrayNativeIncludes(JSContext* cx,
+                                                      unsigned argc, Value* vp);
+
+[[nodiscard]] bool intrinsic_TypedArrayNativeReverse(JSContext* cx,
+                                                     unsigned argc, Value* vp);
+
 extern TypedArrayObject* NewTypedArrayWithTemplateAndLength(
     JSContext* cx, HandleObject templateObj, int32_t len);
 